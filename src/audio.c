@@ -0,0 +1,247 @@
+#if !defined(AUDIO_DISABLED)
+    #include "raylib.h"     // Before game.h, which otherwise defines raylib's vector types itself
+    #include "ledger.h"
+    #include "memory.h"
+    #include <stdatomic.h>
+    #include <string.h> // For memset()
+#endif
+#include "audio.h"
+#include "synth.h"
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef enum GameSound {
+    SOUND_SHOOT = 0,
+    SOUND_INVADER_KILLED,
+    SOUND_EXPLOSION,            // Player death, invasion and UFO hit
+    SOUND_UFO_HIGH,             // Versus: the opponent sent an alien
+    SOUND_COUNT
+} GameSound;
+
+//------------------------------------------------------------------------------------
+// Global Variables Declaration
+//------------------------------------------------------------------------------------
+#if !defined(AUDIO_DISABLED)
+// Waveform, start and end pitch, duration, attack, release, vibrato rate and depth, volume
+static const SynthPatch soundPatches[SOUND_COUNT] = {
+    { SYNTH_NOISE, 6000.0f, 1500.0f, 0.35f, 0.005f, 0.30f, 0.0f, 0.0f, 0.30f },      // Hiss falling in pitch
+    { SYNTH_SQUARE, 1200.0f, 300.0f, 0.30f, 0.0f, 0.20f, 18.0f, 0.15f, 0.35f },      // Warbled downward chirp
+    { SYNTH_NOISE, 1500.0f, 300.0f, 0.80f, 0.0f, 0.75f, 0.0f, 0.0f, 0.50f },         // Low rumble
+    { SYNTH_SQUARE, 450.0f, 1100.0f, 0.16f, 0.0f, 0.04f, 30.0f, 0.10f, 0.30f }       // Rising squeal
+};
+static const float stepHz[4] = { 98.0f, 92.5f, 87.3f, 82.4f };     // The four march notes, descending
+static const SynthPatch dronePatch = { SYNTH_TRIANGLE, 375.0f, 375.0f, 0.0f, 0.02f, 0.0f, 8.0f, 0.20f, 0.35f };
+
+static Sound voices[SOUND_COUNT][AUDIO_VOICES_PER_SOUND] = { 0 };  // [s][0] owns the data, the rest are aliases
+static int nextVoice[SOUND_COUNT] = { 0 };                          // Voice after the last one started, the oldest
+static AudioStats stats = { 0 };
+
+// March and drone are synthesized in the stream callback (audio thread), so the note length can
+// follow the march tempo and the drone pitch the UFO. The main thread only writes these.
+static AudioStream synthStream = { 0 };
+static atomic_int marchTrigger = 0;     // Note index in the low 2 bits, a count of steps above
+static atomic_int marchNoteUs = 90000;  // Length of the next march note
+static atomic_bool droneOn = false;
+static atomic_int dronePitch = 1000;    // Pitch scale in thousandths
+static int marchSteps = 0;              // Main thread
+static int marchPlayed = 0;             // Audio thread
+static SynthVoice marchVoice = { 0 };   // Audio thread
+static SynthVoice droneVoice = { 0 };   // Audio thread
+
+// Single producer single consumer ring, positions only grow
+static GameEvent queue[AUDIO_QUEUE_SIZE];
+static atomic_size_t queueHead = 0;     // Written by the producer
+static atomic_size_t queueTail = 0;     // Written by UpdateGameAudio()
+static atomic_int droppedEvents = 0;
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition - Loading
+//----------------------------------------------------------------------------------
+#if !defined(AUDIO_DISABLED)
+static void MixSynthStream(void *buffer, unsigned int frames)
+{
+    int16_t *samples = (int16_t *)buffer;
+    memset(samples, 0, frames*sizeof(int16_t));
+
+    int march = atomic_load(&marchTrigger);
+    if (march != marchPlayed) {
+        SynthPatch note = { SYNTH_SQUARE, stepHz[march & 3], stepHz[march & 3], atomic_load(&marchNoteUs)/1e6f, 0.002f, 0.0f, 0.0f, 0.0f, 0.45f };
+        note.release = note.duration*0.6f;
+        StartSynthVoice(&marchVoice, note);
+        marchPlayed = march;
+    }
+
+    if (!atomic_load(&droneOn)) droneVoice.active = false;
+    else if (!droneVoice.active) StartSynthVoice(&droneVoice, dronePatch);
+
+    MixSynthVoice(&marchVoice, 1.0f, samples, (int)frames);
+    MixSynthVoice(&droneVoice, atomic_load(&dronePitch)/1000.0f, samples, (int)frames);
+}
+#endif
+
+void LoadGameAudio(void)
+{
+#if !defined(AUDIO_DISABLED)
+    InitAudioDevice();
+
+    // One-shots are rendered once, their voices play the PCM like a loaded file
+    for (int s = 0; s < SOUND_COUNT; s++) {
+        int frames = GetSynthFrames(&soundPatches[s]);
+        int16_t *samples = (int16_t *)GameMalloc(frames*sizeof(int16_t));
+        if (samples == NULL) continue;
+        RenderSynthPatch(&soundPatches[s], samples);
+
+        Wave wave = { (unsigned int)frames, SYNTH_SAMPLE_RATE, 16, 1, samples };
+        voices[s][0] = LoadSoundFromWaveTracked(wave); // Copies the samples
+        GameFree(samples);
+        for (int v = 1; v < AUDIO_VOICES_PER_SOUND; v++) voices[s][v] = LoadSoundAlias(voices[s][0]);
+    }
+
+    SetAudioStreamBufferSizeDefault(AUDIO_STREAM_FRAMES);
+    synthStream = LoadAudioStreamTracked(SYNTH_SAMPLE_RATE, 16, 1);
+    SetAudioStreamCallback(synthStream, MixSynthStream);
+    PlayAudioStream(synthStream);
+#endif
+}
+
+void UnloadGameAudio(void)
+{
+#if !defined(AUDIO_DISABLED)
+    for (int s = 0; s < SOUND_COUNT; s++) {
+        for (int v = 1; v < AUDIO_VOICES_PER_SOUND; v++) UnloadSoundAlias(voices[s][v]);
+        UnloadSoundTracked(voices[s][0]);
+    }
+    UnloadAudioStreamTracked(synthStream);
+
+    CloseAudioDevice();
+#endif
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition - Queue
+//----------------------------------------------------------------------------------
+void QueueGameEvent(GameEvent event)
+{
+#if !defined(AUDIO_DISABLED)
+    size_t head = atomic_load_explicit(&queueHead, memory_order_relaxed);
+    if (head - atomic_load_explicit(&queueTail, memory_order_acquire) == AUDIO_QUEUE_SIZE) {
+        atomic_fetch_add(&droppedEvents, 1);
+        return;
+    }
+
+    queue[head & (AUDIO_QUEUE_SIZE - 1)] = event;
+    atomic_store_explicit(&queueHead, head + 1, memory_order_release);
+#else
+    (void)event;
+#endif
+}
+
+void QueueGameEvents(const Game *game)
+{
+    for (int i = 0; i < game->eventCount; i++) QueueGameEvent(game->events[i]);
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition - Playback
+//----------------------------------------------------------------------------------
+#if !defined(AUDIO_DISABLED)
+// Idle voice of the sample, or the one started longest ago when all are busy
+static void PlayVoice(GameSound sound)
+{
+    int voice = nextVoice[sound];
+    for (int i = 0; i < AUDIO_VOICES_PER_SOUND; i++) {
+        int candidate = (nextVoice[sound] + i)%AUDIO_VOICES_PER_SOUND;
+        if (!IsSoundPlaying(voices[sound][candidate])) {
+            voice = candidate;
+            break;
+        }
+        if (i == AUDIO_VOICES_PER_SOUND - 1) stats.stolen++;
+    }
+
+    PlaySound(voices[sound][voice]);
+    nextVoice[sound] = (voice + 1)%AUDIO_VOICES_PER_SOUND;
+    stats.played++;
+}
+#endif
+
+void UpdateGameAudio(const Game *shown)
+{
+#if !defined(AUDIO_DISABLED)
+    unsigned int triggered = 0; // Bit per GameSound started this frame
+    int step = -1;              // Last march note of the frame
+    size_t head = atomic_load_explicit(&queueHead, memory_order_acquire);
+    size_t tail = atomic_load_explicit(&queueTail, memory_order_relaxed);
+
+    for (; tail != head; tail++) {
+        GameEvent event = queue[tail & (AUDIO_QUEUE_SIZE - 1)];
+        int sound = -1;
+
+        switch (event.type) {
+            case EVENT_PLAYER_SHOT: sound = SOUND_SHOOT; break;
+            case EVENT_ALIEN_KILLED: sound = SOUND_INVADER_KILLED; break;
+            case EVENT_PLAYER_KILLED: sound = SOUND_EXPLOSION; break;
+            case EVENT_INVASION: sound = SOUND_EXPLOSION; break;     // Player dies even if not shot
+            case EVENT_ALIEN_STEP:
+            {
+                if (step >= 0) stats.merged++;
+                step = event.param & 3;
+            } break;
+            case EVENT_ALIEN_REVIVED: sound = SOUND_UFO_HIGH; break;
+            case EVENT_UFO_SPAWN: atomic_store(&droneOn, true); break;
+            case EVENT_UFO_GONE: atomic_store(&droneOn, false); break;
+            case EVENT_UFO_KILLED:
+            {
+                atomic_store(&droneOn, false);
+                sound = SOUND_EXPLOSION;
+            } break;
+            default: break;
+        }
+
+        if (sound < 0) continue;
+        if (triggered & (1u << sound)) stats.merged++;
+        else {
+            triggered |= 1u << sound;
+            PlayVoice(sound);
+        }
+    }
+    atomic_store_explicit(&queueTail, tail, memory_order_release);
+
+    // Notes get shorter as the march speeds up, so they never run into each other
+    float noteLength = shown->alienMoveWaitTime*0.8f;
+    if (noteLength > 0.1f) noteLength = 0.1f;
+    if (noteLength < 0.03f) noteLength = 0.03f;
+    atomic_store(&marchNoteUs, (int)(noteLength*1e6f));
+    if (step >= 0) {
+        marchSteps++;
+        atomic_store(&marchTrigger, (marchSteps << 2) | step);
+        stats.played++;
+    }
+
+    // The drone rises as the UFO crosses the screen
+    const UFO *ufo = &shown->ufo;
+    float crossed = (ufo->speed > 0) ? ufo->position.x/SCREEN_WIDTH : 1.0f - (ufo->position.x + ufo->size.x)/SCREEN_WIDTH;
+    if (crossed < 0.0f) crossed = 0.0f;
+    if (crossed > 1.0f) crossed = 1.0f;
+    atomic_store(&dronePitch, (int)(850 + 300*crossed));
+
+    stats.voicesPlaying = 0;
+    for (int s = 0; s < SOUND_COUNT; s++) {
+        for (int v = 0; v < AUDIO_VOICES_PER_SOUND; v++) stats.voicesPlaying += IsSoundPlaying(voices[s][v]);
+    }
+#else
+    (void)shown;
+#endif
+}
+
+AudioStats GetAudioStats(void)
+{
+#if !defined(AUDIO_DISABLED)
+    AudioStats current = stats;
+    current.dropped = atomic_load(&droppedEvents);
+    return current;
+#else
+    return (AudioStats){ 0 };
+#endif
+}
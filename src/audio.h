@@ -0,0 +1,45 @@
+#ifndef AUDIO_H
+#define AUDIO_H
+
+// Sound of the game. The simulation never touches the audio device: its events go into a
+// lock-free queue (from whichever thread runs the ticks, one at a time) and the main thread
+// drains it once per frame into a fixed pool of voices, so audio can never stall a tick.
+//  - all sounds are synthesized (see synth.h), there are no sound files
+//  - every one-shot has AUDIO_VOICES_PER_SOUND voices (raylib sound aliases sharing its data),
+//    overlapping triggers get their own voice and the oldest one is reused when all are busy
+//  - a sound triggered several times within one frame plays once
+//  - the march notes and the UFO drone are generated in a stream callback: note length follows
+//    the march tempo and the drone pitch the UFO's way across, the UFO events start and stop it
+// Build with AUDIO=FALSE (defines AUDIO_DISABLED) for a build without any audio device use.
+
+#include "game.h"
+
+//----------------------------------------------------------------------------------
+// Defines
+//----------------------------------------------------------------------------------
+#define AUDIO_QUEUE_SIZE        256     // Power of two, events between two frames
+#define AUDIO_VOICES_PER_SOUND  4       // The sample plus three aliases
+#define AUDIO_STREAM_FRAMES     512     // Synth stream block, about 23 ms of latency for march and drone
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef struct AudioStats {
+    int voicesPlaying;          // Busy one-shot voices after the last update
+    int played;                 // Voices started since startup
+    int merged;                 // Same-frame duplicate triggers dropped
+    int stolen;                 // Voices cut off because all of their sample's were busy
+    int dropped;                // Events lost to a full queue
+} AudioStats;
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+void LoadGameAudio(void);                   // Opens the audio device and synthesizes the sounds
+void UnloadGameAudio(void);                 // Releases both
+void QueueGameEvent(GameEvent event);       // Producer side, never blocks; events without a sound are ignored
+void QueueGameEvents(const Game *game);     // Every event of the last update
+void UpdateGameAudio(const Game *shown);    // Main thread, once per frame: play what was queued, follow the board on screen
+AudioStats GetAudioStats(void);
+
+#endif // AUDIO_H
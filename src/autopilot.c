@@ -0,0 +1,187 @@
+#include "autopilot.h"
+#include <limits.h> // For INT_MAX
+
+//----------------------------------------------------------------------------------
+// Defines
+//----------------------------------------------------------------------------------
+#define AUTOPILOT_LOOKAHEAD     48      // Ticks of alien bullet fall simulated when dodging
+#define AUTOPILOT_REACH         40      // Candidate stops on each side, one player step apart
+#define AUTOPILOT_MARGIN        2.0f    // Clearance kept between the player and a bullet
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef struct Threat {
+    float left, right;          // Horizontal extent of the bullet
+    int first, last;            // Ticks from now it spends in the player row, before a shield stops it
+} Threat;
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition - Prediction
+//----------------------------------------------------------------------------------
+static bool IsBulletAbsorbed(const Game *game, Rectangle bullet)
+{
+    for (int s = 0; s < NUM_SHIELDS; s++) {
+        const Rectangle bounds = game->shields[s].bounds;
+        if (!game->shields[s].active || (bullet.x >= bounds.x + bounds.width) || (bullet.x + bullet.width <= bounds.x) ||
+            (bullet.y >= bounds.y + bounds.height) || (bullet.y + bullet.height <= bounds.y)) continue;
+        if (IsShieldSolid(game, s, (Vector2){ bullet.x + bullet.width*0.5f, bullet.y + bullet.height })) return true;
+    }
+    return false;
+}
+
+// Same order as the update: a bullet moves, is tested against the player, then against the shields
+static int FindThreats(const Game *game, Threat *threats)
+{
+    const Player *player = &game->player;
+    int count = 0;
+
+    for (int i = 0; i < MAX_ALIEN_BULLETS; i++) {
+        const Bullet *bullet = &game->alienBullets[i];
+        if (!bullet->active) continue;
+
+        Threat threat = { bullet->position.x, bullet->position.x + bullet->size.x, -1, -1 };
+        for (int k = 0; k <= AUTOPILOT_LOOKAHEAD; k++) {
+            Rectangle rect = { bullet->position.x, bullet->position.y + bullet->speed*k, bullet->size.x, bullet->size.y };
+            if (rect.y > SCREEN_HEIGHT) break;
+            if ((k > 0) && (rect.y < player->position.y + player->size.y) && (rect.y + rect.height > player->position.y)) {
+                if (threat.first < 0) threat.first = k;
+                threat.last = k;
+            }
+            if (IsBulletAbsorbed(game, rect)) break;
+        }
+        if (threat.first >= 0) threats[count++] = threat;
+    }
+
+    return count;
+}
+
+// First tick the player gets hit walking straight to stop and waiting there, INT_MAX when never
+static int GetHitTick(const Game *game, const Threat *threats, int count, float stop)
+{
+    const Player *player = &game->player;
+    float start = player->position.x;
+    int hit = INT_MAX;
+
+    for (int i = 0; i < count; i++) {
+        for (int k = threats[i].first; (k <= threats[i].last) && (k < hit); k++) {
+            float x = (stop > start) ? start + PLAYER_SPEED*k : start - PLAYER_SPEED*k;
+            if (((stop > start) && (x > stop)) || ((stop <= start) && (x < stop))) x = stop;
+
+            if ((x - AUTOPILOT_MARGIN < threats[i].right) && (x + player->size.x + AUTOPILOT_MARGIN > threats[i].left)) hit = k;
+        }
+    }
+
+    return hit;
+}
+
+// Horizontal distance the formation marches in the given ticks, turning at the screen edges
+static float PredictFormationShift(const Game *game, int ticks)
+{
+    int first = GetGameTimerTicks(game, TIMER_ALIEN_STEP);
+    if ((first == 0) || (ticks < first)) return 0.0f;
+
+    float left = SCREEN_WIDTH, right = 0;
+    for (int i = 0; i < NUM_ALIENS; i++) {
+        const Alien *alien = &game->aliens[i];
+        if (!alien->active) continue;
+        if (alien->position.x < left) left = alien->position.x;
+        if (alien->position.x + alien->size.x > right) right = alien->position.x + alien->size.x;
+    }
+
+    int steps = (ticks - first)/GameSecondsToTicks(game->alienMoveWaitTime) + 1;
+    int direction = game->alienDirection;
+    float shift = 0.0f;
+    for (int i = 0; i < steps; i++) {
+        if (((direction > 0) && (right + shift + ALIEN_HORIZONTAL_MOVE > SCREEN_WIDTH)) ||
+            ((direction < 0) && (left + shift - ALIEN_HORIZONTAL_MOVE < 0))) direction = -direction; // Drops a row instead
+        else shift += ALIEN_HORIZONTAL_MOVE*direction;
+    }
+
+    return shift;
+}
+
+// Ticks a shot fired now needs to reach a target whose bottom edge is at y
+static int GetShotFlight(const Game *game, float bottom)
+{
+    float shotY = game->player.position.y - game->player.shotSize.y;
+    return (shotY > bottom) ? (int)((shotY - bottom)/PLAYER_BULLET_SPEED) + 1 : 1;
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+GameInput GetAutopilotInput(const Game *game)
+{
+    GameInput input = { 0 };
+    const Player *player = &game->player;
+    if (game->gameOver || player->exploding) return input;
+
+    // Aim: the UFO while it flies, otherwise the lowest alien, nearest first among equals
+    float aim = player->position.x;
+    const UFO *ufo = &game->ufo;
+    float ufoX = ufo->position.x + ufo->speed*GAME_TICK_TIME*GetShotFlight(game, ufo->position.y + ufo->size.y);
+    bool ufoTarget = ufo->active && !ufo->exploding && (ufoX > 0) && (ufoX + ufo->size.x < SCREEN_WIDTH);
+
+    if (ufoTarget) aim = ufoX + ufo->size.x/2 - player->size.x/2;
+    else {
+        const Alien *target = NULL;
+        float targetX = 0.0f, targetDistance = 0.0f;
+        for (int i = 0; i < NUM_ALIENS; i++) {
+            const Alien *alien = &game->aliens[i];
+            if (!alien->active || ((target != NULL) && (alien->position.y < target->position.y))) continue;
+
+            float x = alien->position.x + PredictFormationShift(game, GetShotFlight(game, alien->position.y + alien->size.y));
+            float distance = x + alien->size.x/2 - (player->position.x + player->size.x/2);
+            if (distance < 0) distance = -distance;
+            if ((target == NULL) || (alien->position.y > target->position.y) || (distance < targetDistance)) {
+                target = alien;
+                targetX = x;
+                targetDistance = distance;
+            }
+        }
+        if (target != NULL) aim = targetX + target->size.x/2 - player->size.x/2;
+    }
+
+    // Move: among the reachable stops, the one hit last (never, ideally), then the one nearest the aim
+    Threat threats[MAX_ALIEN_BULLETS];
+    int threatCount = FindThreats(game, threats);
+    float best = player->position.x, bestDistance = 0.0f;
+    int bestHit = -1;
+
+    for (int j = -AUTOPILOT_REACH; j <= AUTOPILOT_REACH; j++) {
+        float stop = player->position.x + j*PLAYER_SPEED;
+        if (stop < 0) stop = 0;
+        if (stop > SCREEN_WIDTH - player->size.x) stop = SCREEN_WIDTH - player->size.x;
+
+        int hit = GetHitTick(game, threats, threatCount, stop);
+        float distance = (stop > aim) ? stop - aim : aim - stop;
+        if ((hit > bestHit) || ((hit == bestHit) && (distance < bestDistance))) {
+            best = stop;
+            bestHit = hit;
+            bestDistance = distance;
+        }
+    }
+
+    input.left = (best < player->position.x);
+    input.right = (best > player->position.x);
+
+    // Fire when the shot, spawned after this tick's move, meets something on its way up
+    if (!player->shotActive) {
+        float x = player->position.x + (input.right ? PLAYER_SPEED : 0.0f) - (input.left ? PLAYER_SPEED : 0.0f);
+        if (x < 0) x = 0;
+        if (x > SCREEN_WIDTH - player->size.x) x = SCREEN_WIDTH - player->size.x;
+        float shotLeft = x + player->size.x/2 - player->shotSize.x/2, shotRight = shotLeft + player->shotSize.x;
+
+        if (ufoTarget && (shotRight > ufoX) && (shotLeft < ufoX + ufo->size.x)) input.fire = true;
+        for (int i = 0; (i < NUM_ALIENS) && !input.fire; i++) {
+            const Alien *alien = &game->aliens[i];
+            if (!alien->active) continue;
+
+            float alienX = alien->position.x + PredictFormationShift(game, GetShotFlight(game, alien->position.y + alien->size.y));
+            if ((shotRight > alienX) && (shotLeft < alienX + alien->size.x)) input.fire = true;
+        }
+    }
+
+    return input;
+}
@@ -0,0 +1,17 @@
+#ifndef AUTOPILOT_H
+#define AUTOPILOT_H
+
+// Scripted player for soak tests and profiling: reads nothing but the game state, so the same
+// state always gives the same input and autopilot runs replay and verify like human ones.
+// It dodges alien bullets by simulating their fall against a few dozen candidate stops (shields
+// that would absorb a bullet are taken into account), steers under the lowest alien, leading
+// the formation's march, and goes for the UFO while it flies.
+
+#include "game.h"
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+GameInput GetAutopilotInput(const Game *game);  // Input for the next UpdateGameState()
+
+#endif // AUTOPILOT_H
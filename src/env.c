@@ -0,0 +1,221 @@
+#include "env.h"
+#include "raster.h"
+#include "memory.h"
+#include <string.h> // For memset(), memcpy()
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+struct Env {
+    int count;
+    uint64_t seed;
+    EnvBuffers buffers;
+    Game *games;                // count games, contiguous
+    uint32_t *episodes;         // Restarts per game, picks the next seed
+    unsigned char *shieldLayers; // Per game frame holding only the shields, allocated with the frames buffer
+};
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition - Observations
+//----------------------------------------------------------------------------------
+static void WriteObservation(const Game *game, float *obs)
+{
+    const Player *player = &game->player;
+
+    obs[ENV_PLAYER_X] = player->position.x/SCREEN_WIDTH;
+    obs[ENV_LIVES] = (float)player->lives;
+    obs[ENV_PLAYER_EXPLODING] = player->exploding ? 1.0f : 0.0f;
+    obs[ENV_SHOT_ACTIVE] = player->shotActive ? 1.0f : 0.0f;
+    obs[ENV_SHOT_X] = player->shotActive ? player->shotPosition.x/SCREEN_WIDTH : 0.0f;
+    obs[ENV_SHOT_Y] = player->shotActive ? player->shotPosition.y/SCREEN_HEIGHT : 0.0f;
+    obs[ENV_ALIENS_ALIVE] = (float)game->aliensAlive/NUM_ALIENS;
+    obs[ENV_ALIEN_DIRECTION] = (float)game->alienDirection;
+    obs[ENV_ALIEN_STEP_TIME] = game->alienMoveWaitTime;
+    obs[ENV_UFO_ACTIVE] = (game->ufo.active && !game->ufo.exploding) ? 1.0f : 0.0f;
+    obs[ENV_UFO_X] = game->ufo.active ? game->ufo.position.x/SCREEN_WIDTH : 0.0f;
+    obs[ENV_WAVE] = (float)game->currentWave;
+
+    float *aliens = obs + ENV_OBS_GLOBALS;
+    for (int i = 0; i < NUM_ALIENS; i++) {
+        const Alien *alien = &game->aliens[i];
+        aliens[i*3] = alien->active ? 1.0f : 0.0f;
+        aliens[i*3 + 1] = alien->active ? alien->position.x/SCREEN_WIDTH : 0.0f;
+        aliens[i*3 + 2] = alien->active ? alien->position.y/SCREEN_HEIGHT : 0.0f;
+    }
+
+    float *bullets = aliens + ENV_OBS_ALIENS;
+    for (int i = 0; i < MAX_ALIEN_BULLETS; i++) {
+        const Bullet *bullet = &game->alienBullets[i];
+        bullets[i*3] = bullet->active ? 1.0f : 0.0f;
+        bullets[i*3 + 1] = bullet->active ? bullet->position.x/SCREEN_WIDTH : 0.0f;
+        bullets[i*3 + 2] = bullet->active ? bullet->position.y/SCREEN_HEIGHT : 0.0f;
+    }
+}
+
+// Mark every cell the rectangle touches, clipped to the frame
+static void FillCells(unsigned char *frame, float x, float y, float width, float height, unsigned char value)
+{
+    int x0 = (int)(x/ENV_FRAME_SCALE), y0 = (int)(y/ENV_FRAME_SCALE);
+    int x1 = (int)((x + width - 1)/ENV_FRAME_SCALE), y1 = (int)((y + height - 1)/ENV_FRAME_SCALE);
+    if (x0 < 0) x0 = 0;
+    if (y0 < 0) y0 = 0;
+    if (x1 > ENV_FRAME_WIDTH - 1) x1 = ENV_FRAME_WIDTH - 1;
+    if (y1 > ENV_FRAME_HEIGHT - 1) y1 = ENV_FRAME_HEIGHT - 1;
+
+    for (int cy = y0; cy <= y1; cy++) {
+        for (int cx = x0; cx <= x1; cx++) frame[cy*ENV_FRAME_WIDTH + cx] = value;
+    }
+}
+
+// Shields change only when hit, their cells are rasterized again just then
+static void UpdateShieldLayer(Game *game, unsigned char *layer)
+{
+    bool dirty = false;
+    for (int s = 0; s < NUM_SHIELDS; s++) {
+        if (game->shieldDirty[s].x0 <= game->shieldDirty[s].x1) dirty = true;
+        ClearShieldDirty(game, s);
+    }
+    if (!dirty) return;
+
+    memset(layer, 0, ENV_FRAME_SIZE);
+    for (int s = 0; s < NUM_SHIELDS; s++) {
+        const Shield *shield = &game->shields[s];
+        if (!shield->active) continue;
+
+        // Texel centers
+        float texelWidth = shield->bounds.width/SHIELD_TEX_WIDTH;
+        float texelHeight = shield->bounds.height/SHIELD_TEX_HEIGHT;
+        for (int y = 0; y < SHIELD_TEX_HEIGHT; y++) {
+            int cy = (int)((shield->bounds.y + (y + 0.5f)*texelHeight)/ENV_FRAME_SCALE);
+            for (int x = 0; x < SHIELD_TEX_WIDTH; x++) {
+                if (shield->alpha[y][x] <= 127) continue;
+                int cx = (int)((shield->bounds.x + (x + 0.5f)*texelWidth)/ENV_FRAME_SCALE);
+                if ((cx >= 0) && (cx < ENV_FRAME_WIDTH) && (cy >= 0) && (cy < ENV_FRAME_HEIGHT)) layer[cy*ENV_FRAME_WIDTH + cx] = ENV_CELL_SHIELD;
+            }
+        }
+    }
+}
+
+static void WriteFrame(const Game *game, const unsigned char *shieldLayer, unsigned char *frame)
+{
+    memcpy(frame, shieldLayer, ENV_FRAME_SIZE);
+
+    for (int i = 0; i < NUM_ALIENS; i++) {
+        const Alien *alien = &game->aliens[i];
+        if (alien->active) FillCells(frame, alien->position.x, alien->position.y, alien->size.x, alien->size.y, ENV_CELL_ALIEN);
+    }
+
+    const UFO *ufo = &game->ufo;
+    if (ufo->active && !ufo->exploding) FillCells(frame, ufo->position.x, ufo->position.y, ufo->size.x, ufo->size.y, ENV_CELL_UFO);
+
+    const Player *player = &game->player;
+    if (player->lives > 0) FillCells(frame, player->position.x, player->position.y, player->size.x, player->size.y, ENV_CELL_PLAYER);
+    if (player->shotActive) FillCells(frame, player->shotPosition.x, player->shotPosition.y, player->shotSize.x, player->shotSize.y, ENV_CELL_PLAYER_SHOT);
+
+    for (int i = 0; i < MAX_ALIEN_BULLETS; i++) {
+        const Bullet *bullet = &game->alienBullets[i];
+        if (bullet->active) FillCells(frame, bullet->position.x, bullet->position.y, bullet->size.x, bullet->size.y, ENV_CELL_BULLET);
+    }
+}
+
+static void Observe(Env *env, int index)
+{
+    if (env->buffers.observations != NULL) WriteObservation(&env->games[index], env->buffers.observations + (size_t)index*ENV_OBS_SIZE);
+    if (env->buffers.frames != NULL) {
+        unsigned char *layer = env->shieldLayers + (size_t)index*ENV_FRAME_SIZE;
+        UpdateShieldLayer(&env->games[index], layer);
+        WriteFrame(&env->games[index], layer, env->buffers.frames + (size_t)index*ENV_FRAME_SIZE);
+    }
+    if (env->buffers.pixels != NULL) {
+        size_t size = (size_t)env->buffers.pixelWidth*env->buffers.pixelHeight*4;
+        Framebuffer target = { env->buffers.pixelWidth, env->buffers.pixelHeight, env->buffers.pixels + index*size };
+        RasterGame(&env->games[index], env->games[index].score, &target);
+    }
+}
+
+static void StartEpisode(Env *env, int index)
+{
+    // Game i plays seeds seed + i, seed + i + n, seed + i + 2n... so no two games ever share one
+    uint64_t seed = env->seed + index + (uint64_t)env->episodes[index]*env->count;
+    InitGameState(&env->games[index], seed);
+    env->episodes[index]++;
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+Env *env_create(int n)
+{
+    if (n <= 0) return NULL;
+
+    Env *env = (Env *)GameCalloc(1, sizeof(Env));
+    if (env == NULL) return NULL;
+    env->count = n;
+    env->games = (Game *)GameCalloc(n, sizeof(Game));
+    env->episodes = (uint32_t *)GameCalloc(n, sizeof(uint32_t));
+    if ((env->games == NULL) || (env->episodes == NULL)) {
+        env_destroy(env);
+        return NULL;
+    }
+
+    env_reset(env, 0);
+    return env;
+}
+
+void env_destroy(Env *env)
+{
+    if (env == NULL) return;
+    GameFree(env->games);
+    GameFree(env->episodes);
+    GameFree(env->shieldLayers);
+    GameFree(env);
+}
+
+void env_bind(Env *env, EnvBuffers buffers)
+{
+    if ((buffers.frames != NULL) && (env->shieldLayers == NULL)) {
+        env->shieldLayers = (unsigned char *)GameCalloc(env->count, ENV_FRAME_SIZE);
+        if (env->shieldLayers == NULL) buffers.frames = NULL; // Observations keep working without frames
+        for (int i = 0; i < env->count; i++) InvalidateShields(&env->games[i]);
+    }
+    env->buffers = buffers;
+    for (int i = 0; i < env->count; i++) Observe(env, i);
+}
+
+void env_reset(Env *env, uint64_t seed)
+{
+    env->seed = seed;
+    for (int i = 0; i < env->count; i++) {
+        env->episodes[i] = 0;
+        StartEpisode(env, i);
+        if (env->buffers.rewards != NULL) env->buffers.rewards[i] = 0.0f;
+        if (env->buffers.dones != NULL) env->buffers.dones[i] = 0;
+        Observe(env, i);
+    }
+}
+
+void env_step(Env *env, const unsigned char *actions)
+{
+    for (int i = 0; i < env->count; i++) {
+        Game *game = &env->games[i];
+        int score = game->score;
+        int lives = game->player.lives;
+
+        UpdateGameState(game, UnpackGameInput(actions[i]));
+        game->eventCount = 0; // Nobody plays the sounds here
+
+        float reward = (float)(game->score - score);
+        if (game->player.lives < lives) reward -= ENV_LIFE_PENALTY*(lives - game->player.lives);
+        bool done = game->gameOver;
+        if (done) StartEpisode(env, i);
+
+        if (env->buffers.rewards != NULL) env->buffers.rewards[i] = reward;
+        if (env->buffers.dones != NULL) env->buffers.dones[i] = done ? 1 : 0;
+        Observe(env, i);
+    }
+}
+
+int env_count(const Env *env)
+{
+    return env->count;
+}
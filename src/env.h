@@ -0,0 +1,78 @@
+#ifndef ENV_H
+#define ENV_H
+
+// Vectorized training environment: N headless games stepped in lockstep through the same
+// UpdateGameState() the game runs, no window, audio or allocation per step. Observations,
+// rewards and done flags are written straight into buffers owned by the caller (e.g. numpy
+// arrays passed through ctypes), one contiguous row per game.
+
+#include "game.h"
+
+//----------------------------------------------------------------------------------
+// Defines
+//----------------------------------------------------------------------------------
+// Observation row layout, all floats, positions normalized to [0, 1] by the screen size
+#define ENV_OBS_GLOBALS         12                  // See EnvGlobalFeature
+#define ENV_OBS_ALIENS          (NUM_ALIENS*3)      // alive, x, y per grid slot (zeros when dead)
+#define ENV_OBS_BULLETS         (MAX_ALIEN_BULLETS*3) // active, x, y per alien bullet slot
+#define ENV_OBS_SIZE            (ENV_OBS_GLOBALS + ENV_OBS_ALIENS + ENV_OBS_BULLETS)
+
+// Optional occupancy frame, one byte per cell of the screen downsampled by ENV_FRAME_SCALE
+#define ENV_FRAME_SCALE         10
+#define ENV_FRAME_WIDTH         (SCREEN_WIDTH/ENV_FRAME_SCALE)
+#define ENV_FRAME_HEIGHT        (SCREEN_HEIGHT/ENV_FRAME_SCALE)
+#define ENV_FRAME_SIZE          (ENV_FRAME_WIDTH*ENV_FRAME_HEIGHT)
+
+#define ENV_CELL_SHIELD         64
+#define ENV_CELL_ALIEN          128
+#define ENV_CELL_UFO            160
+#define ENV_CELL_PLAYER         192
+#define ENV_CELL_PLAYER_SHOT    224
+#define ENV_CELL_BULLET         255
+
+#define ENV_LIFE_PENALTY        100.0f  // Subtracted from the reward when the player is hit
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef enum EnvGlobalFeature {
+    ENV_PLAYER_X = 0,
+    ENV_LIVES,                  // Remaining lives (raw count)
+    ENV_PLAYER_EXPLODING,
+    ENV_SHOT_ACTIVE,
+    ENV_SHOT_X,
+    ENV_SHOT_Y,
+    ENV_ALIENS_ALIVE,           // Fraction of the formation alive
+    ENV_ALIEN_DIRECTION,        // -1 left, 1 right
+    ENV_ALIEN_STEP_TIME,        // Seconds between formation steps
+    ENV_UFO_ACTIVE,
+    ENV_UFO_X,
+    ENV_WAVE                    // Current wave (raw number)
+} EnvGlobalFeature;
+
+typedef struct EnvBuffers {
+    float *observations;        // n*ENV_OBS_SIZE
+    unsigned char *frames;      // n*ENV_FRAME_SIZE, NULL to skip rasterizing
+    unsigned char *pixels;      // n*pixelWidth*pixelHeight*4 RGBA8 renders (see raster.h), NULL to skip
+    int pixelWidth;
+    int pixelHeight;
+    float *rewards;             // n, score gained minus ENV_LIFE_PENALTY per life lost
+    unsigned char *dones;       // n, 1 when the game ended on this step (it restarts right away)
+} EnvBuffers;
+
+typedef struct Env Env;
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+// Names are lowercase so they bind the same from Python (ctypes/cffi) as from C
+Env *env_create(int n);
+void env_destroy(Env *env);
+void env_bind(Env *env, EnvBuffers buffers);    // Buffers stay owned by the caller
+void env_reset(Env *env, uint64_t seed);        // Game i gets seed + i, writes observations
+// actions[i] is a PackGameInput() byte (1 left, 2 right, 4 fire). Finished games restart with
+// the next seed of their sequence; observations then already show the new game.
+void env_step(Env *env, const unsigned char *actions);
+int env_count(const Env *env);
+
+#endif // ENV_H
@@ -0,0 +1,221 @@
+#include "raylib.h"
+#include "rlgl.h"
+#include "formation.h"
+#include "ledger.h"
+#include "memory.h"
+#include <string.h> // For memcmp(), memcpy()
+
+//----------------------------------------------------------------------------------
+// Defines
+//----------------------------------------------------------------------------------
+#if defined(PLATFORM_WEB)
+    #define FORMATION_GLSL_HEADER   "#version 300 es\nprecision mediump float;\n"
+#else
+    #define FORMATION_GLSL_HEADER   "#version 330\n"
+#endif
+
+#define ATLAS_FRAMES            2       // Columns
+#define ATLAS_TYPES             3       // Rows, in AlienType order
+
+//------------------------------------------------------------------------------------
+// Global Variables Declaration
+//------------------------------------------------------------------------------------
+static bool ready = false;
+static int instances = 0;
+static Texture2D atlas = { 0 };
+static unsigned int shaderId = 0;
+static unsigned int vao = 0;
+static unsigned int quadBuffer = 0;     // Unit quad, two triangles
+static unsigned int cellBuffer = 0;     // Per instance: grid position, world pixels
+static unsigned int typeBuffer = 0;     // Per instance: atlas row
+static unsigned int aliveBuffer = 0;    // Per instance: 1 drawn, 0 collapsed to nothing
+static float *alive = NULL;             // What aliveBuffer holds
+static int viewLoc, projectionLoc, offsetLoc, sizeLoc, frameLoc, textureLoc, tintLoc;
+
+static const char *vertexShaderCode = FORMATION_GLSL_HEADER
+    "in vec3 vertexPosition;\n"
+    "in vec2 instanceCell;\n"
+    "in float instanceType;\n"
+    "in float instanceAlive;\n"
+    "uniform mat4 matView;\n"
+    "uniform mat4 matProjection;\n"
+    "uniform vec2 formationOffset;\n"
+    "uniform vec2 alienSize;\n"
+    "uniform float frame;\n"
+    "out vec2 fragTexCoord;\n"
+    "void main()\n"
+    "{\n"
+    "    fragTexCoord = vec2((frame + vertexPosition.x)/2.0, (instanceType + vertexPosition.y)/3.0);\n"
+    "    vec2 world = instanceCell + formationOffset + vertexPosition.xy*alienSize*instanceAlive;\n"
+    "    gl_Position = matProjection*matView*vec4(world, 0.0, 1.0);\n"
+    "}\n";
+
+static const char *fragmentShaderCode = FORMATION_GLSL_HEADER
+    "in vec2 fragTexCoord;\n"
+    "uniform sampler2D texture0;\n"
+    "uniform vec4 colDiffuse;\n"
+    "out vec4 finalColor;\n"
+    "void main()\n"
+    "{\n"
+    "    finalColor = texture(texture0, fragTexCoord)*colDiffuse;\n"
+    "}\n";
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+static bool IsInstancingSupported(void)
+{
+#if defined(PLATFORM_WEB)
+    return (rlGetVersion() == RL_OPENGL_ES_30);
+#else
+    return (rlGetVersion() == RL_OPENGL_33) || (rlGetVersion() == RL_OPENGL_43);
+#endif
+}
+
+// Same files as the sprites drawn one by one, inv<type><frame>.png
+static Texture2D LoadAlienAtlas(void)
+{
+    Image image = GenImageColor(ATLAS_FRAMES*SPRITE_ALIEN_WIDTH, ATLAS_TYPES*SPRITE_ALIEN_HEIGHT, BLANK);
+    for (int type = 0; type < ATLAS_TYPES; type++) {
+        for (int frame = 0; frame < ATLAS_FRAMES; frame++) {
+            Image sprite = LoadImage(TextFormat("resources/inv%d%d.png", type + 1, frame + 1));
+            ImageDraw(&image, sprite, (Rectangle){ 0, 0, (float)sprite.width, (float)sprite.height },
+                      (Rectangle){ (float)frame*SPRITE_ALIEN_WIDTH, (float)type*SPRITE_ALIEN_HEIGHT, SPRITE_ALIEN_WIDTH, SPRITE_ALIEN_HEIGHT }, WHITE);
+            UnloadImage(sprite);
+        }
+    }
+
+    Texture2D texture = LoadTextureFromImageTracked(image);
+    UnloadImage(image);
+    return texture;
+}
+
+bool LoadFormationRenderer(const Game *layout)
+{
+    if (ready || !IsInstancingSupported()) return false;
+
+    shaderId = rlLoadShaderCode(vertexShaderCode, fragmentShaderCode);
+    if (shaderId == 0) return false;
+    int positionAttrib = rlGetLocationAttrib(shaderId, "vertexPosition");
+    int cellAttrib = rlGetLocationAttrib(shaderId, "instanceCell");
+    int typeAttrib = rlGetLocationAttrib(shaderId, "instanceType");
+    int aliveAttrib = rlGetLocationAttrib(shaderId, "instanceAlive");
+    viewLoc = rlGetLocationUniform(shaderId, "matView");
+    projectionLoc = rlGetLocationUniform(shaderId, "matProjection");
+    offsetLoc = rlGetLocationUniform(shaderId, "formationOffset");
+    sizeLoc = rlGetLocationUniform(shaderId, "alienSize");
+    frameLoc = rlGetLocationUniform(shaderId, "frame");
+    textureLoc = rlGetLocationUniform(shaderId, "texture0");
+    tintLoc = rlGetLocationUniform(shaderId, "colDiffuse");
+
+    instances = NUM_ALIENS;
+    float *cells = (float *)GameMalloc(instances*2*sizeof(float));
+    float *types = (float *)GameMalloc(instances*sizeof(float));
+    alive = (float *)GameMalloc(instances*sizeof(float));
+    if ((cells == NULL) || (types == NULL) || (alive == NULL)) {
+        GameFree(cells); GameFree(types); GameFree(alive);
+        alive = NULL;
+        rlUnloadShaderProgram(shaderId);
+        return false;
+    }
+    for (int i = 0; i < instances; i++) {
+        cells[2*i] = layout->aliens[i].basePosition.x;
+        cells[2*i + 1] = layout->aliens[i].basePosition.y;
+        types[i] = (float)layout->aliens[i].type;
+        alive[i] = 0.0f;
+    }
+
+    static const float quad[] = { 0, 0, 0,  0, 1, 0,  1, 1, 0,  0, 0, 0,  1, 1, 0,  1, 0, 0 };
+    vao = rlLoadVertexArray();
+    rlEnableVertexArray(vao);
+        quadBuffer = rlLoadVertexBuffer(quad, sizeof(quad), false);
+        rlSetVertexAttribute(positionAttrib, 3, RL_FLOAT, false, 0, 0);
+        rlEnableVertexAttribute(positionAttrib);
+
+        cellBuffer = rlLoadVertexBuffer(cells, instances*2*sizeof(float), false);
+        rlSetVertexAttribute(cellAttrib, 2, RL_FLOAT, false, 0, 0);
+        rlSetVertexAttributeDivisor(cellAttrib, 1);
+        rlEnableVertexAttribute(cellAttrib);
+
+        typeBuffer = rlLoadVertexBuffer(types, instances*sizeof(float), false);
+        rlSetVertexAttribute(typeAttrib, 1, RL_FLOAT, false, 0, 0);
+        rlSetVertexAttributeDivisor(typeAttrib, 1);
+        rlEnableVertexAttribute(typeAttrib);
+
+        aliveBuffer = rlLoadVertexBuffer(alive, instances*sizeof(float), true);
+        rlSetVertexAttribute(aliveAttrib, 1, RL_FLOAT, false, 0, 0);
+        rlSetVertexAttributeDivisor(aliveAttrib, 1);
+        rlEnableVertexAttribute(aliveAttrib);
+    rlDisableVertexArray();
+    GameFree(cells);
+    GameFree(types);
+
+    atlas = LoadAlienAtlas();
+    ready = true;
+    TraceLog(LOG_INFO, "GAME: Alien formation drawn instanced, %d instances", instances);
+    return true;
+}
+
+void UnloadFormationRenderer(void)
+{
+    if (!ready) return;
+
+    rlUnloadVertexArray(vao);
+    rlUnloadVertexBuffer(quadBuffer);
+    rlUnloadVertexBuffer(cellBuffer);
+    rlUnloadVertexBuffer(typeBuffer);
+    rlUnloadVertexBuffer(aliveBuffer);
+    rlUnloadShaderProgram(shaderId);
+    UnloadTextureTracked(atlas);
+    GameFree(alive);
+    alive = NULL;
+    ready = false;
+}
+
+bool IsFormationRendererReady(void)
+{
+    return ready;
+}
+
+void DrawFormation(const Game *board)
+{
+    // Every alien moves and animates in step (a revived one takes over a living one's offset and
+    // frame), so any alive alien gives the formation's
+    const Alien *reference = NULL;
+    bool changed = false;
+    for (int i = 0; i < instances; i++) {
+        float value = board->aliens[i].active ? 1.0f : 0.0f;
+        if ((reference == NULL) && board->aliens[i].active) reference = &board->aliens[i];
+        if (alive[i] != value) {
+            alive[i] = value;
+            changed = true;
+        }
+    }
+    if (reference == NULL) return;
+
+    Vector2 offset = { reference->position.x - reference->basePosition.x, reference->position.y - reference->basePosition.y };
+    float frame = reference->currentFrame ? 1.0f : 0.0f;
+    float tint[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+    int unit = 0;
+
+    rlDrawRenderBatchActive(); // Sprites queued so far go first, the draw order stays the same
+    if (changed) rlUpdateVertexBuffer(aliveBuffer, alive, instances*sizeof(float), 0);
+
+    rlEnableShader(shaderId);
+        rlSetUniformMatrix(viewLoc, rlGetMatrixModelview());
+        rlSetUniformMatrix(projectionLoc, rlGetMatrixProjection());
+        rlSetUniform(offsetLoc, &offset, RL_SHADER_UNIFORM_VEC2, 1);
+        rlSetUniform(sizeLoc, &reference->size, RL_SHADER_UNIFORM_VEC2, 1);
+        rlSetUniform(frameLoc, &frame, RL_SHADER_UNIFORM_FLOAT, 1);
+        rlSetUniform(tintLoc, tint, RL_SHADER_UNIFORM_VEC4, 1);
+        rlSetUniform(textureLoc, &unit, RL_SHADER_UNIFORM_INT, 1);
+        rlActiveTextureSlot(0);
+        rlEnableTexture(atlas.id);
+
+        rlEnableVertexArray(vao);
+        rlDrawVertexArrayInstanced(0, 6, instances);
+        rlDisableVertexArray();
+
+        rlDisableTexture();
+    rlDisableShader();
+}
@@ -0,0 +1,23 @@
+#ifndef FORMATION_H
+#define FORMATION_H
+
+// Instanced drawing of the alien formation: one draw call for all aliens of a board. The grid
+// (cell position and type of every alien) goes to the GPU once as per-instance data; a frame only
+// sets the formation offset and animation frame as uniforms and uploads the alive mask when it
+// changed since the last draw. The six alien sprites are packed into one atlas (frame across,
+// type down) so the whole formation samples a single texture.
+// Needs instancing, i.e. OpenGL 3.3 or WebGL 2; elsewhere LoadFormationRenderer() fails and the
+// aliens are drawn one by one as before.
+
+#include "raylib.h"
+#include "game.h"
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+bool LoadFormationRenderer(const Game *layout);     // Instances from the grid of this game (every game has the same)
+void UnloadFormationRenderer(void);
+bool IsFormationRendererReady(void);
+void DrawFormation(const Game *board);              // World coordinates, under whatever camera is active
+
+#endif // FORMATION_H
@@ -0,0 +1,280 @@
+// Coverage-guided fuzzing of the simulation core: each input is a starting state plus one byte per
+// tick, and CheckGameState() must hold after every tick (built with -DGAME_CHECKS the update also
+// checks the shield texel lookups). No window, audio or raylib: a run is a memset or a copy of a
+// few kilobytes of setup, and the ticks themselves.
+//
+//   make fuzz        libFuzzer with ASan/UBSan (clang): ./invaders_fuzz -max_len=2048 corpus/
+//   make fuzz-afl    AFL++ persistent mode: afl-fuzz -i seeds -o findings ./invaders_fuzz_afl
+//   make fuzz-run    plain runner, any compiler:
+//     invaders_fuzz_run crash-file [...]   replay inputs (crashes found by either fuzzer)
+//     invaders_fuzz_run --seeds dir        write a starting corpus (fresh games and snapshots of
+//                                          autopilot games at several depths)
+//     invaders_fuzz_run --bench [ticks]    executions per second, fresh and snapshot starts, at
+//                                          8 to FUZZ_MAX_TICKS ticks unless given
+//
+// Speed (gcc -O2, no sanitizers, one core): a tick with its CheckGameState() costs about 1 us on
+// random input, so a run's cost is its length. With 8 ticks the plain runner measures about 110k
+// executions/s from a fresh seed, 190k from a snapshot decoded on an earlier run (the last blob is
+// kept, so mutations of the tick bytes skip LoadState()) and 85k from a new snapshot; at 64 ticks
+// it is 13k-16k, at FUZZ_MAX_TICKS about 200. The 100k/s goal only holds for short inputs, and
+// instrumented builds are a few times slower. -max_len=2048 fits a snapshot and ~1000 ticks.
+//
+// Input layout:
+//   byte 0        bit 0 clear: fresh game, the next 8 bytes are the seed (little-endian)
+//                 bit 0 set: the next 2 bytes give a size, then a SaveState() blob of that size;
+//                 SealState() rewrites its size and checksum, so mutations reach LoadState()'s
+//                 validation instead of dying on the checksum
+//   rest          one byte per tick: bits 0-2 PackGameInput(), bit 3 ReviveAlien() before the
+//                 tick (versus); 0xFF instead ticks nothing and makes a SaveState()/LoadState()
+//                 round trip, checked to keep the state hash
+
+#include "game.h"
+#include "autopilot.h"
+#include <stdio.h>  // For printf(), fopen()
+#include <stdlib.h> // For abort(), strtol()
+#include <string.h> // For memcpy(), strcmp()
+
+//----------------------------------------------------------------------------------
+// Defines
+//----------------------------------------------------------------------------------
+#define FUZZ_MAX_TICKS          4096    // Longer inputs are cut, a run stays in the milliseconds
+#define FUZZ_SEED_TICKS         256     // Ticks after each start in the --seeds corpus
+#define FUZZ_MAX_INPUT          (3 + GAME_STATE_MAX_SIZE + FUZZ_MAX_TICKS)
+#define FUZZ_TICK_REVIVE        0x08
+#define FUZZ_ROUND_TRIP         0xFF    // Whole byte, no tick: a round trip costs as much as two dozen ticks
+#define FUZZ_START_SNAPSHOT     0x01
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition - Harness
+//----------------------------------------------------------------------------------
+static void Fail(const Game *game, const char *what)
+{
+    fprintf(stderr, "FUZZ: %s at tick %u (wave %d, score %d)\n", what, (unsigned)game->tick, game->currentWave, game->score);
+    abort();
+}
+
+// Returns the offset of the first tick byte, or -1 when the start is unusable (not a bug)
+static int StartGame(Game *game, const uint8_t *data, int size)
+{
+    if (size < 1) return -1;
+
+    if ((data[0] & FUZZ_START_SNAPSHOT) == 0) {
+        uint64_t seed = 0;
+        for (int i = 0; (i < 8) && (1 + i < size); i++) seed |= (uint64_t)data[1 + i] << (8*i);
+        InitGameState(game, seed);
+        return (size < 9) ? size : 9;
+    }
+
+    if (size < 3) return -1;
+    int blobSize = data[1] | (data[2] << 8);
+    if ((blobSize > GAME_STATE_MAX_SIZE) || (3 + blobSize > size)) return -1;
+
+    // Most mutations change the tick bytes and keep the start: the last blob decoded is reused
+    static unsigned char cachedBlob[GAME_STATE_MAX_SIZE];
+    static int cachedSize = -1;
+    static bool cachedValid = false;
+    static Game cachedGame;
+    if ((blobSize != cachedSize) || (memcmp(cachedBlob, data + 3, blobSize) != 0)) {
+        static unsigned char blob[GAME_STATE_MAX_SIZE];
+        memcpy(cachedBlob, data + 3, blobSize);
+        memcpy(blob, data + 3, blobSize);
+        cachedSize = blobSize;
+
+        InitGameState(&cachedGame, 0); // Tuning and the fixed layout, LoadState() keeps them
+        cachedValid = SealState(blob, blobSize) && LoadState(&cachedGame, blob, blobSize);
+    }
+    if (!cachedValid) return -1;
+
+    *game = cachedGame;
+    return 3 + blobSize;
+}
+
+static void RoundTrip(Game *game)
+{
+    static unsigned char blob[GAME_STATE_MAX_SIZE];
+    int size = SaveState(game, blob, sizeof(blob));
+    if (size == 0) Fail(game, "SaveState() did not fit GAME_STATE_MAX_SIZE");
+
+    GameHash before = HashGameState(game);
+    if (!LoadState(game, blob, size)) Fail(game, "LoadState() refused a SaveState() blob");
+    if (HashGameState(game).total != before.total) Fail(game, "state hash changed over a save/load round trip");
+}
+
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+    static Game game; // Static: the fuzzer calls this millions of times, Game is a few kilobytes
+
+    int length = (size > FUZZ_MAX_INPUT) ? FUZZ_MAX_INPUT : (int)size;
+    int offset = StartGame(&game, data, length);
+    if (offset < 0) return 0;
+
+    const char *broken = CheckGameState(&game);
+    if (broken != NULL) Fail(&game, broken);
+
+    int end = (length - offset > FUZZ_MAX_TICKS) ? offset + FUZZ_MAX_TICKS : length;
+    for (int i = offset; i < end; i++) {
+        uint8_t bits = data[i];
+        if (bits == FUZZ_ROUND_TRIP) { RoundTrip(&game); continue; }
+        if (bits & FUZZ_TICK_REVIVE) ReviveAlien(&game);
+
+        UpdateGameState(&game, UnpackGameInput(bits & 0x07));
+        broken = CheckGameState(&game);
+        if (broken != NULL) Fail(&game, broken);
+    }
+
+    return 0;
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition - Standalone runner (libFuzzer brings its own main)
+//----------------------------------------------------------------------------------
+#if !defined(FUZZ_LIBFUZZER)
+#include <time.h>   // For clock_gettime()
+
+#if defined(__AFL_FUZZ_TESTCASE_LEN)
+__AFL_FUZZ_INIT();
+#endif
+
+static bool WriteSeed(const char *dir, const char *kind, int index, const uint8_t *data, int size)
+{
+    char path[512];
+    snprintf(path, sizeof(path), "%s/%s-%02d", dir, kind, index);
+    FILE *file = fopen(path, "wb");
+    if (file == NULL) return false;
+    bool ok = (fwrite(data, 1, size, file) == (size_t)size);
+    fclose(file);
+    return ok;
+}
+
+static uint8_t NextRandom(uint64_t *random)
+{
+    *random ^= *random << 13; *random ^= *random >> 7; *random ^= *random << 17;
+    return (uint8_t)*random;
+}
+
+// Snapshot start of an autopilot game; past half the depth it stops early with the UFO in flight
+// (ufo) or the player exploding. Returns the offset of the first tick byte
+static int MakeSnapshotStart(uint8_t *input, uint64_t seed, int depth, bool ufo)
+{
+    Game game;
+    InitGameState(&game, seed);
+    for (int t = 0; (t < depth) && !game.gameOver; t++) {
+        UpdateGameState(&game, GetAutopilotInput(&game));
+        if ((t > depth/2) && (ufo ? game.ufo.active : game.player.exploding)) break;
+    }
+
+    int blobSize = SaveState(&game, input + 3, GAME_STATE_MAX_SIZE);
+    input[0] = FUZZ_START_SNAPSHOT;
+    input[1] = blobSize & 0xFF;
+    input[2] = (blobSize >> 8) & 0xFF;
+    return 3 + blobSize;
+}
+
+// Fresh games and snapshots of autopilot games where the interesting states are: later waves,
+// the UFO in flight, the player exploding; each followed by a few hundred random inputs
+static int WriteSeeds(const char *dir)
+{
+    static uint8_t input[FUZZ_MAX_INPUT];
+    uint64_t random = 0x9E3779B97F4A7C15ULL;
+    int written = 0;
+
+    for (int s = 0; s < 8; s++) {
+        input[0] = 0;
+        for (int i = 0; i < 8; i++) input[1 + i] = (uint8_t)(s >> (8*i));
+        for (int i = 0; i < FUZZ_SEED_TICKS; i++) input[9 + i] = NextRandom(&random) & 0x07;
+        written += WriteSeed(dir, "fresh", s, input, 9 + FUZZ_SEED_TICKS) ? 1 : 0;
+    }
+
+    static const int depths[] = { 600, 3000, 9000, 20000 };
+    for (int s = 0; s < 4; s++) {
+        for (int d = 0; d < (int)(sizeof(depths)/sizeof(depths[0])); d++) {
+            int offset = MakeSnapshotStart(input, 100 + s, depths[d], (d%2 == 1));
+            for (int i = 0; i < FUZZ_SEED_TICKS; i++) input[offset + i] = NextRandom(&random) & 0x07;
+            written += WriteSeed(dir, "snapshot", s*10 + d, input, offset + FUZZ_SEED_TICKS) ? 1 : 0;
+        }
+    }
+
+    printf("%s: %d seed inputs\n", dir, written);
+    return (written > 0) ? 0 : 1;
+}
+
+static int RunFiles(int count, char **files)
+{
+    static uint8_t data[FUZZ_MAX_INPUT];
+    for (int i = 0; i < count; i++) {
+        FILE *file = fopen(files[i], "rb");
+        if (file == NULL) { fprintf(stderr, "%s: cannot open\n", files[i]); return 1; }
+        size_t size = fread(data, 1, sizeof(data), file);
+        fclose(file);
+        LLVMFuzzerTestOneInput(data, size);
+        printf("%s: OK, %d bytes\n", files[i], (int)size);
+    }
+    return 0;
+}
+
+// Executions per second over random tick bytes after the given starts, taken in turn (a fresh
+// seed is also random)
+static double BenchRuns(uint8_t **starts, const int *offsets, int startCount, int ticks)
+{
+    uint64_t random = 0x2545F4914F6CDD1DULL;
+    struct timespec start, now;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    long runs = 0;
+    double elapsed = 0.0;
+    do {
+        for (int k = 0; k < 200; k++, runs++) {
+            uint8_t *data = starts[runs%startCount];
+            int offset = offsets[runs%startCount];
+            if (data[0] == 0) for (int i = 1; i < offset; i++) data[i] = NextRandom(&random);
+            for (int i = 0; i < ticks; i++) data[offset + i] = NextRandom(&random);
+            LLVMFuzzerTestOneInput(data, offset + ticks);
+        }
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        elapsed = (now.tv_sec - start.tv_sec) + (now.tv_nsec - start.tv_nsec)/1e9;
+    } while (elapsed < 1.0);
+    return runs/elapsed;
+}
+
+// Fresh seeds, one snapshot (decoded once, like mutations of the tick bytes) and two snapshots
+// in turn (decoded every run, like mutations of the blob)
+static int Bench(int ticks)
+{
+    static uint8_t fresh[FUZZ_MAX_INPUT], first[FUZZ_MAX_INPUT], second[FUZZ_MAX_INPUT];
+    static const int counts[] = { 8, 64, 512, FUZZ_MAX_TICKS };
+    fresh[0] = 0;
+    int offsets[2] = { MakeSnapshotStart(first, 101, 3000, true), MakeSnapshotStart(second, 102, 9000, false) };
+
+    for (int c = 0; c < (int)(sizeof(counts)/sizeof(counts[0])); c++) {
+        int n = (ticks > 0) ? ticks : counts[c];
+        if (n > FUZZ_MAX_TICKS) n = FUZZ_MAX_TICKS;
+        uint8_t *starts[2] = { first, second };
+        double freshRate = BenchRuns((uint8_t *[]){ fresh }, (int[]){ 9 }, 1, n);
+        double cachedRate = BenchRuns(starts, offsets, 1, n);
+        double decodedRate = BenchRuns(starts, offsets, 2, n);
+        printf("%4d ticks: fresh %7.0f, snapshot %7.0f, new snapshot %7.0f executions/s\n", n, freshRate, cachedRate, decodedRate);
+        if (ticks > 0) break;
+    }
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+#if defined(__AFL_FUZZ_TESTCASE_LEN)
+    // AFL++ persistent mode: the test case arrives in shared memory, no process per input
+    __AFL_INIT();
+    unsigned char *buffer = __AFL_FUZZ_TESTCASE_BUF;
+    while (__AFL_LOOP(100000)) LLVMFuzzerTestOneInput(buffer, __AFL_FUZZ_TESTCASE_LEN);
+    return 0;
+#endif
+
+    if ((argc == 3) && (strcmp(argv[1], "--seeds") == 0)) return WriteSeeds(argv[2]);
+    if ((argc >= 2) && (strcmp(argv[1], "--bench") == 0)) return Bench((argc >= 3) ? (int)strtol(argv[2], NULL, 10) : 0);
+    if (argc >= 2) return RunFiles(argc - 1, argv + 1);
+
+    // Plain AFL (or a pipe): one input on stdin
+    static uint8_t data[FUZZ_MAX_INPUT];
+    size_t size = fread(data, 1, sizeof(data), stdin);
+    LLVMFuzzerTestOneInput(data, size);
+    return 0;
+}
+#endif
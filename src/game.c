@@ -0,0 +1,1469 @@
+#include "game.h"
+#include <math.h>   // For sqrtf(), ceilf(), floorf()
+#include <string.h> // For memcpy(), memset()
+
+// #define UNIT_TEST 1
+
+//----------------------------------------------------------------------------------
+// Defines
+//----------------------------------------------------------------------------------
+// Built-in tuning, see GameTuning
+#define ALIEN_MOVE_WAIT_TIME_START 0.8f // Initial time between alien moves (seconds)
+#define ALIEN_WAVE_SPEEDUP         0.2f // Later waves start faster
+#define ALIEN_MOVE_SPEEDUP_FACTOR  0.97f // Multiplier applied to wait time when an alien is killed
+#define ALIEN_SHOOT_INTERVAL_MIN   0.5f // Minimum time between alien shots
+#define ALIEN_SHOOT_INTERVAL_MAX   2.0f // Maximum time between alien shots
+
+#define UFO_SPEED               55.0f // Pixels per second
+#define UFO_POINTS              200
+
+#define UFO_SPAWN_INTERVAL_MIN  30.0f // Minimum seconds until UFO appears
+#define UFO_SPAWN_INTERVAL_MAX  240.0f // Maximum seconds until UFO appears
+#define UFO_RETURN_TICKS_MIN    600 // After flying off screen it is back sooner, 10 to 30 s
+#define UFO_RETURN_TICKS_MAX    1800
+
+#define EXPLOSION_TICKS         18 // 0.3 s on screen
+#define UFO_EXPLOSION_TICKS     30
+#define PLAYER_EXPLOSION_TICKS  60 // Until the life is lost
+
+#define TIMER_LEVEL_BITS        6 // log2(GAME_TIMER_SLOTS)
+#define TIMER_MAX_TICKS         ((1u << (TIMER_LEVEL_BITS*GAME_TIMER_LEVELS)) - 1)
+#define TIMER_BIT(timer)        (1u << (timer)) // GAME_TIMER_COUNT fits a uint32_t
+
+// Fuzz and debug builds (-DGAME_CHECKS) stop at the first broken assumption inside the update
+#if defined(GAME_CHECKS)
+    #include <stdio.h>  // For fprintf()
+    #include <stdlib.h> // For abort()
+    #define GAME_CHECK(condition) do { if (!(condition)) { fprintf(stderr, "GAME_CHECK failed: %s (%s:%d)\n", #condition, __FILE__, __LINE__); abort(); } } while (0)
+#else
+    #define GAME_CHECK(condition) ((void)0)
+#endif
+
+#define STATE_MAGIC             0x53564E49 // "INVS"
+#define STATE_HEADER_SIZE       12
+
+//----------------------------------------------------------------------------------
+// Global Variables Definition
+//----------------------------------------------------------------------------------
+static GameTuning gameTuning = {
+    ALIEN_MOVE_WAIT_TIME_START, ALIEN_WAVE_SPEEDUP, ALIEN_MOVE_SPEEDUP_FACTOR,
+    ALIEN_SHOOT_INTERVAL_MIN, ALIEN_SHOOT_INTERVAL_MAX, ALIEN_BULLET_SPEED
+};
+
+// Alpha channel of resources/shield.png, top row first
+static const unsigned char shieldBaseAlpha[SHIELD_TEX_HEIGHT][SHIELD_TEX_WIDTH] = {
+    {   0,   0,   0,   0, 209, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 209,   0,   0,   0,   0 },
+    {   0,   0,   0, 157, 245, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 245, 157,   0,   0,   0 },
+    {   0,   0, 159, 251, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 251, 159,   0,   0 },
+    {   1, 160, 250, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 250, 160,   1 },
+    { 217, 250, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 250, 217 },
+    { 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255 },
+    { 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255 },
+    { 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255 },
+    { 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255 },
+    { 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255 },
+    { 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255 },
+    { 255, 255, 255, 255, 255, 255, 255, 222, 217, 217, 217, 217, 217, 221, 255, 255, 255, 255, 255, 255, 255, 255 },
+    { 255, 255, 255, 255, 255, 255, 213,  27,   1,   1,   1,   1,   1,  24, 210, 255, 255, 255, 255, 255, 255, 255 },
+    { 255, 255, 255, 255, 255, 209,  27,   0,   0,   0,   0,   0,   0,   0,  23, 207, 254, 255, 255, 255, 255, 255 },
+    { 255, 255, 255, 255, 255,  37,   0,   0,   0,   0,   0,   0,   0,   0,   0,  33, 252, 255, 255, 255, 255, 255 },
+    { 255, 255, 255, 255, 255,  40,   0,   0,   0,   0,   0,   0,   0,   0,   0,  36, 252, 255, 255, 255, 255, 255 },
+};
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration (local)
+//----------------------------------------------------------------------------------
+static void InitPlayer(Game *game);
+static void InitAliens(Game *game);
+static void InitShields(Game *game);
+static void SetupAlienGrid(Game *game);
+static void SetupShieldLayout(Game *game);
+static void DamageShield(Game *game, int shieldIndex, Vector2 hitPosition);
+static void UpdateAliens(Game *game, uint32_t fired);
+static void UpdateBullets(Game *game);
+static void UpdateUFO(Game *game, uint32_t fired);
+static void UpdateExplosions(Game *game, uint32_t fired);
+static void StartTimer(Game *game, GameTimer timer, int ticks);
+static void StopTimer(Game *game, GameTimer timer);
+static uint32_t AdvanceTimers(Game *game);
+static void ScheduleUFO(Game *game);
+static void CheckCollisions(Game *game);
+static void SpawnPlayerShot(Game *game);
+static void SpawnAlienShot(Game *game, Vector2 position);
+static void SpawnUFO(Game *game);
+static void SpawnExplosion(Game *game, Vector2 position, ExplosionType type, Vector2 size);
+static void NextLevel(Game *game);
+static Vector2 WorldToShieldTexCoords(const Game *game, int shieldIndex, Vector2 worldPos);
+static void EmitEvent(Game *game, GameEventType type, int param);
+static void AddScore(Game *game, int points);
+static int GetRandomValueGame(Game *game, int min, int max);
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition - Utils
+//----------------------------------------------------------------------------------
+static bool CheckCollisionRecs(Rectangle rec1, Rectangle rec2)
+{
+    return ((rec1.x < (rec2.x + rec2.width) && (rec1.x + rec1.width) > rec2.x) &&
+            (rec1.y < (rec2.y + rec2.height) && (rec1.y + rec1.height) > rec2.y));
+}
+
+// xorshift64*, the whole generator state is game->rngState so snapshots restore it exactly
+static int GetRandomValueGame(Game *game, int min, int max)
+{
+    if (min > max) { int tmp = max; max = min; min = tmp; }
+
+    uint64_t x = game->rngState;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    game->rngState = x;
+
+    uint32_t value = (uint32_t)((x*0x2545F4914F6CDD1DULL) >> 32);
+    return min + (int)(value % (uint32_t)(max - min + 1));
+}
+
+static void EmitEvent(Game *game, GameEventType type, int param)
+{
+    if (game->eventCount < GAME_MAX_EVENTS) game->events[game->eventCount++] = (GameEvent){ type, param };
+}
+
+static void AddScore(Game *game, int points)
+{
+    game->score = (game->score > GAME_MAX_SCORE - points) ? GAME_MAX_SCORE : game->score + points;
+}
+
+static Vector2 WorldToShieldTexCoords(const Game *game, int shieldIndex, Vector2 worldPos)
+{
+    // Convert world position to the shield texel, rows top to bottom like the mask texture
+    float scaleX = (float)SHIELD_TEX_WIDTH/game->shields[shieldIndex].bounds.width;
+    float scaleY = (float)SHIELD_TEX_HEIGHT/game->shields[shieldIndex].bounds.height;
+
+    Vector2 local;
+    local.x = (worldPos.x - game->shields[shieldIndex].position.x)*scaleX;
+    local.y = (worldPos.y - game->shields[shieldIndex].position.y)*scaleY;
+
+    // Clamp to valid pixel range so we never read OOB (NaN slips through every comparison)
+    if (local.x < 0) local.x = 0;
+    if (local.y < 0) local.y = 0;
+    if (local.x > SHIELD_TEX_WIDTH - 1) local.x = SHIELD_TEX_WIDTH - 1;
+    if (local.y > SHIELD_TEX_HEIGHT - 1) local.y = SHIELD_TEX_HEIGHT - 1;
+    GAME_CHECK((shieldIndex >= 0) && (shieldIndex < NUM_SHIELDS));
+    GAME_CHECK((local.x >= 0) && (local.x <= SHIELD_TEX_WIDTH - 1) && (local.y >= 0) && (local.y <= SHIELD_TEX_HEIGHT - 1));
+    return local;
+}
+
+static unsigned char GetShieldAlpha(const Game *game, int shieldIndex, Vector2 texHit)
+{
+    return game->shields[shieldIndex].alpha[(int)texHit.y][(int)texHit.x];
+}
+
+bool IsShieldSolid(const Game *game, int shieldIndex, Vector2 worldPos)
+{
+    return GetShieldAlpha(game, shieldIndex, WorldToShieldTexCoords(game, shieldIndex, worldPos)) > 10;
+}
+
+#ifdef UNIT_TEST
+#include <stdio.h>
+#include <assert.h>
+
+// Helper: expose the core of "alien bullet vs shield" collision so we can call it from main()
+bool TestAlienBulletShieldCollision(Game *game, int bi, int si, Vector2 *outWorldHit, unsigned char *outAlpha)
+{
+    // build bullet rect
+    Rectangle bulletRect = {
+        game->alienBullets[bi].position.x,
+        game->alienBullets[bi].position.y,
+        game->alienBullets[bi].size.x,
+        game->alienBullets[bi].size.y
+    };
+
+    // quick AABB check
+    if (!game->shields[si].active
+     || !CheckCollisionRecs(bulletRect, game->shields[si].bounds))
+        return false;
+
+    // compute world-space hit point (bottom of bullet)
+    Vector2 worldHit = {
+        bulletRect.x + bulletRect.width*0.5f,
+        bulletRect.y + bulletRect.height
+    };
+    *outWorldHit = worldHit;
+
+    // convert into shield-texture coordinates
+    Vector2 texHit = WorldToShieldTexCoords(game, si, worldHit);
+
+    printf("[UNIT_TEST] Bullet[%d] vs Shield[%d]: worldHit=(%.1f,%.1f) texHit=(%.1f,%.1f)\n",
+           bi, si, worldHit.x, worldHit.y, texHit.x, texHit.y);
+
+    // sample the pixel alpha
+    unsigned char alpha = GetShieldAlpha(game, si, texHit);
+    *outAlpha = alpha;
+
+    printf("[UNIT_TEST] sample alpha = %d → %s\n",
+           alpha, (alpha > 10) ? "HIT" : "MISS");
+
+    return (alpha > 10);
+}
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition - Game Initialization
+//----------------------------------------------------------------------------------
+GameTuning GetDefaultGameTuning(void)
+{
+    return (GameTuning){ ALIEN_MOVE_WAIT_TIME_START, ALIEN_WAVE_SPEEDUP, ALIEN_MOVE_SPEEDUP_FACTOR,
+                         ALIEN_SHOOT_INTERVAL_MIN, ALIEN_SHOOT_INTERVAL_MAX, ALIEN_BULLET_SPEED };
+}
+
+void SetGameTuning(const GameTuning *tuning)
+{
+    gameTuning = (tuning != NULL) ? *tuning : GetDefaultGameTuning();
+}
+
+GameTuning GetGameTuning(void)
+{
+    return gameTuning;
+}
+
+void InitGameState(Game *game, uint64_t seed)
+{
+    InitGameStateTuned(game, seed, &gameTuning);
+}
+
+void InitGameStateTuned(Game *game, uint64_t seed, const GameTuning *tuning)
+{
+    memset(game, 0, sizeof(Game));
+    game->tuning = *tuning;
+
+    // splitmix64 scramble so nearby seeds give unrelated sequences (xorshift state must be non-zero)
+    uint64_t z = seed + 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30))*0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27))*0x94D049BB133111EBULL;
+    game->rngState = (z ^ (z >> 31)) | 1;
+
+    game->gameOver = false;
+    game->score = 0;
+    game->currentWave = 1;
+
+    InitPlayer(game);
+    game->player.lives = GAME_START_LIVES;
+
+    // Init Alien Bullets
+    for (int i = 0; i < MAX_ALIEN_BULLETS; i++) {
+        game->alienBullets[i].active = false;
+        game->alienBullets[i].size = (Vector2){ SPRITE_ALIEN_SHOT_WIDTH*1.5f, SPRITE_ALIEN_SHOT_HEIGHT*1.5f };
+        game->alienBullets[i].speed = tuning->alienBulletSpeed;
+    }
+
+    // Init UFO
+    game->ufo.size = (Vector2){ SPRITE_UFO_WIDTH*1.5f, SPRITE_UFO_HEIGHT*1.5f };
+    game->ufo.active = false;
+    ScheduleUFO(game);
+
+    // Init Explosions
+    for (int i = 0; i < MAX_EXPLOSIONS; i++) game->explosions[i].active = false;
+
+    InitAliens(game);
+    InitShields(game);
+}
+
+static void InitPlayer(Game *game)
+{
+    Player *player = &game->player;
+    player->size = (Vector2){ SPRITE_PLAYER_WIDTH*1.5f, SPRITE_PLAYER_HEIGHT*1.5f }; // Scale slightly
+    player->position = (Vector2){ SCREEN_WIDTH/2.0f - player->size.x/2.0f, SCREEN_HEIGHT - player->size.y - 20.0f };
+    player->shotActive = false;
+    player->shotSize = (Vector2){ SPRITE_PLAYER_SHOT_WIDTH*1.5f, SPRITE_PLAYER_SHOT_HEIGHT*1.5f };
+    player->exploding = false;
+}
+
+// Grid positions, types and points never change during a game, so they are not saved
+static void SetupAlienGrid(Game *game)
+{
+    float startX = 80.0f;
+    float startY = 80.0f;
+    float spacingX = 45.0f;
+    float spacingY = 35.0f;
+
+    for (int r = 0; r < ALIENS_ROWS; r++) {
+        for (int c = 0; c < ALIENS_COLS; c++) {
+            Alien *alien = &game->aliens[r*ALIENS_COLS + c];
+            alien->basePosition = (Vector2){ startX + c*spacingX, startY + r*spacingY };
+            alien->size = (Vector2){ SPRITE_ALIEN_WIDTH*1.5f, SPRITE_ALIEN_HEIGHT*1.5f };
+
+            if (r == 0) { // Top row
+                alien->type = ALIEN_TYPE_3;
+                alien->points = 30;
+            } else if (r < 3) { // Middle rows
+                alien->type = ALIEN_TYPE_2;
+                alien->points = 20;
+            } else { // Bottom rows
+                alien->type = ALIEN_TYPE_1;
+                alien->points = 10;
+            }
+        }
+    }
+}
+
+static void InitAliens(Game *game)
+{
+    SetupAlienGrid(game);
+
+    game->aliensAlive = 0;
+    for (int i = 0; i < NUM_ALIENS; i++) {
+        game->aliens[i].position = game->aliens[i].basePosition;
+        game->aliens[i].active = true;
+        game->aliens[i].currentFrame = false;
+        game->aliensAlive++;
+    }
+
+    const GameTuning *tuning = &game->tuning;
+    game->alienMoveWaitTime = tuning->alienStepTimeStart/(1.0f + (game->currentWave - 1)*tuning->waveSpeedup); // Faster start on later waves
+    StartTimer(game, TIMER_ALIEN_STEP, GameSecondsToTicks(game->alienMoveWaitTime));
+    game->alienDirection = 1;
+    game->moveDown = false;
+    game->alienMoveSoundIndex = 0;
+    StartTimer(game, TIMER_ALIEN_SHOT, GameSecondsToTicks(GetRandomValueGame(game, (int)(tuning->alienShootIntervalMin*100), (int)(tuning->alienShootIntervalMax*100))/100.0f));
+}
+
+static void SetupShieldLayout(Game *game)
+{
+    float shieldSpacing = (SCREEN_WIDTH - (NUM_SHIELDS*SHIELD_TEX_WIDTH*2.0f))/(NUM_SHIELDS + 1); // Scaled width
+    float shieldY = SCREEN_HEIGHT - 120.0f;
+
+    for (int i = 0; i < NUM_SHIELDS; i++) {
+        Shield *shield = &game->shields[i];
+        shield->position = (Vector2){ shieldSpacing + i*(SHIELD_TEX_WIDTH*2.0f + shieldSpacing), shieldY };
+        shield->bounds = (Rectangle){ shield->position.x, shield->position.y, SHIELD_TEX_WIDTH*2.0f, SHIELD_TEX_HEIGHT*2.0f }; // Scaled bounds
+    }
+
+    InvalidateShields(game);
+}
+
+static void InitShields(Game *game)
+{
+    SetupShieldLayout(game);
+
+    for (int i = 0; i < NUM_SHIELDS; i++) {
+        game->shields[i].active = true;
+
+        memcpy(game->shields[i].alpha, shieldBaseAlpha, sizeof(shieldBaseAlpha));
+    }
+}
+
+void ClearShieldDirty(Game *game, int shieldIndex)
+{
+    game->shieldDirty[shieldIndex] = (ShieldDirty){ SHIELD_TEX_WIDTH, SHIELD_TEX_HEIGHT, -1, -1 };
+}
+
+void InvalidateShields(Game *game)
+{
+    for (int i = 0; i < NUM_SHIELDS; i++) {
+        game->shieldDirty[i] = (ShieldDirty){ 0, 0, SHIELD_TEX_WIDTH - 1, SHIELD_TEX_HEIGHT - 1 };
+    }
+}
+
+uint8_t PackGameInput(GameInput input)
+{
+    return (uint8_t)((input.left ? 1 : 0) | (input.right ? 2 : 0) | (input.fire ? 4 : 0));
+}
+
+GameInput UnpackGameInput(uint8_t bits)
+{
+    return (GameInput){ (bits & 1) != 0, (bits & 2) != 0, (bits & 4) != 0 };
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition - Game Update
+//----------------------------------------------------------------------------------
+void UpdateGameState(Game *game, GameInput input)
+{
+    game->eventCount = 0;
+    if (game->gameOver) return;
+
+    game->tick++;
+    uint32_t fired = AdvanceTimers(game);
+    Player *player = &game->player;
+
+    // Player Control
+    if (!player->exploding) { // Only allow control if not exploding
+        if (input.left) player->position.x -= PLAYER_SPEED;
+        if (input.right) player->position.x += PLAYER_SPEED;
+
+        // Keep player on screen
+        if (player->position.x < 0) player->position.x = 0;
+        if (player->position.x > SCREEN_WIDTH - player->size.x) player->position.x = SCREEN_WIDTH - player->size.x;
+
+        // Player Shooting
+        if (input.fire) SpawnPlayerShot(game);
+    } else if (fired & TIMER_BIT(TIMER_PLAYER_RESPAWN)) {
+        player->exploding = false;
+        player->lives--;
+        if (player->lives <= 0) {
+            game->gameOver = true;
+        } else {
+            // Reset player position for respawn
+            player->position = (Vector2){ SCREEN_WIDTH/2.0f - player->size.x/2.0f, SCREEN_HEIGHT - player->size.y - 20.0f };
+        }
+    }
+
+    UpdateAliens(game, fired);
+    UpdateBullets(game);
+    UpdateUFO(game, fired);
+    UpdateExplosions(game, fired);
+    CheckCollisions(game);
+
+    // Check Win Condition (All aliens destroyed)
+    if (game->aliensAlive <= 0 && !game->ufo.active && !player->exploding) {
+        NextLevel(game);
+    }
+
+    // Check Lose Condition (Aliens reach bottom)
+    for (int i = 0; i < NUM_ALIENS; i++) {
+        Alien *alien = &game->aliens[i];
+        if (alien->active) {
+            if (alien->position.y + alien->size.y >= player->position.y) {
+                game->gameOver = true;
+                EmitEvent(game, EVENT_INVASION, 0); // Player dies even if not shot
+                break;
+            }
+            // Check if aliens reached shield level
+            Rectangle alienRect = { alien->position.x, alien->position.y, alien->size.x, alien->size.y };
+            for (int s = 0; s < NUM_SHIELDS; s++) {
+                if (game->shields[s].active && CheckCollisionRecs(alienRect, game->shields[s].bounds)) {
+                    // Damage shield significantly if aliens touch it
+                    Vector2 contact = { alien->position.x + alien->size.x/2, alien->position.y + alien->size.y };
+                    DamageShield(game, s, contact);
+                    DamageShield(game, s, contact);
+                    DamageShield(game, s, contact);
+                }
+            }
+        }
+    }
+}
+
+static void UpdateAliens(Game *game, uint32_t fired)
+{
+    if (fired & TIMER_BIT(TIMER_ALIEN_STEP)) {
+        game->moveDown = false;
+        float leftmost = SCREEN_WIDTH;
+        float rightmost = 0;
+
+        // Check bounds and find edges
+        for (int i = 0; i < NUM_ALIENS; i++) {
+            if (game->aliens[i].active) {
+                if (game->aliens[i].position.x < leftmost) leftmost = game->aliens[i].position.x;
+                if (game->aliens[i].position.x + game->aliens[i].size.x > rightmost) rightmost = game->aliens[i].position.x + game->aliens[i].size.x;
+            }
+        }
+
+        // Check if edge hit
+        if ((rightmost + ALIEN_HORIZONTAL_MOVE*game->alienDirection > SCREEN_WIDTH && game->alienDirection > 0) ||
+            (leftmost + ALIEN_HORIZONTAL_MOVE*game->alienDirection < 0 && game->alienDirection < 0)) {
+            game->alienDirection *= -1;
+            game->moveDown = true;
+        }
+
+        // Move aliens
+        for (int i = 0; i < NUM_ALIENS; i++) {
+            if (game->aliens[i].active) {
+                if (game->moveDown) game->aliens[i].position.y += ALIEN_VERTICAL_MOVE;
+                else game->aliens[i].position.x += ALIEN_HORIZONTAL_MOVE*game->alienDirection;
+
+                // Switch animation frame
+                game->aliens[i].currentFrame = !game->aliens[i].currentFrame;
+            }
+        }
+
+        // Play move sound
+        EmitEvent(game, EVENT_ALIEN_STEP, game->alienMoveSoundIndex);
+        game->alienMoveSoundIndex = (game->alienMoveSoundIndex + 1)%4;
+
+        // Next step, kills since the last one already shortened the wait
+        StartTimer(game, TIMER_ALIEN_STEP, GameSecondsToTicks(game->alienMoveWaitTime));
+    }
+
+    // Alien Shooting Logic, without aliens the timer stays off until the next wave arms it
+    if ((fired & TIMER_BIT(TIMER_ALIEN_SHOT)) && game->aliensAlive > 0) {
+        int tries = 0;
+        bool shotFired = false;
+        while (tries < NUM_ALIENS && !shotFired) { // Limit tries to avoid infinite loop if logic fails
+            int shooterIndex = GetRandomValueGame(game, 0, NUM_ALIENS - 1);
+
+            if (game->aliens[shooterIndex].active) {
+                Alien *shooter = &game->aliens[shooterIndex];
+                Vector2 shotPos = { shooter->position.x + shooter->size.x/2 - game->alienBullets[0].size.x/2,
+                                    shooter->position.y + shooter->size.y };
+                SpawnAlienShot(game, shotPos);
+                shotFired = true;
+            }
+            tries++;
+        }
+
+        // Reset shoot timer with some randomness, scaling with fewer aliens
+        float shootIntervalMultiplier = ((float)game->aliensAlive/NUM_ALIENS)*0.5f + 0.5f; // Becomes faster (0.5x to 1.0x interval) as aliens die
+        float interval = (GetRandomValueGame(game, (int)(game->tuning.alienShootIntervalMin*100), (int)(game->tuning.alienShootIntervalMax*100))/100.0f)*shootIntervalMultiplier;
+        if (interval < 0.1f) interval = 0.1f; // Minimum interval cap
+        StartTimer(game, TIMER_ALIEN_SHOT, GameSecondsToTicks(interval));
+    }
+}
+
+static void UpdateBullets(Game *game)
+{
+    // Player Bullet
+    if (game->player.shotActive) {
+        game->player.shotPosition.y -= PLAYER_BULLET_SPEED;
+        if (game->player.shotPosition.y + game->player.shotSize.y < 0) {
+            game->player.shotActive = false;
+        }
+    }
+
+    // Alien Shots vs Shields
+    for (int i = 0; i < MAX_ALIEN_BULLETS; i++) {
+        if (!game->alienBullets[i].active) continue;
+        Rectangle bulletRect = { game->alienBullets[i].position.x, game->alienBullets[i].position.y,
+                                 game->alienBullets[i].size.x, game->alienBullets[i].size.y };
+        for (int s = 0; s < NUM_SHIELDS; s++) {
+#ifdef UNIT_TEST
+            {
+                Vector2 wh; unsigned char alpha;
+                if (TestAlienBulletShieldCollision(game, i, s, &wh, &alpha)) {
+                    assert(alpha > 10 && "UNIT_TEST: expected opaque pixel → damage");
+                    game->alienBullets[i].active = false;
+                    printf("[UNIT_TEST] calling DamageShield(%d)\n", s);
+                    DamageShield(game, s, wh);
+                }
+            }
+            (void)bulletRect;
+            break;
+#else
+            if (game->shields[s].active && CheckCollisionRecs(bulletRect, game->shields[s].bounds)) {
+                Vector2 worldHit = { bulletRect.x + bulletRect.width*0.5f, bulletRect.y + bulletRect.height };
+                Vector2 texHit = WorldToShieldTexCoords(game, s, worldHit);
+
+                if (GetShieldAlpha(game, s, texHit) > 10) {
+                    game->alienBullets[i].active = false;
+                    DamageShield(game, s, worldHit);
+                    SpawnExplosion(game, worldHit, EXPLOSION_SHOT,
+                                   (Vector2){ SPRITE_SHOT_EXPLOSION_WIDTH, SPRITE_SHOT_EXPLOSION_HEIGHT });
+                }
+                break;
+            }
+#endif
+        }
+    }
+
+    // Alien Bullets
+    for (int i = 0; i < MAX_ALIEN_BULLETS; i++) {
+        if (game->alienBullets[i].active) {
+            game->alienBullets[i].position.y += game->alienBullets[i].speed; // Use individual speed if needed
+
+            if (game->alienBullets[i].position.y > SCREEN_HEIGHT) {
+                game->alienBullets[i].active = false;
+            }
+        }
+    }
+}
+
+static void UpdateUFO(Game *game, uint32_t fired)
+{
+    UFO *ufo = &game->ufo;
+
+    if (!ufo->active) {
+        // The timer is armed again when this UFO goes off-screen or is destroyed
+        if (fired & TIMER_BIT(TIMER_UFO_SPAWN)) SpawnUFO(game);
+        return;
+    }
+
+    // UFO is active
+    ufo->position.x += ufo->speed*GAME_TICK_TIME; // speed is in pixels per second, one tick per update
+
+    // Check if off screen
+    if ((ufo->speed > 0 && ufo->position.x > SCREEN_WIDTH) ||
+        (ufo->speed < 0 && ufo->position.x + ufo->size.x < 0)) {
+        ufo->active = false;
+        ufo->exploding = false; // A hit UFO drifting out is gone as well
+        StopTimer(game, TIMER_UFO_EXPLOSION);
+        EmitEvent(game, EVENT_UFO_GONE, 0); // Stop sound when offscreen
+        StartTimer(game, TIMER_UFO_SPAWN, GetRandomValueGame(game, UFO_RETURN_TICKS_MIN, UFO_RETURN_TICKS_MAX));
+        return;
+    }
+
+    // Remove the UFO once its explosion is over
+    if (fired & TIMER_BIT(TIMER_UFO_EXPLOSION)) {
+        ufo->exploding = false;
+        ufo->active = false; // Deactivate fully after explosion
+        ScheduleUFO(game);
+    }
+}
+
+static void ScheduleUFO(Game *game)
+{
+    float seconds = GetRandomValueGame(game, (int)(UFO_SPAWN_INTERVAL_MIN*100), (int)(UFO_SPAWN_INTERVAL_MAX*100))/100.0f;
+    StartTimer(game, TIMER_UFO_SPAWN, GameSecondsToTicks(seconds));
+}
+
+// Only the slots whose timer fired, the others are not looked at
+static void UpdateExplosions(Game *game, uint32_t fired)
+{
+    for (uint32_t expired = fired >> TIMER_EXPLOSION; expired != 0; expired &= expired - 1) {
+        int i = 0;
+        while (((expired >> i) & 1) == 0) i++;
+        game->explosions[i].active = false;
+    }
+}
+
+static void SpawnExplosion(Game *game, Vector2 position, ExplosionType type, Vector2 size)
+{
+    for (int i = 0; i < MAX_EXPLOSIONS; i++) {
+        if (!game->explosions[i].active) {
+            game->explosions[i].active = true;
+            game->explosions[i].position = (Vector2){ position.x - size.x/2, position.y - size.y/2 }; // Center explosion
+            game->explosions[i].type = type;
+            game->explosions[i].size = size;
+            StartTimer(game, TIMER_EXPLOSION + i, EXPLOSION_TICKS);
+            return; // Spawn only one
+        }
+    }
+}
+
+static void DamageShield(Game *game, int shieldIndex, Vector2 hitPosition)
+{
+    if (!game->shields[shieldIndex].active) return;
+
+    Vector2 localHit = WorldToShieldTexCoords(game, shieldIndex, hitPosition);
+    const float damageRadius = 5.0f;
+
+    // Only the pixels inside the damage radius can change
+    int x0 = (int)ceilf(localHit.x - damageRadius), x1 = (int)floorf(localHit.x + damageRadius);
+    int y0 = (int)ceilf(localHit.y - damageRadius), y1 = (int)floorf(localHit.y + damageRadius);
+    if (x0 < 0) x0 = 0;
+    if (y0 < 0) y0 = 0;
+    if (x1 > SHIELD_TEX_WIDTH - 1) x1 = SHIELD_TEX_WIDTH - 1;
+    if (y1 > SHIELD_TEX_HEIGHT - 1) y1 = SHIELD_TEX_HEIGHT - 1;
+    if (x0 > x1 || y0 > y1) return;
+
+    // Create a damage pattern: clear occupancy within the damage radius
+    for (int y = y0; y <= y1; y++) {
+        for (int x = x0; x <= x1; x++) {
+            float distance = sqrtf((x - localHit.x)*(x - localHit.x) + (y - localHit.y)*(y - localHit.y));
+            if (distance <= damageRadius) game->shields[shieldIndex].alpha[y][x] = 0;
+        }
+    }
+
+    // Grow the area the renderer has to re-upload
+    ShieldDirty *dirty = &game->shieldDirty[shieldIndex];
+    if (x0 < dirty->x0) dirty->x0 = x0;
+    if (y0 < dirty->y0) dirty->y0 = y0;
+    if (x1 > dirty->x1) dirty->x1 = x1;
+    if (y1 > dirty->y1) dirty->y1 = y1;
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition - Collision Detection
+//----------------------------------------------------------------------------------
+static void CheckCollisions(Game *game)
+{
+    Player *player = &game->player;
+
+    // --- Player Shot Collisions ---
+    if (player->shotActive) {
+        Rectangle playerShotRect = { player->shotPosition.x, player->shotPosition.y, player->shotSize.x, player->shotSize.y };
+
+        // 1. Player Shot vs Aliens
+        for (int i = 0; i < NUM_ALIENS; i++) {
+            Alien *alien = &game->aliens[i];
+            if (alien->active) {
+                Rectangle alienRect = { alien->position.x, alien->position.y, alien->size.x, alien->size.y };
+                if (CheckCollisionRecs(playerShotRect, alienRect)) {
+                    player->shotActive = false;
+                    alien->active = false;
+                    game->aliensAlive--;
+                    AddScore(game, alien->points);
+
+                    SpawnExplosion(game, (Vector2){ alien->position.x + alien->size.x/2, alien->position.y + alien->size.y/2 },
+                                   EXPLOSION_ALIEN, (Vector2){ SPRITE_ALIEN_EXPLOSION_WIDTH*1.5f, SPRITE_ALIEN_EXPLOSION_HEIGHT*1.5f });
+                    EmitEvent(game, EVENT_ALIEN_KILLED, i);
+                    game->alienMoveWaitTime *= game->tuning.alienSpeedupFactor;
+                    if (game->alienMoveWaitTime < 0.05f) game->alienMoveWaitTime = 0.05f;
+                    goto next_collision_check; // Exit alien loop once shot hits
+                }
+            }
+        }
+
+        // 2. Player Shot vs UFO
+        if (game->ufo.active && !game->ufo.exploding) {
+            Rectangle ufoRect = { game->ufo.position.x, game->ufo.position.y, game->ufo.size.x, game->ufo.size.y };
+            if (CheckCollisionRecs(playerShotRect, ufoRect)) {
+                player->shotActive = false;
+                game->ufo.exploding = true;
+                StartTimer(game, TIMER_UFO_EXPLOSION, UFO_EXPLOSION_TICKS);
+                AddScore(game, UFO_POINTS);
+                EmitEvent(game, EVENT_UFO_KILLED, 0);
+                goto next_collision_check; // Exit checks for this shot
+            }
+        }
+
+        // 3. Player Shot vs Shields
+        for (int i = 0; i < NUM_SHIELDS; i++) {
+            if (game->shields[i].active && CheckCollisionRecs(playerShotRect, game->shields[i].bounds)) {
+                Vector2 worldHit = { playerShotRect.x + playerShotRect.width*0.5f, playerShotRect.y }; // Top of bullet
+                Vector2 texHit = WorldToShieldTexCoords(game, i, worldHit);
+
+                if (GetShieldAlpha(game, i, texHit) > 10) { // Opaque pixel hit
+                    player->shotActive = false;
+                    DamageShield(game, i, worldHit);
+                    SpawnExplosion(game, worldHit, EXPLOSION_SHOT,
+                                   (Vector2){ SPRITE_SHOT_EXPLOSION_WIDTH*1.5f, SPRITE_SHOT_EXPLOSION_HEIGHT*1.5f });
+                    goto next_collision_check; // Exit shield loop and checks for this shot
+                }
+                // If transparent, bullet passes through
+            }
+        }
+    }
+
+next_collision_check: // Label used by goto to skip further checks for the same player shot
+
+    // --- Alien Shot Collisions ---
+
+    // 4. Alien Shots vs Player
+    if (!player->exploding) { // Player can only be hit if not already exploding
+        Rectangle playerRect = { player->position.x, player->position.y, player->size.x, player->size.y };
+        for (int i = 0; i < MAX_ALIEN_BULLETS; i++) {
+            if (game->alienBullets[i].active) {
+                Rectangle bulletRect = { game->alienBullets[i].position.x, game->alienBullets[i].position.y, game->alienBullets[i].size.x, game->alienBullets[i].size.y };
+                if (CheckCollisionRecs(bulletRect, playerRect)) {
+                    game->alienBullets[i].active = false;
+                    player->exploding = true;
+                    StartTimer(game, TIMER_PLAYER_RESPAWN, PLAYER_EXPLOSION_TICKS);
+                    EmitEvent(game, EVENT_PLAYER_KILLED, 0);
+                    // Lives are decremented in UpdateGameState when the timer fires
+                    break; // Player hit, no need to check other bullets against player this frame
+                }
+            }
+        }
+    }
+
+    // 5. Alien Shots vs Shields
+    for (int i = 0; i < MAX_ALIEN_BULLETS; i++) {
+        if (!game->alienBullets[i].active) continue; // Skip inactive bullets or bullets that just hit the player
+
+        Rectangle bulletRect = { game->alienBullets[i].position.x, game->alienBullets[i].position.y, game->alienBullets[i].size.x, game->alienBullets[i].size.y };
+        for (int s = 0; s < NUM_SHIELDS; s++) {
+            if (game->shields[s].active && CheckCollisionRecs(bulletRect, game->shields[s].bounds)) {
+                Vector2 worldHit = { bulletRect.x + bulletRect.width*0.5f, bulletRect.y + bulletRect.height }; // Bottom of bullet
+                Vector2 texHit = WorldToShieldTexCoords(game, s, worldHit);
+
+                if (GetShieldAlpha(game, s, texHit) > 10) { // Opaque pixel hit
+                    game->alienBullets[i].active = false; // Deactivate bullet
+                    DamageShield(game, s, worldHit);
+                    SpawnExplosion(game, worldHit, EXPLOSION_SHOT, // Use shot explosion for bullet hitting shield
+                                   (Vector2){ SPRITE_SHOT_EXPLOSION_WIDTH, SPRITE_SHOT_EXPLOSION_HEIGHT }); // Smaller explosion
+                    break; // Stop checking this bullet against other shields
+                }
+                // If transparent, bullet passes through
+            }
+        }
+    }
+}
+
+static void SpawnPlayerShot(Game *game)
+{
+    Player *player = &game->player;
+    if (!player->shotActive && !player->exploding) {
+        player->shotActive = true;
+        player->shotPosition.x = player->position.x + player->size.x/2 - player->shotSize.x/2;
+        player->shotPosition.y = player->position.y - player->shotSize.y;
+        EmitEvent(game, EVENT_PLAYER_SHOT, 0);
+    }
+}
+
+static void SpawnAlienShot(Game *game, Vector2 position)
+{
+    for (int i = 0; i < MAX_ALIEN_BULLETS; i++) {
+        if (!game->alienBullets[i].active) {
+            game->alienBullets[i].active = true;
+            game->alienBullets[i].position = position;
+            return; // Spawn only one
+        }
+    }
+}
+
+static void SpawnUFO(Game *game)
+{
+    UFO *ufo = &game->ufo;
+    ufo->active = true;
+    ufo->exploding = false;
+
+    // Random direction
+    if (GetRandomValueGame(game, 0, 1) == 0) { // From left
+        ufo->position = (Vector2){ -ufo->size.x, 50.0f };
+        ufo->speed = UFO_SPEED;
+    } else { // From right
+        ufo->position = (Vector2){ SCREEN_WIDTH, 50.0f };
+        ufo->speed = -UFO_SPEED;
+    }
+    EmitEvent(game, EVENT_UFO_SPAWN, 0); // Start sound
+}
+
+static void NextLevel(Game *game)
+{
+    if (game->currentWave < GAME_MAX_WAVE) game->currentWave++;
+    // Reset aliens (InitAliens makes later waves start faster)
+    InitAliens(game);
+    // Reset player position
+    game->player.position = (Vector2){ SCREEN_WIDTH/2.0f - game->player.size.x/2.0f, SCREEN_HEIGHT - game->player.size.y - 20.0f };
+    // Deactivate bullets
+    game->player.shotActive = false;
+    for (int i = 0; i < MAX_ALIEN_BULLETS; i++) game->alienBullets[i].active = false;
+    // Reset UFO spawn timer
+    ScheduleUFO(game);
+    // Reset shields (classic game keeps damage)
+    InitShields(game);
+}
+
+bool ReviveAlien(Game *game)
+{
+    // The formation moves as one block, any live alien gives its current offset and frame
+    const Alien *reference = NULL;
+    for (int i = 0; (i < NUM_ALIENS) && (reference == NULL); i++) {
+        if (game->aliens[i].active) reference = &game->aliens[i];
+    }
+    if ((reference == NULL) || (game->aliensAlive >= NUM_ALIENS) || game->gameOver) return false;
+
+    // Random dead slot, drawn from the game's own generator so both peers pick the same one
+    int pick = GetRandomValueGame(game, 0, NUM_ALIENS - game->aliensAlive - 1);
+    for (int i = 0; i < NUM_ALIENS; i++) {
+        Alien *alien = &game->aliens[i];
+        if (alien->active || (pick-- > 0)) continue;
+
+        alien->active = true;
+        alien->currentFrame = reference->currentFrame;
+        alien->position = (Vector2){ alien->basePosition.x + reference->position.x - reference->basePosition.x,
+                                     alien->basePosition.y + reference->position.y - reference->basePosition.y };
+        game->aliensAlive++;
+        EmitEvent(game, EVENT_ALIEN_REVIVED, i);
+        return true;
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition - Timers
+//----------------------------------------------------------------------------------
+// Level l holds the timers due 64^l to 64^(l+1) ticks ahead, in the slot of their due tick's
+// digit l (base 64). Each time the clock enters a new block of 64^l ticks, the matching slot of
+// level l is emptied into the levels below, so a timer reaches level 0 before its tick comes up.
+static void LinkTimer(GameTimers *timers, int timer, uint32_t now)
+{
+    uint32_t due = timers->due[timer];
+    uint32_t ahead = due - now;
+    int level = 0;
+    while ((level < GAME_TIMER_LEVELS - 1) && (ahead >= (1u << (TIMER_LEVEL_BITS*(level + 1))))) level++;
+
+    uint8_t *head = &timers->slots[level][(due >> (TIMER_LEVEL_BITS*level)) & (GAME_TIMER_SLOTS - 1)];
+    timers->next[timer] = *head;
+    *head = (uint8_t)(timer + 1);
+}
+
+// The level it sits on depends on when it was linked, so each level's candidate slot is searched
+static void UnlinkTimer(GameTimers *timers, int timer)
+{
+    uint32_t due = timers->due[timer];
+    for (int level = 0; level < GAME_TIMER_LEVELS; level++) {
+        uint8_t *link = &timers->slots[level][(due >> (TIMER_LEVEL_BITS*level)) & (GAME_TIMER_SLOTS - 1)];
+        while (*link != 0) {
+            if (*link == timer + 1) {
+                *link = timers->next[timer];
+                timers->next[timer] = 0;
+                return;
+            }
+            link = &timers->next[*link - 1];
+        }
+    }
+}
+
+// Fires ticks updates from now (the tick being simulated is now), replacing an earlier arming
+static void StartTimer(Game *game, GameTimer timer, int ticks)
+{
+    if (ticks < 1) ticks = 1;
+    if ((uint32_t)ticks > TIMER_MAX_TICKS) ticks = TIMER_MAX_TICKS;
+
+    StopTimer(game, timer);
+    game->timers.due[timer] = game->tick + ticks;
+    LinkTimer(&game->timers, timer, game->tick);
+}
+
+static void StopTimer(Game *game, GameTimer timer)
+{
+    if (game->timers.due[timer] == 0) return;
+    UnlinkTimer(&game->timers, timer);
+    game->timers.due[timer] = 0;
+}
+
+// Brings the wheel to game->tick: cascades the upper levels on block boundaries, then empties the
+// tick's level 0 slot. Returns a bit per timer that fired, they are disarmed.
+static uint32_t AdvanceTimers(Game *game)
+{
+    GameTimers *timers = &game->timers;
+    uint32_t now = game->tick;
+
+    for (int level = GAME_TIMER_LEVELS - 1; level > 0; level--) {
+        if ((now & ((1u << (TIMER_LEVEL_BITS*level)) - 1)) != 0) continue;
+
+        uint8_t *head = &timers->slots[level][(now >> (TIMER_LEVEL_BITS*level)) & (GAME_TIMER_SLOTS - 1)];
+        uint8_t link = *head;
+        *head = 0;
+        while (link != 0) {
+            int timer = link - 1;
+            link = timers->next[timer];
+            LinkTimer(timers, timer, now);
+        }
+    }
+
+    uint32_t fired = 0;
+    uint8_t *head = &timers->slots[0][now & (GAME_TIMER_SLOTS - 1)];
+    uint8_t link = *head;
+    *head = 0;
+    while (link != 0) {
+        int timer = link - 1;
+        link = timers->next[timer];
+        timers->next[timer] = 0;
+        timers->due[timer] = 0;
+        fired |= TIMER_BIT(timer);
+    }
+
+    return fired;
+}
+
+// Links every armed timer again, for a wheel whose slots were not copied along (LoadState)
+static bool RebuildTimers(Game *game)
+{
+    GameTimers *timers = &game->timers;
+    memset(timers->next, 0, sizeof(timers->next));
+    memset(timers->slots, 0, sizeof(timers->slots));
+
+    for (int i = 0; i < GAME_TIMER_COUNT; i++) {
+        if (timers->due[i] == 0) continue;
+        if ((timers->due[i] <= game->tick) || (timers->due[i] - game->tick > TIMER_MAX_TICKS)) return false;
+        LinkTimer(timers, i, game->tick);
+    }
+
+    return true;
+}
+
+int GameSecondsToTicks(float seconds)
+{
+    int ticks = (int)ceilf(seconds*GAME_TICK_RATE - 0.001f); // 0.3 s is 18 ticks, not 19 from rounding error
+    return (ticks < 1) ? 1 : ticks;
+}
+
+int GetGameTimerTicks(const Game *game, GameTimer timer)
+{
+    uint32_t due = game->timers.due[timer];
+    return (due != 0) ? (int)(due - game->tick) : 0;
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition - Invariants
+//----------------------------------------------------------------------------------
+static bool IsFiniteVec2(Vector2 v)
+{
+    return isfinite(v.x) && isfinite(v.y);
+}
+
+static bool IsTimerArmed(const Game *game, GameTimer timer)
+{
+    return (game->timers.due[timer] != 0);
+}
+
+const char *CheckGameState(const Game *game)
+{
+    // Counters agree with the objects
+    int alive = 0;
+    for (int i = 0; i < NUM_ALIENS; i++) alive += game->aliens[i].active ? 1 : 0;
+    if (game->aliensAlive != alive) return "aliensAlive differs from the live aliens";
+    if ((game->eventCount < 0) || (game->eventCount > GAME_MAX_EVENTS)) return "event count out of range";
+    if ((game->alienMoveSoundIndex < 0) || (game->alienMoveSoundIndex > 3)) return "march sound index out of range";
+    if ((game->alienDirection != 1) && (game->alienDirection != -1)) return "formation direction is not 1 or -1";
+    if ((game->currentWave < 1) || (game->currentWave > GAME_MAX_WAVE)) return "wave out of range";
+    if ((game->score < 0) || (game->score > GAME_MAX_SCORE)) return "score out of range";
+    if ((game->player.lives < 0) || (game->player.lives > GAME_START_LIVES)) return "lives out of range";
+    if (!game->gameOver && (game->player.lives < 1)) return "game running with no lives left";
+
+    // No NaN or infinity anywhere the update does arithmetic
+    const Player *player = &game->player;
+    if (!IsFiniteVec2(player->position) || (player->shotActive && !IsFiniteVec2(player->shotPosition))) return "player position not finite";
+    for (int i = 0; i < NUM_ALIENS; i++) {
+        if (game->aliens[i].active && !IsFiniteVec2(game->aliens[i].position)) return "alien position not finite";
+    }
+    for (int i = 0; i < MAX_ALIEN_BULLETS; i++) {
+        if (game->alienBullets[i].active && !IsFiniteVec2(game->alienBullets[i].position)) return "alien bullet position not finite";
+    }
+    if (game->ufo.active && (!IsFiniteVec2(game->ufo.position) || !isfinite(game->ufo.speed))) return "UFO position not finite";
+    for (int i = 0; i < MAX_EXPLOSIONS; i++) {
+        const Explosion *explosion = &game->explosions[i];
+        if (explosion->active && (!IsFiniteVec2(explosion->position) || !IsFiniteVec2(explosion->size))) return "explosion not finite";
+        if (explosion->active && (explosion->type != EXPLOSION_ALIEN) && (explosion->type != EXPLOSION_SHOT)) return "explosion type out of range";
+    }
+    if (!isfinite(game->alienMoveWaitTime) || (game->alienMoveWaitTime <= 0.0f) || (game->alienMoveWaitTime > 60.0f)) return "alien step time out of range";
+
+    // Pooled objects stay where the update retires them
+    if ((player->position.x < 0) || (player->position.x > SCREEN_WIDTH - player->size.x)) return "player off screen";
+    if (player->shotActive && (player->shotPosition.y + player->shotSize.y < 0)) return "player shot past the top";
+    for (int i = 0; i < MAX_ALIEN_BULLETS; i++) {
+        if (game->alienBullets[i].active && (game->alienBullets[i].position.y > SCREEN_HEIGHT)) return "alien bullet past the bottom";
+    }
+
+    // Every armed timer is linked exactly once and is still ahead, nothing else is linked
+    int links[GAME_TIMER_COUNT] = { 0 };
+    const uint8_t *heads = &game->timers.slots[0][0];
+    for (int slot = 0; slot < GAME_TIMER_LEVELS*GAME_TIMER_SLOTS; slot++) {
+        uint64_t group; // Almost every slot is empty, they are skipped eight at a time
+        if ((slot%8 == 0) && (slot + 8 <= GAME_TIMER_LEVELS*GAME_TIMER_SLOTS)) {
+            memcpy(&group, heads + slot, sizeof(group));
+            if (group == 0) { slot += 7; continue; }
+        }
+        int steps = 0;
+        for (int link = heads[slot]; link != 0; link = game->timers.next[link - 1]) {
+            if ((link > GAME_TIMER_COUNT) || (++steps > GAME_TIMER_COUNT)) return "timer wheel list corrupt";
+            links[link - 1]++;
+        }
+    }
+    for (int i = 0; i < GAME_TIMER_COUNT; i++) {
+        uint32_t due = game->timers.due[i];
+        if (links[i] != ((due != 0) ? 1 : 0)) return "timer linked a wrong number of times";
+        if ((due != 0) && ((due <= game->tick) || (due - game->tick > TIMER_MAX_TICKS))) return "timer due out of range";
+    }
+
+    // Timers and the state they end agree
+    if (!IsTimerArmed(game, TIMER_ALIEN_STEP)) return "formation step not scheduled";
+    if ((game->aliensAlive > 0) && !IsTimerArmed(game, TIMER_ALIEN_SHOT)) return "alien shot not scheduled";
+    if (game->ufo.active == IsTimerArmed(game, TIMER_UFO_SPAWN)) return "UFO spawn timer disagrees with the UFO";
+    if (game->ufo.exploding != IsTimerArmed(game, TIMER_UFO_EXPLOSION)) return "UFO explosion timer disagrees with the UFO";
+    if (game->ufo.exploding && !game->ufo.active) return "inactive UFO exploding";
+    if (player->exploding != IsTimerArmed(game, TIMER_PLAYER_RESPAWN)) return "respawn timer disagrees with the player";
+    for (int i = 0; i < MAX_EXPLOSIONS; i++) {
+        if (game->explosions[i].active != IsTimerArmed(game, TIMER_EXPLOSION + i)) return "explosion timer disagrees with its slot";
+    }
+
+    return NULL;
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition - State serialization
+//----------------------------------------------------------------------------------
+// Blob layout (all little-endian):
+//   header:  u32 magic "INVS", u16 version, u16 reserved, u32 payload size
+//   payload: globals, player, aliens (alive mask + live positions), bullets (active mask +
+//            positions), shields (RLE alpha), UFO, explosions (active mask + fields), due tick
+//            of every timer
+//   trailer: u32 FNV-1a of the payload
+typedef struct StateWriter {
+    unsigned char *data;
+    int size;
+    int capacity;
+    bool overflow;
+} StateWriter;
+
+typedef struct StateReader {
+    const unsigned char *data;
+    int size;
+    int offset;
+    bool overflow;
+} StateReader;
+
+static void WriteBytes(StateWriter *w, const void *src, int count)
+{
+    if (w->overflow || w->size + count > w->capacity) { w->overflow = true; return; }
+    memcpy(w->data + w->size, src, count);
+    w->size += count;
+}
+
+static void WriteU8(StateWriter *w, unsigned int value) { unsigned char b = (unsigned char)value; WriteBytes(w, &b, 1); }
+static void WriteU16(StateWriter *w, unsigned int value) { unsigned char b[2] = { value & 0xFF, (value >> 8) & 0xFF }; WriteBytes(w, b, 2); }
+static void WriteU32(StateWriter *w, uint32_t value)
+{
+    unsigned char b[4] = { value & 0xFF, (value >> 8) & 0xFF, (value >> 16) & 0xFF, (value >> 24) & 0xFF };
+    WriteBytes(w, b, 4);
+}
+static void WriteU64(StateWriter *w, uint64_t value) { WriteU32(w, (uint32_t)value); WriteU32(w, (uint32_t)(value >> 32)); }
+static void WriteI32(StateWriter *w, int value) { WriteU32(w, (uint32_t)value); }
+static void WriteF32(StateWriter *w, float value) { uint32_t bits; memcpy(&bits, &value, 4); WriteU32(w, bits); }
+static void WriteVec2(StateWriter *w, Vector2 v) { WriteF32(w, v.x); WriteF32(w, v.y); }
+
+static const unsigned char *ReadBytes(StateReader *r, int count)
+{
+    if (r->overflow || r->offset + count > r->size) { r->overflow = true; return NULL; }
+    const unsigned char *ptr = r->data + r->offset;
+    r->offset += count;
+    return ptr;
+}
+
+static unsigned int ReadU8(StateReader *r) { const unsigned char *b = ReadBytes(r, 1); return b ? b[0] : 0; }
+static unsigned int ReadU16(StateReader *r) { const unsigned char *b = ReadBytes(r, 2); return b ? (b[0] | (b[1] << 8)) : 0; }
+static uint32_t ReadU32(StateReader *r)
+{
+    const unsigned char *b = ReadBytes(r, 4);
+    return b ? ((uint32_t)b[0] | ((uint32_t)b[1] << 8) | ((uint32_t)b[2] << 16) | ((uint32_t)b[3] << 24)) : 0;
+}
+static uint64_t ReadU64(StateReader *r) { uint64_t lo = ReadU32(r); return lo | ((uint64_t)ReadU32(r) << 32); }
+static int ReadI32(StateReader *r) { return (int)ReadU32(r); }
+static float ReadF32(StateReader *r) { uint32_t bits = ReadU32(r); float value; memcpy(&value, &bits, 4); return value; }
+static Vector2 ReadVec2(StateReader *r) { Vector2 v; v.x = ReadF32(r); v.y = ReadF32(r); return v; }
+
+static uint32_t HashFNV1a(const unsigned char *data, int size)
+{
+    uint32_t hash = 2166136261u;
+    for (int i = 0; i < size; i++) hash = (hash ^ data[i])*16777619u;
+    return hash;
+}
+
+// Runs of (count, alpha) pairs over the whole bitmap; holes and solid areas collapse to few bytes
+static void WriteShieldRLE(StateWriter *w, const unsigned char *alpha, int count)
+{
+    int sizeOffset = w->size;
+    WriteU16(w, 0); // Patched below with the encoded byte count
+
+    int start = w->size;
+    for (int i = 0; i < count;) {
+        int run = 1;
+        while ((i + run < count) && (run < 255) && (alpha[i + run] == alpha[i])) run++;
+        WriteU8(w, run);
+        WriteU8(w, alpha[i]);
+        i += run;
+    }
+
+    if (!w->overflow) {
+        int encoded = w->size - start;
+        w->data[sizeOffset] = encoded & 0xFF;
+        w->data[sizeOffset + 1] = (encoded >> 8) & 0xFF;
+    }
+}
+
+static bool ReadShieldRLE(StateReader *r, unsigned char *alpha, int count)
+{
+    int encoded = ReadU16(r);
+    const unsigned char *runs = ReadBytes(r, encoded);
+    if (runs == NULL || (encoded%2) != 0) return false;
+
+    int filled = 0;
+    for (int i = 0; i < encoded; i += 2) {
+        int run = runs[i];
+        if (run == 0 || filled + run > count) return false;
+        memset(alpha + filled, runs[i + 1], run);
+        filled += run;
+    }
+    return (filled == count);
+}
+
+int SaveState(const Game *game, unsigned char *buffer, int capacity)
+{
+    StateWriter w = { buffer, 0, capacity, false };
+
+    WriteU32(&w, STATE_MAGIC);
+    WriteU16(&w, GAME_STATE_VERSION);
+    WriteU16(&w, 0);
+    WriteU32(&w, 0); // Payload size, patched below
+
+    // Globals
+    WriteU32(&w, game->tick);
+    WriteU64(&w, game->rngState);
+    WriteU8(&w, (game->gameOver ? 1 : 0) | (game->moveDown ? 2 : 0));
+    WriteI32(&w, game->score);
+    WriteI32(&w, game->currentWave);
+    WriteI32(&w, game->aliensAlive);
+    WriteI32(&w, game->alienDirection);
+    WriteI32(&w, game->alienMoveSoundIndex);
+    WriteF32(&w, game->alienMoveWaitTime);
+
+    // Player
+    WriteVec2(&w, game->player.position);
+    WriteI32(&w, game->player.lives);
+    WriteU8(&w, game->player.shotActive);
+    WriteVec2(&w, game->player.shotPosition);
+    WriteU8(&w, game->player.exploding);
+
+    // Aliens: dead aliens never move or collide, so only live positions are stored
+    uint64_t aliveMask = 0, frameMask = 0;
+    for (int i = 0; i < NUM_ALIENS; i++) {
+        if (game->aliens[i].active) aliveMask |= 1ULL << i;
+        if (game->aliens[i].currentFrame) frameMask |= 1ULL << i;
+    }
+    WriteU64(&w, aliveMask);
+    WriteU64(&w, frameMask);
+    for (int i = 0; i < NUM_ALIENS; i++) {
+        if (game->aliens[i].active) WriteVec2(&w, game->aliens[i].position);
+    }
+
+    // Alien bullets
+    unsigned int bulletMask = 0;
+    for (int i = 0; i < MAX_ALIEN_BULLETS; i++) if (game->alienBullets[i].active) bulletMask |= 1u << i;
+    WriteU16(&w, bulletMask);
+    for (int i = 0; i < MAX_ALIEN_BULLETS; i++) {
+        if (game->alienBullets[i].active) WriteVec2(&w, game->alienBullets[i].position);
+    }
+
+    // Shields
+    for (int i = 0; i < NUM_SHIELDS; i++) {
+        WriteU8(&w, game->shields[i].active);
+        WriteShieldRLE(&w, &game->shields[i].alpha[0][0], SHIELD_TEX_WIDTH*SHIELD_TEX_HEIGHT);
+    }
+
+    // UFO
+    WriteU8(&w, (game->ufo.active ? 1 : 0) | (game->ufo.exploding ? 2 : 0));
+    WriteVec2(&w, game->ufo.position);
+    WriteF32(&w, game->ufo.speed);
+
+    // Explosions
+    unsigned int explosionMask = 0;
+    for (int i = 0; i < MAX_EXPLOSIONS; i++) if (game->explosions[i].active) explosionMask |= 1u << i;
+    WriteU16(&w, explosionMask);
+    for (int i = 0; i < MAX_EXPLOSIONS; i++) {
+        if (game->explosions[i].active) {
+            WriteU8(&w, game->explosions[i].type);
+            WriteVec2(&w, game->explosions[i].position);
+            WriteVec2(&w, game->explosions[i].size);
+        }
+    }
+
+    // Timers: due ticks only, the wheel is rebuilt from them
+    for (int i = 0; i < GAME_TIMER_COUNT; i++) WriteU32(&w, game->timers.due[i]);
+
+    WriteU32(&w, 0); // Checksum, written by SealState()
+    if (w.overflow) return 0;
+
+    SealState(buffer, w.size);
+    return w.size;
+}
+
+bool SealState(unsigned char *data, int size)
+{
+    if (size < STATE_HEADER_SIZE + 4) return false;
+
+    int payloadSize = size - STATE_HEADER_SIZE - 4;
+    StateWriter header = { data + 8, 0, 4, false };
+    WriteU32(&header, (uint32_t)payloadSize);
+    StateWriter trailer = { data + STATE_HEADER_SIZE + payloadSize, 0, 4, false };
+    WriteU32(&trailer, HashFNV1a(data + STATE_HEADER_SIZE, payloadSize));
+    return true;
+}
+
+bool LoadState(Game *game, const unsigned char *data, int size)
+{
+    StateReader r = { data, size, 0, false };
+
+    if (ReadU32(&r) != STATE_MAGIC) return false;
+    if (ReadU16(&r) != GAME_STATE_VERSION) return false;
+    ReadU16(&r);
+    int payloadSize = (int)ReadU32(&r);
+    if (r.overflow || payloadSize < 0 || STATE_HEADER_SIZE + payloadSize + 4 > size) return false;
+
+    StateReader check = { data + STATE_HEADER_SIZE + payloadSize, 4, 0, false };
+    if (ReadU32(&check) != HashFNV1a(data + STATE_HEADER_SIZE, payloadSize)) return false;
+    r.size = STATE_HEADER_SIZE + payloadSize;
+
+    // Decode into a copy so a malformed blob never leaves the live game half-written
+    Game loaded = { 0 };
+    loaded.tuning = game->tuning;
+    InitPlayer(&loaded);
+    SetupAlienGrid(&loaded);
+    SetupShieldLayout(&loaded);
+    loaded.ufo.size = (Vector2){ SPRITE_UFO_WIDTH*1.5f, SPRITE_UFO_HEIGHT*1.5f };
+    for (int i = 0; i < MAX_ALIEN_BULLETS; i++) {
+        loaded.alienBullets[i].size = (Vector2){ SPRITE_ALIEN_SHOT_WIDTH*1.5f, SPRITE_ALIEN_SHOT_HEIGHT*1.5f };
+        loaded.alienBullets[i].speed = loaded.tuning.alienBulletSpeed;
+    }
+
+    loaded.tick = ReadU32(&r);
+    loaded.rngState = ReadU64(&r);
+    unsigned int flags = ReadU8(&r);
+    loaded.gameOver = (flags & 1) != 0;
+    loaded.moveDown = (flags & 2) != 0;
+    loaded.score = ReadI32(&r);
+    loaded.currentWave = ReadI32(&r);
+    loaded.aliensAlive = ReadI32(&r);
+    loaded.alienDirection = ReadI32(&r);
+    loaded.alienMoveSoundIndex = ReadI32(&r);
+    loaded.alienMoveWaitTime = ReadF32(&r);
+
+    loaded.player.position = ReadVec2(&r);
+    loaded.player.lives = ReadI32(&r);
+    loaded.player.shotActive = ReadU8(&r) != 0;
+    loaded.player.shotPosition = ReadVec2(&r);
+    loaded.player.exploding = ReadU8(&r) != 0;
+
+    uint64_t aliveMask = ReadU64(&r);
+    uint64_t frameMask = ReadU64(&r);
+    for (int i = 0; i < NUM_ALIENS; i++) {
+        loaded.aliens[i].active = (aliveMask >> i) & 1;
+        loaded.aliens[i].currentFrame = (frameMask >> i) & 1;
+        loaded.aliens[i].position = loaded.aliens[i].active ? ReadVec2(&r) : loaded.aliens[i].basePosition;
+    }
+
+    unsigned int bulletMask = ReadU16(&r);
+    for (int i = 0; i < MAX_ALIEN_BULLETS; i++) {
+        loaded.alienBullets[i].active = (bulletMask >> i) & 1;
+        if (loaded.alienBullets[i].active) loaded.alienBullets[i].position = ReadVec2(&r);
+    }
+
+    for (int i = 0; i < NUM_SHIELDS; i++) {
+        loaded.shields[i].active = ReadU8(&r) != 0;
+        if (!ReadShieldRLE(&r, &loaded.shields[i].alpha[0][0], SHIELD_TEX_WIDTH*SHIELD_TEX_HEIGHT)) return false;
+    }
+
+    flags = ReadU8(&r);
+    loaded.ufo.active = (flags & 1) != 0;
+    loaded.ufo.exploding = (flags & 2) != 0;
+    loaded.ufo.position = ReadVec2(&r);
+    loaded.ufo.speed = ReadF32(&r);
+
+    unsigned int explosionMask = ReadU16(&r);
+    for (int i = 0; i < MAX_EXPLOSIONS; i++) {
+        loaded.explosions[i].active = (explosionMask >> i) & 1;
+        if (loaded.explosions[i].active) {
+            loaded.explosions[i].type = (ExplosionType)ReadU8(&r);
+            loaded.explosions[i].position = ReadVec2(&r);
+            loaded.explosions[i].size = ReadVec2(&r);
+        }
+    }
+
+    for (int i = 0; i < GAME_TIMER_COUNT; i++) loaded.timers.due[i] = ReadU32(&r);
+
+    if (r.overflow || r.offset != r.size) return false;
+    if (loaded.aliensAlive < 0 || loaded.aliensAlive > NUM_ALIENS) return false;
+    if (loaded.currentWave < 1 || loaded.currentWave > GAME_MAX_WAVE) return false;
+    if (loaded.score < 0 || loaded.score > GAME_MAX_SCORE) return false;
+    if (loaded.player.lives < 0 || loaded.player.lives > GAME_START_LIVES) return false;
+    if (!RebuildTimers(&loaded) || (CheckGameState(&loaded) != NULL)) return false;
+
+    // Shields were all marked dirty by SetupShieldLayout(), so the renderer re-uploads them
+    *game = loaded;
+    return true;
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition - State hashing
+//----------------------------------------------------------------------------------
+#define HASH_SEED               0x9E3779B97F4A7C15ULL
+#define HASH_FIELD(h, field)    (h) = HashBytes((h), &(field), sizeof(field))
+
+static const char *subsystemNames[SUBSYSTEM_COUNT] = {
+    "globals", "prng", "player", "aliens", "bullets", "shields", "ufo", "explosions"
+};
+
+// Word-at-a-time multiply/xorshift mix; bytes are assembled little-endian so the
+// result does not depend on the host
+static uint64_t HashBytes(uint64_t h, const void *data, size_t size)
+{
+    const unsigned char *bytes = (const unsigned char *)data;
+
+    while (size > 0) {
+        size_t n = (size < 8) ? size : 8;
+        uint64_t k = 0;
+        for (size_t i = 0; i < n; i++) k |= (uint64_t)bytes[i] << (8*i);
+
+        h = (h ^ k)*0xBF58476D1CE4E5B9ULL;
+        h ^= h >> 31;
+        bytes += n;
+        size -= n;
+    }
+
+    return h;
+}
+
+static uint64_t HashVec2(uint64_t h, Vector2 v)
+{
+    HASH_FIELD(h, v.x);
+    HASH_FIELD(h, v.y);
+    return h;
+}
+
+GameHash HashGameState(const Game *game)
+{
+    GameHash hash = { 0 };
+    uint64_t h;
+
+    h = HASH_SEED;
+    HASH_FIELD(h, game->tick);
+    HASH_FIELD(h, game->gameOver);
+    HASH_FIELD(h, game->score);
+    HASH_FIELD(h, game->currentWave);
+    HASH_FIELD(h, game->aliensAlive);
+    HASH_FIELD(h, game->alienMoveWaitTime);
+    HASH_FIELD(h, game->alienDirection);
+    HASH_FIELD(h, game->moveDown);
+    HASH_FIELD(h, game->alienMoveSoundIndex);
+    // Timers by due tick only, where one sits in the wheel depends on when it was linked
+    HASH_FIELD(h, game->timers.due[TIMER_ALIEN_STEP]);
+    HASH_FIELD(h, game->timers.due[TIMER_ALIEN_SHOT]);
+    hash.subsystem[SUBSYSTEM_GLOBALS] = h;
+
+    h = HASH_SEED;
+    HASH_FIELD(h, game->rngState);
+    hash.subsystem[SUBSYSTEM_PRNG] = h;
+
+    const Player *player = &game->player;
+    h = HashVec2(HASH_SEED, player->position);
+    HASH_FIELD(h, player->lives);
+    HASH_FIELD(h, player->shotActive);
+    h = HashVec2(h, player->shotPosition);
+    HASH_FIELD(h, player->exploding);
+    HASH_FIELD(h, game->timers.due[TIMER_PLAYER_RESPAWN]);
+    hash.subsystem[SUBSYSTEM_PLAYER] = h;
+
+    h = HASH_SEED;
+    for (int i = 0; i < NUM_ALIENS; i++) {
+        const Alien *alien = &game->aliens[i];
+        HASH_FIELD(h, alien->active);
+        HASH_FIELD(h, alien->currentFrame);
+        if (alien->active) h = HashVec2(h, alien->position);
+    }
+    hash.subsystem[SUBSYSTEM_ALIENS] = h;
+
+    h = HASH_SEED;
+    for (int i = 0; i < MAX_ALIEN_BULLETS; i++) {
+        HASH_FIELD(h, game->alienBullets[i].active);
+        if (game->alienBullets[i].active) h = HashVec2(h, game->alienBullets[i].position);
+    }
+    hash.subsystem[SUBSYSTEM_BULLETS] = h;
+
+    h = HASH_SEED;
+    for (int i = 0; i < NUM_SHIELDS; i++) {
+        HASH_FIELD(h, game->shields[i].active);
+        HASH_FIELD(h, game->shields[i].alpha);
+    }
+    hash.subsystem[SUBSYSTEM_SHIELDS] = h;
+
+    const UFO *ufo = &game->ufo;
+    h = HashVec2(HASH_SEED, ufo->position);
+    HASH_FIELD(h, ufo->active);
+    HASH_FIELD(h, ufo->speed);
+    HASH_FIELD(h, ufo->exploding);
+    HASH_FIELD(h, game->timers.due[TIMER_UFO_SPAWN]);
+    HASH_FIELD(h, game->timers.due[TIMER_UFO_EXPLOSION]);
+    hash.subsystem[SUBSYSTEM_UFO] = h;
+
+    h = HASH_SEED;
+    for (int i = 0; i < MAX_EXPLOSIONS; i++) {
+        const Explosion *explosion = &game->explosions[i];
+        HASH_FIELD(h, explosion->active);
+        if (!explosion->active) continue;
+        HASH_FIELD(h, explosion->type);
+        h = HashVec2(h, explosion->position);
+        h = HashVec2(h, explosion->size);
+        HASH_FIELD(h, game->timers.due[TIMER_EXPLOSION + i]);
+    }
+    hash.subsystem[SUBSYSTEM_EXPLOSIONS] = h;
+
+    hash.total = HASH_SEED;
+    for (int i = 0; i < SUBSYSTEM_COUNT; i++) HASH_FIELD(hash.total, hash.subsystem[i]);
+
+    return hash;
+}
+
+const char *GetSubsystemName(GameSubsystem subsystem)
+{
+    return ((subsystem >= 0) && (subsystem < SUBSYSTEM_COUNT)) ? subsystemNames[subsystem] : "unknown";
+}
@@ -0,0 +1,281 @@
+#ifndef GAME_H
+#define GAME_H
+
+// Headless simulation core: everything UpdateGame() mutates lives in one Game struct with no
+// pointers, textures or sounds, so it can be stepped without a window, copied with memcpy and
+// serialized with SaveState()/LoadState(). Include raylib.h first when both are needed.
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h> // For offsetof()
+
+// Same layout as raylib's types, only defined when raylib.h has not been included
+#if !defined(RL_VECTOR2_TYPE)
+typedef struct Vector2 {
+    float x;
+    float y;
+} Vector2;
+#define RL_VECTOR2_TYPE
+#endif
+
+#if !defined(RL_RECTANGLE_TYPE)
+typedef struct Rectangle {
+    float x;
+    float y;
+    float width;
+    float height;
+} Rectangle;
+#define RL_RECTANGLE_TYPE
+#endif
+
+//----------------------------------------------------------------------------------
+// Defines
+//----------------------------------------------------------------------------------
+#define SCREEN_WIDTH            800
+#define SCREEN_HEIGHT           600
+
+#define ALIENS_ROWS             5
+#define ALIENS_COLS             11
+#define NUM_ALIENS              (ALIENS_ROWS * ALIENS_COLS)
+#define MAX_ALIEN_BULLETS       10 // Max simultaneous alien bullets
+
+#define NUM_SHIELDS             4
+#define MAX_EXPLOSIONS          10
+#define GAME_MAX_EVENTS         32 // Events one update can emit (sounds, spawns)
+#define GAME_START_LIVES        3
+#define GAME_MAX_SCORE          999999999 // Score and wave stop here, far from int overflow
+#define GAME_MAX_WAVE           999999
+
+// Pixel sizes of the sprites in resources/, the simulation uses them scaled like the renderer
+#define SPRITE_ALIEN_WIDTH              16
+#define SPRITE_ALIEN_HEIGHT             8
+#define SPRITE_PLAYER_WIDTH             16
+#define SPRITE_PLAYER_HEIGHT            8
+#define SPRITE_PLAYER_SHOT_WIDTH        1
+#define SPRITE_PLAYER_SHOT_HEIGHT       8
+#define SPRITE_ALIEN_SHOT_WIDTH         3
+#define SPRITE_ALIEN_SHOT_HEIGHT        8
+#define SPRITE_UFO_WIDTH                24
+#define SPRITE_UFO_HEIGHT               8
+#define SPRITE_ALIEN_EXPLOSION_WIDTH    16
+#define SPRITE_ALIEN_EXPLOSION_HEIGHT   8
+#define SPRITE_SHOT_EXPLOSION_WIDTH     8
+#define SPRITE_SHOT_EXPLOSION_HEIGHT    8
+#define SHIELD_TEX_WIDTH                22
+#define SHIELD_TEX_HEIGHT               16
+
+// Distances covered per tick (alien steps: per formation move)
+#define PLAYER_SPEED            5.0f
+#define PLAYER_BULLET_SPEED     7.0f
+#define ALIEN_BULLET_SPEED      4.0f
+#define ALIEN_HORIZONTAL_MOVE   3.0f
+#define ALIEN_VERTICAL_MOVE     2.0f
+
+#define GAME_TICK_RATE          60 // Fixed simulation rate, replays and hashes assume it
+#define GAME_TICK_TIME          (1.0f/GAME_TICK_RATE)
+
+#define GAME_TIMER_SLOTS        64 // Wheel slots per level, level 0 slots are one tick apart
+#define GAME_TIMER_LEVELS       3 // Each level covers GAME_TIMER_SLOTS times the one below, 64^3 ticks is over an hour
+
+#define GAME_STATE_VERSION      3 // 2: shield rows top first, 3: timers in whole ticks
+#define GAME_STATE_MAX_SIZE     4096 // Upper bound of a SaveState() blob
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef enum AlienType { ALIEN_TYPE_1 = 0, ALIEN_TYPE_2, ALIEN_TYPE_3 } AlienType; // Type 3 top, Type 1 bottom
+typedef enum ExplosionType { EXPLOSION_ALIEN = 0, EXPLOSION_SHOT } ExplosionType;
+
+typedef enum GameEventType {
+    EVENT_PLAYER_SHOT = 0,  // Player fired
+    EVENT_ALIEN_KILLED,     // Player shot hit an alien
+    EVENT_PLAYER_KILLED,    // Alien shot hit the player
+    EVENT_ALIEN_STEP,       // Formation moved, param = march sound index (0..3)
+    EVENT_UFO_SPAWN,        // UFO entered the screen
+    EVENT_UFO_GONE,         // UFO left the screen
+    EVENT_UFO_KILLED,       // Player shot hit the UFO
+    EVENT_INVASION,         // Aliens reached the player line, game over
+    EVENT_ALIEN_REVIVED     // Versus: the opponent sent an alien, param = index
+} GameEventType;
+
+typedef enum GameSubsystem {
+    SUBSYSTEM_GLOBALS = 0,  // Tick, score, wave, formation timers and direction
+    SUBSYSTEM_PRNG,
+    SUBSYSTEM_PLAYER,
+    SUBSYSTEM_ALIENS,
+    SUBSYSTEM_BULLETS,      // Alien bullets (the player shot belongs to the player)
+    SUBSYSTEM_SHIELDS,
+    SUBSYSTEM_UFO,
+    SUBSYSTEM_EXPLOSIONS,
+    SUBSYSTEM_COUNT
+} GameSubsystem;
+
+// Everything that happens some time from now. Armed timers sit in a hierarchical timer wheel, so
+// an update only visits the slot of the current tick (and every 64 ticks one slot of the level
+// above): the cost follows the timers firing, not the timers armed
+typedef enum GameTimer {
+    TIMER_ALIEN_STEP = 0,   // Formation moves one step
+    TIMER_ALIEN_SHOT,       // A random live alien fires
+    TIMER_UFO_SPAWN,        // UFO enters the screen
+    TIMER_UFO_EXPLOSION,    // Exploding UFO is removed
+    TIMER_PLAYER_RESPAWN,   // Exploding player loses the life: respawns or the game ends
+    TIMER_EXPLOSION,        // Explosion slot i expires on TIMER_EXPLOSION + i
+    GAME_TIMER_COUNT = TIMER_EXPLOSION + MAX_EXPLOSIONS
+} GameTimer;
+
+typedef struct GameHash {
+    uint64_t total;                         // Combination of all subsystem hashes
+    uint64_t subsystem[SUBSYSTEM_COUNT];
+} GameHash;
+
+typedef struct GameEvent {
+    GameEventType type;
+    int param;
+} GameEvent;
+
+typedef struct GameInput {
+    bool left;
+    bool right;
+    bool fire;
+} GameInput;
+
+typedef struct Player {
+    Vector2 position;
+    Vector2 size;          // Scaled size for drawing/collision
+    int lives;
+    bool shotActive;
+    Vector2 shotPosition;
+    Vector2 shotSize;
+    bool exploding;        // Hit, no control until TIMER_PLAYER_RESPAWN fires
+} Player;
+
+typedef struct Alien {
+    Vector2 position;
+    Vector2 basePosition;  // Original grid position
+    AlienType type;
+    Vector2 size;
+    bool active;
+    bool currentFrame;     // false = frame 1, true = frame 2
+    int points;
+} Alien;
+
+typedef struct Bullet {
+    Vector2 position;
+    bool active;
+    float speed;
+    Vector2 size;
+} Bullet;
+
+typedef struct Shield {
+    Vector2 position;
+    bool active;
+    Rectangle bounds;
+    unsigned char alpha[SHIELD_TEX_HEIGHT][SHIELD_TEX_WIDTH]; // Occupancy, top row first; the renderer uploads it as is
+} Shield;
+
+typedef struct UFO {
+    Vector2 position;
+    Vector2 size;
+    bool active;
+    float speed;
+    bool exploding;        // Hit, removed when TIMER_UFO_EXPLOSION fires
+} UFO;
+
+typedef struct Explosion {
+    Vector2 position;
+    ExplosionType type;
+    Vector2 size;
+    bool active;           // Until its TIMER_EXPLOSION slot fires
+} Explosion;
+
+// Rules that used to be hand-tuned constants. Each game carries its own copy, so games with
+// different rules can run side by side (see tuning.h for the text format and sweep.c)
+typedef struct GameTuning {
+    float alienStepTimeStart;       // Seconds between formation steps at the start of wave 1
+    float waveSpeedup;              // Wave w starts stepping alienStepTimeStart/(1 + (w - 1)*waveSpeedup)
+    float alienSpeedupFactor;       // Step time multiplier applied per alien killed
+    float alienShootIntervalMin;    // Seconds between alien shots, drawn between min and max...
+    float alienShootIntervalMax;    // ...then scaled down to half as the formation empties
+    float alienBulletSpeed;         // Pixels per tick
+} GameTuning;
+
+// Pointer free like the rest of Game: lists are linked by timer index + 1, 0 ends a list
+typedef struct GameTimers {
+    uint32_t due[GAME_TIMER_COUNT];                     // Tick the timer fires on, 0 when not armed
+    uint8_t next[GAME_TIMER_COUNT];                     // Next timer in the same slot
+    uint8_t slots[GAME_TIMER_LEVELS][GAME_TIMER_SLOTS]; // First timer of each slot
+} GameTimers;
+
+typedef struct ShieldDirty {
+    int x0, y0, x1, y1;    // Inclusive texel rectangle changed since last cleared, empty when x0 > x1
+} ShieldDirty;
+
+typedef struct Game {
+    uint32_t tick;         // Updates simulated since InitGameState()
+    uint64_t rngState;
+    bool gameOver;
+    int score;
+    int currentWave;
+
+    Player player;
+    Alien aliens[NUM_ALIENS];
+    Bullet alienBullets[MAX_ALIEN_BULLETS];
+    Shield shields[NUM_SHIELDS];
+    UFO ufo;
+    Explosion explosions[MAX_EXPLOSIONS];
+
+    int aliensAlive;
+    float alienMoveWaitTime; // Seconds between formation steps, shortens as aliens die
+    int alienDirection;    // 1 = right, -1 = left
+    bool moveDown;         // Flag for aliens to move down
+    int alienMoveSoundIndex; // 0 to 3 for the fastinvader sounds
+    GameTimers timers;
+
+    // Outputs of the last update, not part of the saved state
+    GameEvent events[GAME_MAX_EVENTS];
+    int eventCount;
+    ShieldDirty shieldDirty[NUM_SHIELDS];
+
+    // Set by InitGameState(), kept by LoadState(); neither saved nor hashed
+    GameTuning tuning;
+} Game;
+
+// Leading bytes of Game that hold the simulation state, the outputs above are excluded
+#define GAME_STATE_BYTES        offsetof(Game, events)
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+void InitGameState(Game *game, uint64_t seed);                  // New game, wave 1, process-wide tuning
+void InitGameStateTuned(Game *game, uint64_t seed, const GameTuning *tuning); // Same, with its own rules
+GameTuning GetDefaultGameTuning(void);                          // Built-in rules
+void SetGameTuning(const GameTuning *tuning);                   // Rules InitGameState() uses, set at startup (NULL: built-in)
+GameTuning GetGameTuning(void);
+void UpdateGameState(Game *game, GameInput input);              // Simulate one tick (GAME_TICK_TIME)
+void ClearShieldDirty(Game *game, int shieldIndex);             // Renderer consumed the damaged area
+void InvalidateShields(Game *game);                             // Mark every shield texel for re-upload
+bool IsShieldSolid(const Game *game, int shieldIndex, Vector2 worldPos); // The texel test shots use, clamped to the shield
+int GameSecondsToTicks(float seconds);                          // Whole ticks a duration lasts, at least one
+int GetGameTimerTicks(const Game *game, GameTimer timer);        // Updates until it fires (1: the next one), 0 when not armed
+bool ReviveAlien(Game *game);                                   // Versus: a dead alien rejoins the formation
+uint8_t PackGameInput(GameInput input);                         // One byte per tick for replays and the network
+GameInput UnpackGameInput(uint8_t bits);
+
+// 64-bit hash of the simulation state, field by field so struct padding never leaks in, and
+// skipping fields of inactive objects so a LoadState() round trip hashes the same. The result
+// is host independent; used to check determinism.
+GameHash HashGameState(const Game *game);
+const char *GetSubsystemName(GameSubsystem subsystem);
+
+// Invariants the update keeps (counters, finite positions, pools, timer wheel), NULL when they all
+// hold, otherwise what is broken. LoadState() refuses blobs that fail it; the fuzzer checks every tick.
+const char *CheckGameState(const Game *game);
+
+// Versioned binary snapshot (little-endian, RLE-compressed shields, checksummed).
+// SaveState returns the blob size, or 0 when capacity is too small (GAME_STATE_MAX_SIZE always fits).
+// LoadState leaves the game untouched and returns false on a corrupt or incompatible blob.
+int SaveState(const Game *game, unsigned char *buffer, int capacity);
+bool LoadState(Game *game, const unsigned char *data, int size);
+bool SealState(unsigned char *data, int size);  // Rewrites size and checksum of an edited blob, false when too short for them
+
+#endif // GAME_H
@@ -0,0 +1,124 @@
+#include "raylib.h"
+#include "hud.h"
+#include "game.h"
+#include "ledger.h"
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef enum HudScreen { HUD_SCREEN_NONE = 0, HUD_SCREEN_TITLE, HUD_SCREEN_GAME_OVER } HudScreen;
+
+//------------------------------------------------------------------------------------
+// Global Variables Declaration
+//------------------------------------------------------------------------------------
+static Texture2D lifeTexture = { 0 };
+static HudStats stats = { 0 };
+
+static RenderTexture2D statusTarget = { 0 };    // SCREEN_WIDTH x 2*HUD_STRIP_HEIGHT: top row, then bottom row
+static int statusKey[4] = { 0 };                // Score, hi-score, wave, lives it shows
+static bool statusValid = false;
+
+static RenderTexture2D screenTarget = { 0 };    // Whole window
+static HudScreen screenKind = HUD_SCREEN_NONE;
+static int screenScore = 0;
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+void LoadHud(Texture2D lifeIcon)
+{
+    lifeTexture = lifeIcon;
+    statusTarget = LoadRenderTextureTracked(SCREEN_WIDTH, 2*HUD_STRIP_HEIGHT);
+    screenTarget = LoadRenderTextureTracked(SCREEN_WIDTH, SCREEN_HEIGHT);
+    statusValid = false;
+    screenKind = HUD_SCREEN_NONE;
+}
+
+void UnloadHud(void)
+{
+    UnloadRenderTextureTracked(statusTarget);
+    UnloadRenderTextureTracked(screenTarget);
+    statusTarget = (RenderTexture2D){ 0 };
+    screenTarget = (RenderTexture2D){ 0 };
+    statusValid = false;
+    screenKind = HUD_SCREEN_NONE;
+}
+
+// Render textures are stored bottom up: negative source height, and a band drawn at y in the
+// target starts at texture height - y - band height in texture rows
+static void DrawCached(const RenderTexture2D *target, Rectangle band, Vector2 position)
+{
+    Rectangle source = { band.x, target->texture.height - band.y - band.height, band.width, -band.height };
+    DrawTexturePro(target->texture, source, (Rectangle){ position.x, position.y, band.width, band.height }, (Vector2){ 0, 0 }, 0.0f, WHITE);
+}
+
+void DrawHudStatus(int score, int hiScore, int wave, int lives)
+{
+    if (!statusValid || (statusKey[0] != score) || (statusKey[1] != hiScore) || (statusKey[2] != wave) || (statusKey[3] != lives)) {
+        BeginTextureMode(statusTarget);
+            ClearBackground(BLANK);
+
+            // Top row, same places as on the window
+            DrawText(TextFormat("SCORE: %04d", score), 10, 10, 20, RAYWHITE);
+            DrawText(TextFormat("HI-SCORE: %04d", hiScore), SCREEN_WIDTH / 2 - MeasureText("HI-SCORE: 0000", 20)/2, 10, 20, RAYWHITE);
+            for (int i = 0; i < lives; i++) {
+                DrawTextureEx(lifeTexture, (Vector2){ (float)(SCREEN_WIDTH - 110 + i * (lifeTexture.width * 0.7f + 5)), 10.0f }, 0.0f, 0.7f, WHITE);
+            }
+            if (lives > 0) DrawText("LIVES:", SCREEN_WIDTH - 110 - MeasureText("LIVES: ", 20), 10, 20, RAYWHITE);
+
+            // Bottom row, SCREEN_HEIGHT - HUD_STRIP_HEIGHT on the window
+            DrawText(TextFormat("WAVE: %d", wave), SCREEN_WIDTH - 100, HUD_STRIP_HEIGHT, 20, LIGHTGRAY);
+        EndTextureMode();
+
+        statusKey[0] = score; statusKey[1] = hiScore; statusKey[2] = wave; statusKey[3] = lives;
+        statusValid = true;
+        stats.statusRedraws++;
+    }
+
+    // Only the part holding the wave is drawn of the bottom row, the left of it has other labels
+    DrawCached(&statusTarget, (Rectangle){ 0, 0, SCREEN_WIDTH, HUD_STRIP_HEIGHT }, (Vector2){ 0, 0 });
+    DrawCached(&statusTarget, (Rectangle){ SCREEN_WIDTH - 100, HUD_STRIP_HEIGHT, 100, HUD_STRIP_HEIGHT }, (Vector2){ SCREEN_WIDTH - 100, SCREEN_HEIGHT - HUD_STRIP_HEIGHT });
+}
+
+void DrawTitleScreen(void)
+{
+    if (screenKind != HUD_SCREEN_TITLE) {
+        BeginTextureMode(screenTarget);
+            ClearBackground(BLANK);
+            DrawText("SPACE INVADERS", SCREEN_WIDTH/2 - MeasureText("SPACE INVADERS", 40)/2, SCREEN_HEIGHT/2 - 80, 40, GREEN);
+            DrawText("PRESS [ENTER] or TAP to START", SCREEN_WIDTH/2 - MeasureText("PRESS [ENTER] or TAP to START", 20)/2, SCREEN_HEIGHT/2 - 10, 20, RAYWHITE);
+            DrawText("CONTROLS:", 20, SCREEN_HEIGHT - 60, 20, LIGHTGRAY);
+            DrawText("ARROW KEYS / A / D / TOUCH SIDES: MOVE", 20, SCREEN_HEIGHT - 40, 20, LIGHTGRAY);
+            DrawText("SPACE / TAP: SHOOT", 20, SCREEN_HEIGHT - 20, 20, LIGHTGRAY);
+        EndTextureMode();
+
+        screenKind = HUD_SCREEN_TITLE;
+        stats.screenRedraws++;
+    }
+
+    DrawCached(&screenTarget, (Rectangle){ 0, 0, SCREEN_WIDTH, SCREEN_HEIGHT }, (Vector2){ 0, 0 });
+}
+
+void DrawGameOverScreen(int score)
+{
+    if ((screenKind != HUD_SCREEN_GAME_OVER) || (screenScore != score)) {
+        const char *finalScore = TextFormat("FINAL SCORE: %d", score);
+        BeginTextureMode(screenTarget);
+            ClearBackground(BLANK);
+            DrawText("GAME OVER", SCREEN_WIDTH/2 - MeasureText("GAME OVER", 40)/2, SCREEN_HEIGHT/2 - 40, 40, RED);
+            DrawText(finalScore, SCREEN_WIDTH/2 - MeasureText(finalScore, 20)/2, SCREEN_HEIGHT/2 + 10, 20, RAYWHITE);
+            DrawText("PRESS [ENTER] or TAP TO RESTART", SCREEN_WIDTH/2 - MeasureText("PRESS [ENTER] or TAP TO RESTART", 20)/2, SCREEN_HEIGHT/2 + 40, 20, LIGHTGRAY);
+        EndTextureMode();
+
+        screenKind = HUD_SCREEN_GAME_OVER;
+        screenScore = score;
+        stats.screenRedraws++;
+    }
+
+    DrawCached(&screenTarget, (Rectangle){ 0, 0, SCREEN_WIDTH, SCREEN_HEIGHT }, (Vector2){ 0, 0 });
+}
+
+HudStats GetHudStats(void)
+{
+    return stats;
+}
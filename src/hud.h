@@ -0,0 +1,40 @@
+#ifndef HUD_H
+#define HUD_H
+
+// Cached text layers. Score, hi-score, wave and lives change a few times a minute, yet formatting,
+// measuring and drawing them glyph by glyph cost the same every frame. They are drawn once into a
+// render texture whenever one of the values changes and otherwise blitted as is. The title and
+// game over screens share a full-window cache the same way (game over is keyed on the score).
+//  - status: one HUD_STRIP_HEIGHT strip for the top row (score, hi-score, lives) stacked on one
+//    for the bottom right (wave), drawn from the same texture as two quads
+//  - the versus result and the overlays (pause, rewind, spectate) are drawn directly, they are rare
+
+#include "raylib.h"
+
+//----------------------------------------------------------------------------------
+// Defines
+//----------------------------------------------------------------------------------
+#define HUD_STRIP_HEIGHT        30      // Text size 20 at y 10, lives icons fit too
+#define HUD_RENDER_TARGETS      2       // Status strips and the screen cache
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef struct HudStats {
+    int statusRedraws;          // Times the status strips were rendered again
+    int screenRedraws;          // Times the title/game over cache was rendered again
+} HudStats;
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+void LoadHud(Texture2D lifeIcon);           // Icon drawn once per remaining life
+void UnloadHud(void);
+
+// Inside BeginDrawing()
+void DrawHudStatus(int score, int hiScore, int wave, int lives);
+void DrawTitleScreen(void);
+void DrawGameOverScreen(int score);
+HudStats GetHudStats(void);
+
+#endif // HUD_H
@@ -1,154 +1,111 @@
 #include "raylib.h"
 #include "math.h"
 #include <stdlib.h> // For abs()
+#include <string.h> // For memcpy()
+#include <limits.h> // For INT_MAX
+#include "memory.h"
+#include "ledger.h"
+#include "game.h"
+#include "rewind.h"
+#include "replay.h"
+#include "versus.h"
+#include "netplay.h"
+#include "spectate.h"
+#include "autopilot.h"
+#include "tuning.h"
+#include "simthread.h"
+#include "audio.h"
+#include "upscale.h"
+#include "hud.h"
+#include "particles.h"
+#include "formation.h"
+#include "masks.h"
+#include "wall.h"
+#include "latency.h"
 
 #if defined(PLATFORM_WEB)
     #include <emscripten/emscripten.h>
 #endif
 
-// #define UNIT_TEST 1
-
 //----------------------------------------------------------------------------------
 // Defines
 //----------------------------------------------------------------------------------
-#define SCREEN_WIDTH            800
-#define SCREEN_HEIGHT           600
-
-#define PLAYER_SPEED            5.0f
-#define PLAYER_BULLET_SPEED     7.0f
-#define ALIEN_BULLET_SPEED      4.0f
-
-#define ALIENS_ROWS             5
-#define ALIENS_COLS             11
-#define NUM_ALIENS              (ALIENS_ROWS * ALIENS_COLS)
-#define MAX_ALIEN_BULLETS       10 // Max simultaneous alien bullets
-
-#define NUM_SHIELDS             4
-#define SHIELD_SEGMENTS_X       8
-#define SHIELD_SEGMENTS_Y       5
-
-#define ALIEN_MOVE_WAIT_TIME_START 0.8f // Initial time between alien moves (seconds)
-#define ALIEN_MOVE_SPEEDUP_FACTOR  0.97f // Multiplier applied to wait time when an alien is killed
-#define ALIEN_SHOOT_INTERVAL_MIN   0.5f // Minimum time between alien shots
-#define ALIEN_SHOOT_INTERVAL_MAX   2.0f // Maximum time between alien shots
-
-#define UFO_SPEED               55.0f
-#define UFO_POINTS              200
-
-      
-#define UFO_SPAWN_INTERVAL_MIN  30.0f // Minimum seconds until UFO appears
-#define UFO_SPAWN_INTERVAL_MAX  240.0f // Maximum seconds until UFO appears
-
-    
+#define QUICKSAVE_FILE          "quicksave.bin"
+#define MAX_TICKS_PER_FRAME     5 // Catch-up limit after a stall, the rest of the backlog is dropped
+#define MAIN_LOOP_FPS           60
+#define IDLE_POLL_TIME          0.05 // Seconds between input checks while a still screen is up
+#define IDLE_REFRESH_TIME       1.0 // Still screens are drawn again this often anyway (profiler, damaged windows)
+#define IDLE_SETTLE_FRAMES      10 // Full frames after entering a still screen or after input, until the picture is final
+#define VSYNC_SNAP_TIME         0.002f // With vsync, frame times this close to a tick count as exactly one
 
 //----------------------------------------------------------------------------------
 // Types and Structures Definition
 //----------------------------------------------------------------------------------
 typedef enum GameScreen { LOGO, TITLE, GAMEPLAY, GAME_OVER } GameScreen;
-typedef enum AlienType { ALIEN_TYPE_1 = 0, ALIEN_TYPE_2, ALIEN_TYPE_3 } AlienType; // Type 3 top, Type 1 bottom
-
-typedef struct Player {
-    Vector2 position;
-    Texture2D texture;
-    Rectangle textureRect; // Actual source rect
-    Vector2 size;          // Scaled size for drawing/collision
-    int lives;
-    bool shotActive;
-    Vector2 shotPosition;
-    Texture2D shotTexture;
-    Rectangle shotTextureRect;
-    Vector2 shotSize;
-    float explosionTimer; // Timer for player explosion effect
-} Player;
-
-typedef struct Alien {
-    Vector2 position;
-    Vector2 basePosition; // Original grid position
-    AlienType type;
-    Texture2D texture1;
-    Texture2D texture2;
-    Rectangle textureRect;
-    Vector2 size;
-    bool active;
-    bool currentFrame; // false = frame 1, true = frame 2
-    Color color;       // Tint, can be removed if using specific textures per type
-    int points;
-} Alien;
-
-typedef struct Bullet {
-    Vector2 position;
-    bool active;
-    float speed;
-    Texture2D texture;
-    Rectangle textureRect;
-    Vector2 size;
-} Bullet;
-
-typedef struct Shield {
-    Vector2 position;
-    RenderTexture2D renderTexture; // Use a render texture for destructibility
-    Texture2D baseTexture;
-    bool active;
-    Rectangle bounds;
-} Shield;
-
-typedef struct UFO {
-    Vector2 position;
-    Texture2D texture;
-    Rectangle textureRect;
-    Vector2 size;
-    bool active;
-    float speed;
-    float spawnTimer;
-    float timeActive; // For sound pitch
-    bool exploding;
-    float explosionTimer;
-    Texture2D explosionTexture;
-    Rectangle explosionTextureRect;
-} UFO;
-
-typedef struct Explosion {
-    Vector2 position;
-    Texture2D texture;
-    Rectangle textureRect;
-    Vector2 size;
-    float timer;
-    bool active;
-} Explosion;
-
-
-
-#define MAX_EXPLOSIONS 10
+
+// What the render thread sees of the simulation when it runs on its own thread
+typedef struct SimSnapshot {
+    Game game;
+    uint32_t starts;            // SIM_COMMAND_START commands applied, older games are not shown
+    bool paused;
+    bool rewinding;
+    RewindStats rewind;
+    SpectateStats spectate;
+    uint32_t inputSerial;       // Newest input event a tick has applied, see latency.h
+} SimSnapshot;
 
 //------------------------------------------------------------------------------------
 // Global Variables Declaration
 //------------------------------------------------------------------------------------
 static GameScreen currentScreen = LOGO; // Change to TITLE if no logo screen needed
 static int framesCounter = 0;
-static bool gameOver = false;
 static bool gamePaused = false;
-static int score = 0;
 static int hiScore = 0; // Basic high score persistence needed for web (localStorage JS?)
-
-// Gameplay specific
-static Player player = { 0 };
-static Alien aliens[NUM_ALIENS] = { 0 };
-static Bullet alienBullets[MAX_ALIEN_BULLETS] = { 0 };
-static Shield shields[NUM_SHIELDS] = { 0 };
-static UFO ufo = { 0 };
-static Explosion explosions[MAX_EXPLOSIONS] = { 0 };
-
-static int aliensAlive = 0;
-static float alienMoveTimer = 0;
-static float alienMoveWaitTime = ALIEN_MOVE_WAIT_TIME_START;
-static int alienDirection = 1; // 1 = right, -1 = left
-static float alienHorizontalMove = 3.0f;
-static float alienVerticalMove = 2.0f;
-static bool alienSwitchFrame = false; // Flag to switch animation frame
-static bool moveDown = false; // Flag for aliens to move down
-static float alienShootTimer = 0;
-static int alienMoveSoundIndex = 0; // 0 to 3 for the fastinvader sounds
-static int currentWave = 1;
+static bool showProfiler = false; // F1 toggles the frame stats overlay
+static bool rewinding = false; // BACKSPACE held, the simulation runs backwards
+static float tickAccumulator = 0.0f; // Real time not yet simulated, in seconds
+static bool firePending = false; // Fire pressed on a frame that ran no tick yet
+static const char *recordFile = NULL; // --record <file>: the last game is written there as a replay
+static Replay replay = { 0 };
+static bool versusMode = false; // --versus-host/--versus-join: two boards over the network, see netplay.h
+static NetplayConfig netConfig = { 0 };
+static const char *spectateHost = NULL; // --spectate-host <port|path>: stream the local board to viewers
+static const char *spectateSource = NULL; // --spectate <host:port|path>: viewer mode, draws a remote game
+static bool spectating = false;
+static bool spectateEnded = false; // The publisher went away
+static bool autopilot = false; // --autopilot: the bot plays and games restart on their own (soak tests, profiling)
+static bool serialSim = false; // --serial-sim: tick inside the frame even where the simulation thread is available
+static int lowResDivisor = 1; // --lowres <n>: the board is drawn at 1/n of the window and upscaled, see upscale.h
+static bool crtEffect = false; // --crt: CRT shader on the upscaled board (implies --lowres 4 if not given)
+static WallConfig wallConfig = { 0 }; // --wall <n>: a grid of independent games in this window, see wall.h
+static bool simThreaded = false; // Single player on desktop: the simulation ticks on its own thread, see simthread.h
+static bool vsync = false; // --vsync: the swap paces the frames instead of the frame limiter
+static bool latencyMode = false; // --latency or --frame-delay: input-to-present tracking, see latency.h
+static LatencyConfig latencyConfig = { 0 };
+#if defined(PLATFORM_WEB)
+static double startupMainMs = 0.0; // performance.now() entering main(): download, compile and preload are done
+#endif
+static uint32_t tickInputSerial = 0; // Newest input event a tick has applied (the sim thread's while it runs)
+
+// Threaded simulation: game, replay, rewind, pause, firePending and the spectate publisher belong
+// to the simulation thread, the render thread only reads the snapshot copy below
+static bool simActive = false; // Sim thread: between SIM_COMMAND_START and SIM_COMMAND_HALT
+static uint32_t simStarts = 0; // Sim thread: SIM_COMMAND_START commands applied
+static GameInput simInput = { 0 }; // Sim thread: held keys of the last input command
+static uint32_t simInputSerial = 0; // Sim thread: input event of the last input command
+static uint32_t simStartsSent = 0; // Render thread: SIM_COMMAND_START commands queued
+static GameInput sentInput = { 0 }; // Render thread: held keys in the last input command
+static bool sentRewind = false; // Render thread: BACKSPACE state in the last rewind command
+static SimSnapshot view = { 0 }; // Render thread: newest snapshot of the current game
+static int idleFrames = 0; // Frames drawn since the still screen came up or since the last input
+static double idleDrawTime = 0.0; // When the still screen was last drawn
+static unsigned char shieldUploaded[NUM_SHIELDS][SHIELD_TEX_HEIGHT][SHIELD_TEX_WIDTH]; // Render thread: texels the shield textures hold
+static bool shieldUploadedValid = false;
+
+// Gameplay specific: the whole simulation state, see game.h
+static Game game = { 0 };
+static Versus versus = { 0 };
+static Texture2D shieldMasks[VERSUS_PLAYERS][NUM_SHIELDS] = { 0 }; // 8-bit coverage, pooled per board and shield; single player uses board 0
 
 // Resources
 static Texture2D alienTexture1_1, alienTexture1_2;
@@ -161,179 +118,163 @@ static Texture2D rollingTexture1, rollingTexture2, rollingTexture3, rollingTextu
 static Texture2D plungerTexture1, plungerTexture2, plungerTexture3, plungerTexture4; // Alt alien shot anim
 static Texture2D squigTexture1, squigTexture2, squigTexture3, squigTexture4;         // Alt alien shot anim
 static Texture2D shieldTexture;
+static Color shieldColor = WHITE; // Color of shield.png, the masks are drawn in it
 static Texture2D ufoTexture;
 static Texture2D alienExplosionTexture;
 static Texture2D playerExplosionTexture; // Use alien_exploding? or specific one? Using alien_exploding for now
 static Texture2D shotExplosionTexture; // player_shot_exploding
 static Texture2D ufoExplosionTexture;  // saucer_exploding
 
-static Sound shootSound;
-static Sound invaderKilledSound;
-static Sound explosionSound; // Player explosion
-static Sound fastInvaderSound1, fastInvaderSound2, fastInvaderSound3, fastInvaderSound4;
-static Sound ufoHighSound, ufoLowSound;
-static Sound alienExplosionSound; // Use invaderkilled or a different one? Using invaderkilled
-static Sound ufoExplosionSound; // Use explosion or invaderkilled? Using explosion
-
 //------------------------------------------------------------------------------------
 // Module Functions Declaration (local)
 //------------------------------------------------------------------------------------
 static void InitGame(void);         // Initialize game
 static void UpdateGame(void);       // Update game (one frame)
 static void DrawGame(void);         // Draw game (one frame)
+static void DrawProfiler(void);     // Draw frame stats overlay
 static void UnloadGame(void);       // Unload game
 static void UpdateDrawFrame(void); // Update and Draw (web loop)
 
 static void LoadResources(void);
 static void UnloadResources(void);
-static void InitAliens(void);
-static void InitShields(void);
-static void DamageShield(int shieldIndex, Vector2 hitPosition);
-static void UpdateAliens(float delta);
-static void UpdateBullets(float delta);
-static void UpdateUFO(float delta);
-static void UpdateExplosions(float delta);
-static void CheckCollisions(void);
-static void SpawnPlayerShot(void);
-static void SpawnAlienShot(Vector2 position);
-static void SpawnUFO(void);
-static void SpawnExplosion(Vector2 position, Texture2D tex, Rectangle texRect, Vector2 size);
-static void ResetLevel(bool playerDied);
-static void NextLevel(void);
-static Vector2 WorldToShieldTexCoords(int shieldIndex, Vector2 worldPos);
-
-
-
-//typedef struct Shield Shield;  // lets the compiler know the type
-//extern Shield shields[];       // tells it that the array exists later
-
-
-#ifdef UNIT_TEST
-#include <stdio.h>
-#include <assert.h>
-
-// Helper: expose the core of "alien bullet vs shield" collision so we can call it from main()
-bool TestAlienBulletShieldCollision(int bi, int si, Vector2 *outWorldHit, Color *outPx)
-{
-    // build bullet rect
-    Rectangle bulletRect = {
-        alienBullets[bi].position.x,
-        alienBullets[bi].position.y,
-        alienBullets[bi].size.x,
-        alienBullets[bi].size.y
-    };
-
-    // quick AABB check
-    if (!shields[si].active
-     || !CheckCollisionRecs(bulletRect, shields[si].bounds))
-        return false;
-
-    // compute world‐space hit point (bottom of bullet)
-    Vector2 worldHit = {
-        bulletRect.x + bulletRect.width * 0.5f,
-        bulletRect.y + bulletRect.height
-    };
-    *outWorldHit = worldHit;
-
-    // convert into shield‐texture coordinates
-    Vector2 texHit = WorldToShieldTexCoords(si, worldHit);
-
-    printf("[UNIT_TEST] Bullet[%d] vs Shield[%d]: worldHit=(%.1f,%.1f) texHit=(%.1f,%.1f)\n",
-           bi, si, worldHit.x, worldHit.y, texHit.x, texHit.y);
-
-    // sample the pixel alpha
-    Image texImg = LoadImageFromTexture(shields[si].renderTexture.texture);
-    Color px = GetImageColor(texImg, (int)texHit.x, (int)texHit.y);
-    UnloadImage(texImg);
-    *outPx = px;
-
-    printf("[UNIT_TEST] sample alpha = %d → %s\n",
-           px.a, (px.a > 10) ? "HIT" : "MISS");
-
-    return (px.a > 10);
-}
-
-// Helper: expose the core of "player shot vs shield" collision for testing
-bool TestPlayerBulletShieldCollision(int si, Vector2 shotPos, Vector2 shotSize, Vector2 *outCollisionPoint, Color *outPx)
-{
-    Rectangle shotRect = { shotPos.x, shotPos.y, shotSize.x, shotSize.y };
-
-    if (!shields[si].active || !CheckCollisionRecs(shotRect, shields[si].bounds))
-        return false;
-
-    // collision point at top center of shot
-    Vector2 collisionPoint = {
-        shotRect.x + shotRect.width * 0.5f,
-        shotRect.y
-    };
-    *outCollisionPoint = collisionPoint;
-
-    // convert to shield texture coords
-    Vector2 localHit = { collisionPoint.x - shields[si].position.x,
-                         collisionPoint.y - shields[si].position.y };
-    localHit.x /= (shields[si].bounds.width  / shields[si].renderTexture.texture.width);
-    localHit.y /= (shields[si].bounds.height / shields[si].renderTexture.texture.height);
-
-    printf("[UNIT_TEST] Player shot vs shield[%d]: collision=(%.1f,%.1f) tex=(%.1f,%.1f)\n",
-           si, collisionPoint.x, collisionPoint.y, localHit.x, localHit.y);
-
-    Image texImg = LoadImageFromTexture(shields[si].renderTexture.texture);
-    Color px = GetImageColor(texImg, (int)localHit.x, (int)localHit.y);
-    UnloadImage(texImg);
-    *outPx = px;
-
-    printf("[UNIT_TEST] alpha=%d → %s\n", px.a, (px.a>10)?"HIT":"MISS");
-    return (px.a > 10);
-}
-#endif
-
-
-// -----------------------------------------------------------------------------
-static Vector2 WorldToShieldTexCoords(int shieldIndex, Vector2 worldPos)
-{
-    // Convert world position to the *render‑texture* pixel we are going to read
-    float scaleX = (float)shields[shieldIndex].renderTexture.texture.width  /
-                   shields[shieldIndex].bounds.width;
-    float scaleY = (float)shields[shieldIndex].renderTexture.texture.height /
-                   shields[shieldIndex].bounds.height;
-
-    Vector2 local;
-    local.x = (worldPos.x - shields[shieldIndex].position.x) * scaleX;
-    local.y = (worldPos.y - shields[shieldIndex].position.y) * scaleY;
-
-    // Destination is drawn with a negative source‑height → Y axis is flipped.
-    local.y = shields[shieldIndex].renderTexture.texture.height - local.y;
-
-    // Clamp to valid pixel range so we never read OOB
-    if (local.x < 0) local.x = 0; 
-    if (local.y < 0) local.y = 0;
-    if (local.x > shields[shieldIndex].renderTexture.texture.width  - 1) 
-        local.x = shields[shieldIndex].renderTexture.texture.width  - 1;
-    if (local.y > shields[shieldIndex].renderTexture.texture.height - 1) 
-        local.y = shields[shieldIndex].renderTexture.texture.height - 1;
-    return local;
-}
-// -----------------------------------------------------------------------------
-// ★★★ MODIFIED DamageShield() ★★★
+static void StartGame(void);
+static void ResetSimulation(uint64_t seed);
+static GameInput ReadGameInput(void);
+static void AdvanceGame(GameInput input);
+static void ResyncUfoDrone(void);
+static void SyncShieldTextures(Game *board, Texture2D *masks);
+static void SyncShieldSnapshot(Game *board);
+static void DrawBoard(const Game *board, const Texture2D *masks);
+static const Game *GetDisplayedGame(void);
+static bool StartVersus(void);
+static void UpdateVersusMatch(void);
+static void UpdateSpectator(void);
+static void UpdateThreadedGame(void);
+static void SimulationTick(void);
+static float GetTickFrameTime(void);
+static void UpdateParticleEffects(void);
+static bool IsVersusDecided(void);
+static void QuickSave(void);
+static void QuickLoad(void);
+static bool UpdateRewind(void);
+static void SaveRecording(void);
+static Texture2D GetAlienTexture(AlienType type, bool frame);
 
 //------------------------------------------------------------------------------------
 // Program main entry point
 //------------------------------------------------------------------------------------
-
-
-int main(void)
+int main(int argc, char *argv[])
 {
+#if defined(PLATFORM_WEB)
+    startupMainMs = emscripten_get_now();
+#endif
+    static char hostAddress[64] = { 0 };
+    for (int i = 1; i < argc; i++) {
+        if ((strcmp(argv[i], "--record") == 0) && (i + 1 < argc)) recordFile = argv[++i];
+        else if ((strcmp(argv[i], "--versus-host") == 0) && (i + 1 < argc)) {
+            versusMode = true;
+            netConfig.host = true;
+            netConfig.port = atoi(argv[++i]);
+        }
+        else if ((strcmp(argv[i], "--versus-join") == 0) && (i + 1 < argc)) {
+            // ip:port
+            const char *address = argv[++i];
+            const char *colon = strchr(address, ':');
+            if ((colon != NULL) && (colon - address < (int)sizeof(hostAddress))) {
+                memcpy(hostAddress, address, colon - address);
+                netConfig.address = hostAddress;
+                netConfig.port = atoi(colon + 1);
+                versusMode = true;
+            }
+        }
+        else if ((strcmp(argv[i], "--net-delay") == 0) && (i + 1 < argc)) netConfig.delayMs = atoi(argv[++i]);
+        else if ((strcmp(argv[i], "--net-loss") == 0) && (i + 1 < argc)) netConfig.lossPercent = atoi(argv[++i]);
+        else if ((strcmp(argv[i], "--spectate-host") == 0) && (i + 1 < argc)) spectateHost = argv[++i];
+        else if ((strcmp(argv[i], "--spectate") == 0) && (i + 1 < argc)) spectateSource = argv[++i];
+        else if (strcmp(argv[i], "--autopilot") == 0) autopilot = true;
+        else if (strcmp(argv[i], "--serial-sim") == 0) serialSim = true;
+        else if ((strcmp(argv[i], "--lowres") == 0) && (i + 1 < argc)) lowResDivisor = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--crt") == 0) crtEffect = true;
+        else if ((strcmp(argv[i], "--wall") == 0) && (i + 1 < argc)) wallConfig.games = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--wall-local") == 0) wallConfig.localPlayer = true;
+        else if ((strcmp(argv[i], "--wall-replay") == 0) && (i + 1 < argc)) {
+            if (wallConfig.replayCount < WALL_MAX_REPLAYS) wallConfig.replays[wallConfig.replayCount++] = argv[i + 1];
+            i++;
+        }
+        else if ((strcmp(argv[i], "--wall-threads") == 0) && (i + 1 < argc)) wallConfig.workers = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--vsync") == 0) vsync = true;
+        else if (strcmp(argv[i], "--latency") == 0) latencyMode = true;
+        else if ((strcmp(argv[i], "--frame-delay") == 0) && (i + 1 < argc)) {
+            // Milliseconds or "auto"; the delay counts from the vsync'd present, and the tick must follow
+            // the sample in the same frame, which the free-running simulation thread would not do
+            const char *delay = argv[++i];
+            latencyConfig.autoFrameDelay = (strcmp(delay, "auto") == 0);
+            latencyConfig.frameDelayMs = latencyConfig.autoFrameDelay ? 0.0f : (float)atof(delay);
+            latencyMode = vsync = serialSim = true;
+        }
+        else if ((strcmp(argv[i], "--tuning") == 0) && (i + 1 < argc)) {
+            // Rules for every game of this run; versus peers must load the same file or they desync
+            GameTuning tuning = GetDefaultGameTuning();
+            if (LoadGameTuning(argv[++i], &tuning)) SetGameTuning(&tuning);
+        }
+    }
+
+    if (vsync) SetConfigFlags(FLAG_VSYNC_HINT);
     InitWindow(SCREEN_WIDTH, SCREEN_HEIGHT, "raylib - Space Invaders");
-    InitAudioDevice();
+
+    // The wall replaces everything else: no title, audio, versus or single board
+    if (wallConfig.games > 0) {
+        wallConfig.readInput = ReadGameInput;
+        if (InitWall(&wallConfig)) {
+#if defined(PLATFORM_WEB)
+            emscripten_set_main_loop(UpdateDrawWall, 0, 1); // requestAnimationFrame, at the display rate
+#else
+            SetTargetFPS(MAIN_LOOP_FPS);
+            while (!WindowShouldClose()) UpdateDrawWall();
+#endif
+            UnloadWall();
+            LedgerReportLeaks();
+            CloseWindow();
+            return 0;
+        }
+        TraceLog(LOG_WARNING, "GAME: Wall could not start, single game instead");
+    }
 
     LoadResources();
     InitGame();
+    // The grid is the same in every game, the first one gives it
+    if (!LoadFormationRenderer(&game)) TraceLog(LOG_INFO, "GAME: No instancing, aliens are drawn one by one");
+    if (versusMode && !StartVersus()) versusMode = false;
+    if ((spectateHost != NULL) && !SpectatePublishStart(spectateHost)) {
+        TraceLog(LOG_WARNING, "SPECTATE: Could not publish on %s", spectateHost);
+        spectateHost = NULL;
+    }
+    if (spectateSource != NULL) {
+        spectating = SpectateViewStart(spectateSource);
+        if (spectating) currentScreen = GAMEPLAY;
+        else TraceLog(LOG_WARNING, "SPECTATE: Could not connect to %s", spectateSource);
+    }
+    if (autopilot && !spectating) currentScreen = GAMEPLAY; // No title, the bot starts right away
+
+    // Versus and spectating keep ticking in the frame: their pacing follows the network, not a clock
+    if (!versusMode && !spectating && !serialSim && SimThreadStart(sizeof(SimSnapshot), SimulationTick)) {
+        simThreaded = true;
+        if (currentScreen == GAMEPLAY) StartGame(); // The thread starts halted, as behind the title
+        TraceLog(LOG_INFO, "GAME: Simulation runs on its own thread at %d Hz", GAME_TICK_RATE);
+    }
+    if (latencyMode) {
+        latencyConfig.vsync = vsync;
+        latencyConfig.targetFPS = MAIN_LOOP_FPS;
+        latencyConfig.readInput = ReadGameInput;
+        InitLatency(&latencyConfig);
+    }
 
 #if defined(PLATFORM_WEB)
-    // Required argument is a function pointer, so pass the function name directly
-    emscripten_set_main_loop(UpdateDrawFrame, 60, 1);
+    // Required argument is a function pointer, so pass the function name directly. Frame rate 0 runs it
+    // from requestAnimationFrame at the display rate; the ticks follow the clock, not the frames
+    emscripten_set_main_loop(UpdateDrawFrame, 0, 1);
 #else
-    SetTargetFPS(60);
+    SetTargetFPS((vsync || latencyMode) ? 0 : MAIN_LOOP_FPS); // Otherwise the swap or WaitFrameDelay() paces the frames
     //--------------------------------------------------------------------------------------
     // Main game loop
     while (!WindowShouldClose()) // Detect window close button or ESC key
@@ -342,9 +283,18 @@ int main(void)
     }
 #endif
 
+    SimThreadStop(); // Game and replay are the main thread's again
+    if (latencyMode) LogLatencyReport();
+    if ((currentScreen == GAMEPLAY) && !versusMode) SaveRecording(); // Game in progress at exit
+    ReplayFree(&replay);
+    NetplayStop();
+    SpectatePublishStop();
+    SpectateViewStop();
+
     UnloadGame();
+    UnloadFormationRenderer();
     UnloadResources();
-    CloseAudioDevice();
+    LedgerReportLeaks();
     CloseWindow(); // Close window and OpenGL context
     //--------------------------------------------------------------------------------------
 
@@ -356,76 +306,84 @@ int main(void)
 //----------------------------------------------------------------------------------
 void LoadResources(void) {
     // Textures - Use standard resolution first
-    alienTexture1_1 = LoadTexture("resources/inv11.png");
-    alienTexture1_2 = LoadTexture("resources/inv12.png");
-    alienTexture2_1 = LoadTexture("resources/inv21.png");
-    alienTexture2_2 = LoadTexture("resources/inv22.png");
-    alienTexture3_1 = LoadTexture("resources/inv31.png");
-    alienTexture3_2 = LoadTexture("resources/inv32.png");
-    playerTexture = LoadTexture("resources/play.png"); // Assuming 'play.png' is the player ship
-    playerShotTexture = LoadTexture("resources/player_shot.png");
-    shieldTexture = LoadTexture("resources/shield.png");
-    ufoTexture = LoadTexture("resources/saucer.png");
+    alienTexture1_1 = LoadTextureTracked("resources/inv11.png");
+    alienTexture1_2 = LoadTextureTracked("resources/inv12.png");
+    alienTexture2_1 = LoadTextureTracked("resources/inv21.png");
+    alienTexture2_2 = LoadTextureTracked("resources/inv22.png");
+    alienTexture3_1 = LoadTextureTracked("resources/inv31.png");
+    alienTexture3_2 = LoadTextureTracked("resources/inv32.png");
+    playerTexture = LoadTextureTracked("resources/play.png"); // Assuming 'play.png' is the player ship
+    playerShotTexture = LoadTextureTracked("resources/player_shot.png");
+    shieldTexture = LoadTextureTracked("resources/shield.png");
+    Image shieldImage = LoadImage("resources/shield.png"); // One color: the first solid pixel gives it
+    ImageFormat(&shieldImage, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+    for (int i = 0; i < shieldImage.width*shieldImage.height; i++) {
+        if (((Color *)shieldImage.data)[i].a == 255) { shieldColor = ((Color *)shieldImage.data)[i]; break; }
+    }
+    UnloadImage(shieldImage);
+    LoadMaskShader();
+    ufoTexture = LoadTextureTracked("resources/saucer.png");
 
     // Decide on alien shot graphic - Using 'rolling' for now
-    alienShotTexture = LoadTexture("resources/rolling1.png"); // Placeholder, could animate
-    rollingTexture1 = LoadTexture("resources/rolling1.png");
-    rollingTexture2 = LoadTexture("resources/rolling2.png");
-    rollingTexture3 = LoadTexture("resources/rolling3.png");
-    rollingTexture4 = LoadTexture("resources/rolling4.png");
+    alienShotTexture = LoadTextureTracked("resources/rolling1.png"); // Placeholder, could animate
+    rollingTexture1 = LoadTextureTracked("resources/rolling1.png");
+    rollingTexture2 = LoadTextureTracked("resources/rolling2.png");
+    rollingTexture3 = LoadTextureTracked("resources/rolling3.png");
+    rollingTexture4 = LoadTextureTracked("resources/rolling4.png");
     // Load others if needed: plunger1-4, squig1-4
 
-    alienExplosionTexture = LoadTexture("resources/alien_exploding.png");
-    playerExplosionTexture = LoadTexture("resources/explosion.wav"); // Using explosion sound, need player explosion image. Use alien one for now.
-    playerExplosionTexture = LoadTexture("resources/alien_exploding.png"); // Fallback
-    shotExplosionTexture = LoadTexture("resources/player_shot_exploding.png");
-    ufoExplosionTexture = LoadTexture("resources/saucer_exploding.png");
-
-    // Sounds
-    shootSound = LoadSound("resources/shoot.wav");
-    invaderKilledSound = LoadSound("resources/invaderkilled.wav");
-    explosionSound = LoadSound("resources/explosion.wav"); // Player death
-    fastInvaderSound1 = LoadSound("resources/fastinvader1.wav");
-    fastInvaderSound2 = LoadSound("resources/fastinvader2.wav");
-    fastInvaderSound3 = LoadSound("resources/fastinvader3.wav");
-    fastInvaderSound4 = LoadSound("resources/fastinvader4.wav");
-    ufoHighSound = LoadSound("resources/ufo_highpitch.wav");
-    ufoLowSound = LoadSound("resources/ufo_lowpitch.wav"); // Maybe alternate or use one
-
-    // Assign other sounds (can reuse)
-    alienExplosionSound = invaderKilledSound; // Reuse kill sound for alien explosion sound
-    ufoExplosionSound = explosionSound; // Reuse player explosion for UFO explosion sound
-
-    // Set looping for UFO sound if desired (handled manually by restarting)
-    // SetSoundLoop(ufoHighSound, true);
+    alienExplosionTexture = LoadTextureTracked("resources/alien_exploding.png");
+    playerExplosionTexture = LoadTextureTracked("resources/alien_exploding.png"); // No player explosion image, use the alien one
+    shotExplosionTexture = LoadTextureTracked("resources/player_shot_exploding.png");
+    ufoExplosionTexture = LoadTextureTracked("resources/saucer_exploding.png");
+
+    // Sounds, played from the game events through the voice pool, see audio.h
+    LoadGameAudio();
+
+    // Text layers, drawn again only when what they show changes, see hud.h
+    LoadHud(playerTexture);
+
+    // Debris of explosions and shield hits, see particles.h
+    if (!InitParticles()) TraceLog(LOG_WARNING, "GAME: No memory for particles, explosions without debris");
+
+    if (crtEffect && (lowResDivisor == 1)) lowResDivisor = 4;
+    if ((lowResDivisor > 1) && !LoadUpscaler(lowResDivisor, crtEffect)) lowResDivisor = 1;
 }
 
 void UnloadResources(void) {
     // Textures
-    UnloadTexture(alienTexture1_1); UnloadTexture(alienTexture1_2);
-    UnloadTexture(alienTexture2_1); UnloadTexture(alienTexture2_2);
-    UnloadTexture(alienTexture3_1); UnloadTexture(alienTexture3_2);
-    UnloadTexture(playerTexture);
-    UnloadTexture(playerShotTexture);
-    UnloadTexture(alienShotTexture);
-    UnloadTexture(rollingTexture1); UnloadTexture(rollingTexture2); UnloadTexture(rollingTexture3); UnloadTexture(rollingTexture4);
-    UnloadTexture(shieldTexture);
-    UnloadTexture(ufoTexture);
-    UnloadTexture(alienExplosionTexture);
-    UnloadTexture(playerExplosionTexture);
-    UnloadTexture(shotExplosionTexture);
-    UnloadTexture(ufoExplosionTexture);
-
-    // Sounds
-    UnloadSound(shootSound);
-    UnloadSound(invaderKilledSound);
-    UnloadSound(explosionSound);
-    UnloadSound(fastInvaderSound1); UnloadSound(fastInvaderSound2);
-    UnloadSound(fastInvaderSound3); UnloadSound(fastInvaderSound4);
-    UnloadSound(ufoHighSound); UnloadSound(ufoLowSound);
-    // No need to unload alienExplosionSound/ufoExplosionSound if they alias others
+    UnloadTextureTracked(alienTexture1_1); UnloadTextureTracked(alienTexture1_2);
+    UnloadTextureTracked(alienTexture2_1); UnloadTextureTracked(alienTexture2_2);
+    UnloadTextureTracked(alienTexture3_1); UnloadTextureTracked(alienTexture3_2);
+    UnloadTextureTracked(playerTexture);
+    UnloadTextureTracked(playerShotTexture);
+    UnloadTextureTracked(alienShotTexture);
+    UnloadTextureTracked(rollingTexture1); UnloadTextureTracked(rollingTexture2); UnloadTextureTracked(rollingTexture3); UnloadTextureTracked(rollingTexture4);
+    UnloadTextureTracked(shieldTexture);
+    UnloadMaskShader();
+    UnloadTextureTracked(ufoTexture);
+    UnloadTextureTracked(alienExplosionTexture);
+    UnloadTextureTracked(playerExplosionTexture);
+    UnloadTextureTracked(shotExplosionTexture);
+    UnloadTextureTracked(ufoExplosionTexture);
+
+    // Sounds, also closes the audio device
+    UnloadGameAudio();
+
+    // Text layers, particles, low-res board target and CRT shader, if any
+    UnloadHud();
+    FreeParticles();
+    UnloadUpscaler();
 }
 
+static Texture2D GetAlienTexture(AlienType type, bool frame)
+{
+    switch (type) {
+        case ALIEN_TYPE_3: return frame ? alienTexture3_2 : alienTexture3_1;
+        case ALIEN_TYPE_2: return frame ? alienTexture2_2 : alienTexture2_1;
+        default: return frame ? alienTexture1_2 : alienTexture1_1;
+    }
+}
 
 //----------------------------------------------------------------------------------
 // Module Functions Definition - Game Initialization
@@ -433,129 +391,161 @@ void UnloadResources(void) {
 void InitGame(void)
 {
     framesCounter = 0;
-    gameOver = false;
-    gamePaused = false;
-    score = 0;
-    currentWave = 1;
     // hiScore = LoadHighScore(); // Need mechanism for this
 
-    // Init Player
-    player.texture = playerTexture;
-    player.textureRect = (Rectangle){ 0, 0, (float)player.texture.width, (float)player.texture.height };
-    player.size = (Vector2){ player.textureRect.width * 1.5f, player.textureRect.height * 1.5f }; // Scale slightly
-    player.position = (Vector2){ SCREEN_WIDTH / 2.0f - player.size.x / 2.0f, SCREEN_HEIGHT - player.size.y - 20.0f };
-    player.lives = 3;
-    player.shotActive = false;
-    player.shotTexture = playerShotTexture;
-    player.shotTextureRect = (Rectangle){ 0, 0, (float)player.shotTexture.width, (float)player.shotTexture.height };
-    player.shotSize = (Vector2){ player.shotTextureRect.width * 1.5f, player.shotTextureRect.height * 1.5f };
-    player.explosionTimer = 0.0f;
-
-    // Init Alien Bullets
-    for (int i = 0; i < MAX_ALIEN_BULLETS; i++) {
-        alienBullets[i].active = false;
-        alienBullets[i].texture = rollingTexture1; // Start with first frame
-        alienBullets[i].textureRect = (Rectangle){0, 0, (float)rollingTexture1.width, (float)rollingTexture1.height};
-        alienBullets[i].size = (Vector2){alienBullets[i].textureRect.width * 1.5f, alienBullets[i].textureRect.height * 1.5f};
-        alienBullets[i].speed = ALIEN_BULLET_SPEED;
+    // Shield render textures are pooled: created on first use, then re-uploaded in place every wave and restart
+    for (int i = 0; i < NUM_SHIELDS; i++) {
+        if (shieldMasks[0][i].id == 0) shieldMasks[0][i] = LoadMaskTexture(SHIELD_TEX_WIDTH, SHIELD_TEX_HEIGHT);
     }
 
-    // Init UFO
-    ufo.texture = ufoTexture;
-    ufo.textureRect = (Rectangle){ 0, 0, (float)ufo.texture.width, (float)ufo.texture.height };
-    ufo.size = (Vector2){ ufo.textureRect.width * 1.5f, ufo.textureRect.height * 1.5f };
-    ufo.active = false;
-    //ufo.spawnTimer = GetRandomValue(600, 1200); // Frames until first potential spawn
-    ufo.spawnTimer = GetRandomValue((int)(UFO_SPAWN_INTERVAL_MIN * 100), (int)(UFO_SPAWN_INTERVAL_MAX * 100)) / 100.0f; 
-    ufo.explosionTexture = ufoExplosionTexture;
-    ufo.explosionTextureRect = (Rectangle){0, 0, (float)ufo.explosionTexture.width, (float)ufo.explosionTexture.height};
+    if (simThreaded) SimPushCommand((SimCommand){ SIM_COMMAND_HALT }); // Idle behind the title, ENTER starts the next game
+    else StartGame();
 
+    currentScreen = TITLE; // Go to title screen after init
+}
 
-    // Init Explosions
-    for(int i=0; i<MAX_EXPLOSIONS; ++i) explosions[i].active = false;
-
+// Fresh simulation (wave 1, 3 lives, intact shields) with a new random seed
+static void StartGame(void)
+{
+    uint64_t seed = (uint64_t)GetRandomValue(0, INT_MAX);
+    tickAccumulator = 0.0f;
+    ClearParticles();
+
+    if (simThreaded) {
+        // The thread resets its game when it reads the command, the same fresh state is shown meanwhile
+        if (SimPushCommand((SimCommand){ SIM_COMMAND_START, { 0 }, (uint32_t)seed })) simStartsSent++;
+        InitGameState(&view.game, seed);
+        view.paused = false;
+        view.rewinding = false;
+        return;
+    }
 
-    InitAliens();
-    InitShields();
+    ResetSimulation(seed);
+    SyncShieldTextures(&game, shieldMasks[0]);
+}
 
-    currentScreen = TITLE; // Go to title screen after init
+// Simulation side of a new game, on the thread that owns it
+static void ResetSimulation(uint64_t seed)
+{
+    InitGameState(&game, seed);
+    RewindReset(&game);
+    ReplayBegin(&replay, seed);
+    firePending = false;
+    gamePaused = false;
+    rewinding = false;
 }
 
-void InitAliens(void) {
-    aliensAlive = 0;
-    float startX = 80.0f;
-    float startY = 80.0f;
-    float spacingX = 45.0f;
-    float spacingY = 35.0f;
-
-    for (int r = 0; r < ALIENS_ROWS; r++) {
-        for (int c = 0; c < ALIENS_COLS; c++) {
-            int i = r * ALIENS_COLS + c;
-            aliens[i].basePosition = (Vector2){ startX + c * spacingX, startY + r * spacingY };
-            aliens[i].position = aliens[i].basePosition;
-            aliens[i].active = true;
-            aliens[i].currentFrame = false;
-
-            if (r == 0) { // Top row
-                aliens[i].type = ALIEN_TYPE_3;
-                aliens[i].texture1 = alienTexture3_1;
-                aliens[i].texture2 = alienTexture3_2;
-                aliens[i].points = 30;
-                 aliens[i].color = WHITE; // Or specific colors: PINK
-            } else if (r < 3) { // Middle rows
-                aliens[i].type = ALIEN_TYPE_2;
-                aliens[i].texture1 = alienTexture2_1;
-                aliens[i].texture2 = alienTexture2_2;
-                aliens[i].points = 20;
-                 aliens[i].color = WHITE; // Or specific colors: YELLOW
-            } else { // Bottom rows
-                aliens[i].type = ALIEN_TYPE_1;
-                aliens[i].texture1 = alienTexture1_1;
-                aliens[i].texture2 = alienTexture1_2;
-                aliens[i].points = 10;
-                 aliens[i].color = WHITE; // Or specific colors: LIME
-            }
-            aliens[i].textureRect = (Rectangle){ 0, 0, (float)aliens[i].texture1.width, (float)aliens[i].texture1.height };
-            aliens[i].size = (Vector2){ aliens[i].textureRect.width * 1.5f, aliens[i].textureRect.height * 1.5f };
+// Versus match: skips the title, the board is set up once the peer answers
+static bool StartVersus(void)
+{
+    if (!NetplayStart(&netConfig, (uint64_t)GetRandomValue(0, INT_MAX))) {
+        TraceLog(LOG_WARNING, "NET: Cannot start versus mode on port %d, falling back to single player", netConfig.port);
+        return false;
+    }
 
-            aliensAlive++;
+    for (int p = 0; p < VERSUS_PLAYERS; p++) {
+        for (int i = 0; i < NUM_SHIELDS; i++) {
+            if (shieldMasks[p][i].id == 0) shieldMasks[p][i] = LoadMaskTexture(SHIELD_TEX_WIDTH, SHIELD_TEX_HEIGHT);
         }
     }
 
-    alienMoveWaitTime = ALIEN_MOVE_WAIT_TIME_START / (1.0f + (currentWave - 1) * 0.2f); // Faster start on later waves
-    alienMoveTimer = alienMoveWaitTime;
-    alienDirection = 1;
-    moveDown = false;
-    alienMoveSoundIndex = 0;
-    alienShootTimer = GetRandomValue(ALIEN_SHOOT_INTERVAL_MIN * 100, ALIEN_SHOOT_INTERVAL_MAX * 100) / 100.0f;
+    tickAccumulator = 0.0f;
+    firePending = false;
+    currentScreen = GAMEPLAY;
+    TraceLog(LOG_INFO, "NET: Versus %s on port %d (simulated delay %d ms, loss %d%%)",
+             netConfig.host ? "hosting" : "joining", netConfig.port, netConfig.delayMs, netConfig.lossPercent);
+    return true;
 }
 
-void InitShields(void) {
-    float shieldSpacing = (SCREEN_WIDTH - (NUM_SHIELDS * shieldTexture.width * 2.0f)) / (NUM_SHIELDS + 1); // Scaled width
-    float shieldY = SCREEN_HEIGHT - 120.0f;
+// Board shown full screen: the local player's in versus mode
+static const Game *GetDisplayedGame(void)
+{
+    if (versusMode) return &versus.games[GetNetplayLocalPlayer()];
+    return simThreaded ? &view.game : &game;
+}
+
+// The match is over once a result stands on ticks with confirmed remote input, predictions could still undo it
+static bool IsVersusDecided(void)
+{
+    return (versus.result != VERSUS_PLAYING) && (GetNetplayStats().remoteLag == 0);
+}
 
+// Upload the shield rows the simulation changed since the last upload, straight from its occupancy
+static void SyncShieldTextures(Game *board, Texture2D *masks)
+{
     for (int i = 0; i < NUM_SHIELDS; i++) {
-        shields[i].baseTexture = shieldTexture;
-        // Create a render texture for each shield
-        shields[i].renderTexture = LoadRenderTexture(shields[i].baseTexture.width, shields[i].baseTexture.height);
-        shields[i].position = (Vector2){ shieldSpacing + i * (shields[i].baseTexture.width * 2.0f + shieldSpacing), shieldY };
-        shields[i].active = true;
-        shields[i].bounds = (Rectangle){ shields[i].position.x, shields[i].position.y, shields[i].baseTexture.width * 2.0f, shields[i].baseTexture.height * 2.0f }; // Scaled bounds
-
-        // Initial draw of the shield onto its render texture
-        BeginTextureMode(shields[i].renderTexture);
-            ClearBackground(BLANK); // Important: Clear with transparent
-            DrawTexture(shields[i].baseTexture, 0, 0, WHITE);
-        EndTextureMode();
+        ShieldDirty dirty = board->shieldDirty[i];
+        if (dirty.x0 > dirty.x1) continue;
+
+        UpdateMaskRows(masks[i], dirty.y0, dirty.y1 - dirty.y0 + 1, board->shields[i].alpha[dirty.y0]);
+        ClearShieldDirty(board, i);
     }
 }
 
+// Snapshots skip ticks and the dirty rects of the skipped ones, so the render thread finds the
+// changed texels itself by comparing with what it uploaded last
+static void SyncShieldSnapshot(Game *board)
+{
+    for (int i = 0; i < NUM_SHIELDS; i++) {
+        ShieldDirty dirty = { SHIELD_TEX_WIDTH, SHIELD_TEX_HEIGHT, -1, -1 };
+        for (int y = 0; y < SHIELD_TEX_HEIGHT; y++) {
+            for (int x = 0; x < SHIELD_TEX_WIDTH; x++) {
+                if (shieldUploadedValid && (board->shields[i].alpha[y][x] == shieldUploaded[i][y][x])) continue;
+                if (x < dirty.x0) dirty.x0 = x;
+                if (x > dirty.x1) dirty.x1 = x;
+                if (y < dirty.y0) dirty.y0 = y;
+                if (y > dirty.y1) dirty.y1 = y;
+            }
+        }
+        board->shieldDirty[i] = dirty;
+    }
+
+    SyncShieldTextures(board, shieldMasks[0]);
+
+    for (int i = 0; i < NUM_SHIELDS; i++) memcpy(shieldUploaded[i], board->shields[i].alpha, sizeof(shieldUploaded[i]));
+    shieldUploadedValid = true;
+}
+
 //----------------------------------------------------------------------------------
 // Module Functions Definition - Game Update
 //----------------------------------------------------------------------------------
+static GameInput ReadGameInput(void)
+{
+    GameInput input = { 0 };
+
+    input.left = IsKeyDown(KEY_LEFT) || IsKeyDown(KEY_A);
+    input.right = IsKeyDown(KEY_RIGHT) || IsKeyDown(KEY_D);
+
+    // Touch controls (simple half-screen) - Rely on Mouse Button Down for touch
+    // IsGestureDown(GESTURE_DRAG) is not a standard raylib function
+    if (IsMouseButtonDown(MOUSE_LEFT_BUTTON)) { // Mouse button down maps to touch press on web
+        Vector2 touchPos = GetMousePosition();
+        if (touchPos.x < SCREEN_WIDTH / 2) input.left = true;
+        else input.right = true;
+    }
+
+    input.fire = IsKeyPressed(KEY_SPACE) || IsGestureDetected(GESTURE_TAP); // Keep GESTURE_TAP for shooting
+    return input;
+}
+
 void UpdateGame(void)
 {
-    if (gameOver) {
+    if (spectating) {
+        UpdateSpectator();
+        return;
+    }
+
+    if (versusMode) {
+        UpdateVersusMatch(); // No pause, rewind or quick save: both peers must stay in lockstep
+        return;
+    }
+
+    if (simThreaded) {
+        UpdateThreadedGame();
+        return;
+    }
+
+    if (game.gameOver) {
         if (IsKeyPressed(KEY_ENTER) || IsGestureDetected(GESTURE_TAP)) {
             InitGame(); // Restart
         }
@@ -570,761 +560,497 @@ void UpdateGame(void)
         return; // Skip update if paused
     }
 
-    float delta = GetFrameTime();
-
-    // Player Control
-    if (player.explosionTimer <= 0) { // Only allow control if not exploding
-        if (IsKeyDown(KEY_LEFT) || IsKeyDown(KEY_A)) player.position.x -= PLAYER_SPEED;
-        if (IsKeyDown(KEY_RIGHT) || IsKeyDown(KEY_D)) player.position.x += PLAYER_SPEED;
+    if (IsKeyPressed(KEY_F5)) QuickSave();
+    if (IsKeyPressed(KEY_F9)) QuickLoad();
+    if (UpdateRewind()) return;
+
+    // Fixed-rate simulation so replays and hashes do not depend on the display refresh rate.
+    // Fire is edge-triggered, so a press on a frame that runs no tick waits for the next one.
+    GameInput input = ReadGameInput();
+    uint32_t inputSerial = GetLatencyInputSerial();
+    firePending |= input.fire;
+    tickAccumulator += GetTickFrameTime();
+
+    int ticks = 0;
+    while ((tickAccumulator >= GAME_TICK_TIME) && (ticks < MAX_TICKS_PER_FRAME) && !game.gameOver) {
+        input.fire = firePending;
+        firePending = false;
+        if (autopilot) input = GetAutopilotInput(&game); // Decided per tick from the state about to be updated
+
+        AdvanceGame(input);
+        tickInputSerial = inputSerial;
+        QueueGameEvents(&game);
+
+        tickAccumulator -= GAME_TICK_TIME;
+        ticks++;
+    }
+    if (ticks == MAX_TICKS_PER_FRAME) tickAccumulator = 0.0f;
 
-        // Touch controls (simple half-screen) - Rely on Mouse Button Down for touch
-        // IsGestureDown(GESTURE_DRAG) is not a standard raylib function
-        if (IsMouseButtonDown(MOUSE_LEFT_BUTTON)) { // Mouse button down maps to touch press on web
-             Vector2 touchPos = GetMousePosition();
-             if (touchPos.x < SCREEN_WIDTH / 2) player.position.x -= PLAYER_SPEED;
-             else player.position.x += PLAYER_SPEED;
-        }
+    if (game.score > hiScore) hiScore = game.score;
+    SyncShieldTextures(&game, shieldMasks[0]);
+}
 
+// With vsync at the tick rate every frame should run one tick. Clock jitter around GAME_TICK_TIME
+// would otherwise alternate frames of none and two, and an input sampled in the first waits a frame.
+static float GetTickFrameTime(void)
+{
+    float frameTime = GetFrameTime();
+    if (vsync && (fabsf(frameTime - GAME_TICK_TIME) < VSYNC_SNAP_TIME)) return GAME_TICK_TIME;
+    return frameTime;
+}
 
-        // Keep player on screen
-        if (player.position.x < 0) player.position.x = 0;
-        if (player.position.x > SCREEN_WIDTH - player.size.x) player.position.x = SCREEN_WIDTH - player.size.x;
+// One tick of the single player game and everything recorded from it
+static void AdvanceGame(GameInput input)
+{
+    UpdateGameState(&game, input);
+    SpectatePublish(&game);
+    RewindRecord(&game);
+    if (recordFile != NULL) ReplayRecord(&replay, input, &game);
+}
 
-        // Player Shooting
-        if (IsKeyPressed(KEY_SPACE) || IsGestureDetected(GESTURE_TAP)) { // Keep GESTURE_TAP for shooting
-            SpawnPlayerShot();
-        }
-    } else {
-        player.explosionTimer -= delta;
-        if (player.explosionTimer <= 0) {
-            player.lives--;
-            if (player.lives <= 0) {
-                gameOver = true;
-                // SaveHighScore(score);
-            } else {
-                // Reset player position for respawn
-                 player.position = (Vector2){ SCREEN_WIDTH / 2.0f - player.size.x / 2.0f, SCREEN_HEIGHT - player.size.y - 20.0f };
-                 // Add brief invincibility? (optional)
-            }
+// Same fixed-tick pacing, but every tick goes through the rollback session, which may also
+// re-simulate earlier ticks when the opponent's real input turns out different from the guess
+static void UpdateVersusMatch(void)
+{
+    GameInput input = ReadGameInput();
+    firePending |= input.fire;
+    tickAccumulator += GetTickFrameTime();
+
+    int ticks = 0;
+    while ((tickAccumulator >= GAME_TICK_TIME) && (ticks < MAX_TICKS_PER_FRAME)) {
+        input.fire = firePending && (currentScreen == GAMEPLAY);
+        if (autopilot && (currentScreen == GAMEPLAY)) input = GetAutopilotInput(&versus.games[GetNetplayLocalPlayer()]);
+
+        // Events are those of the newest tick only, re-simulated ticks never replay their sounds
+        if (NetplayAdvance(&versus, input, GetTime())) {
+            firePending = false;
+            QueueGameEvents(&versus.games[GetNetplayLocalPlayer()]);
+            SpectatePublish(&versus.games[GetNetplayLocalPlayer()]);
         }
-    }
-
-    UpdateAliens(delta);
-    UpdateBullets(delta);
-    UpdateUFO(delta);
-    UpdateExplosions(delta);
-    CheckCollisions();
 
-     // Check Win Condition (All aliens destroyed)
-    if (aliensAlive <= 0 && !ufo.active && player.explosionTimer <= 0) {
-        NextLevel();
+        tickAccumulator -= GAME_TICK_TIME;
+        ticks++;
     }
+    if (ticks == MAX_TICKS_PER_FRAME) tickAccumulator = 0.0f;
 
-    // Check Lose Condition (Aliens reach bottom)
-    for (int i = 0; i < NUM_ALIENS; i++) {
-        if (aliens[i].active) {
-            if (aliens[i].position.y + aliens[i].size.y >= player.position.y) {
-                 gameOver = true;
-                 PlaySound(explosionSound); // Player dies even if not shot
-                 // SaveHighScore(score);
-                 break;
-            }
-             // Check if aliens reached shield level
-            for(int s=0; s<NUM_SHIELDS; ++s) {
-                if (shields[s].active && CheckCollisionRecs((Rectangle){aliens[i].position.x, aliens[i].position.y, aliens[i].size.x, aliens[i].size.y}, shields[s].bounds)) {
-                   // Damage shield significantly or destroy it if aliens touch it
-                   DamageShield(s, (Vector2){aliens[i].position.x + aliens[i].size.x/2, aliens[i].position.y + aliens[i].size.y});
-                   DamageShield(s, (Vector2){aliens[i].position.x + aliens[i].size.x/2, aliens[i].position.y + aliens[i].size.y});
-                   DamageShield(s, (Vector2){aliens[i].position.x + aliens[i].size.x/2, aliens[i].position.y + aliens[i].size.y});
-                   // Maybe deactivate alien? Or let them pass through destroyed shields?
-                }
-            }
-        }
-    }
+    for (int p = 0; p < VERSUS_PLAYERS; p++) SyncShieldTextures(&versus.games[p], shieldMasks[p]);
 }
 
-void UpdateAliens(float delta) {
-    alienMoveTimer -= delta;
-
-    if (alienMoveTimer <= 0) {
-        moveDown = false;
-        float leftmost = SCREEN_WIDTH;
-        float rightmost = 0;
-
-        // Check bounds and find edges
-        for (int i = 0; i < NUM_ALIENS; i++) {
-            if (aliens[i].active) {
-                if (aliens[i].position.x < leftmost) leftmost = aliens[i].position.x;
-                if (aliens[i].position.x + aliens[i].size.x > rightmost) rightmost = aliens[i].position.x + aliens[i].size.x;
-            }
-        }
-
-        // Check if edge hit
-        if ((rightmost + alienHorizontalMove * alienDirection > SCREEN_WIDTH && alienDirection > 0) ||
-            (leftmost + alienHorizontalMove * alienDirection < 0 && alienDirection < 0)) {
-            alienDirection *= -1;
-            moveDown = true;
-        }
+// Viewer mode: the mirror game only changes through the stream, nothing is simulated here
+static void UpdateSpectator(void)
+{
+    if (!spectateEnded && !SpectateReceive(&game)) spectateEnded = true;
 
-        // Move aliens
-        for (int i = 0; i < NUM_ALIENS; i++) {
-            if (aliens[i].active) {
-                if (moveDown) {
-                    aliens[i].position.y += alienVerticalMove;
-                } else {
-                    aliens[i].position.x += alienHorizontalMove * alienDirection;
-                }
-                // Switch animation frame
-                aliens[i].currentFrame = !aliens[i].currentFrame;
-            }
-        }
+    if (game.score > hiScore) hiScore = game.score;
+    SyncShieldTextures(&game, shieldMasks[0]);
+}
 
-        // Play move sound
-        switch(alienMoveSoundIndex) {
-            case 0: PlaySound(fastInvaderSound1); break;
-            case 1: PlaySound(fastInvaderSound2); break;
-            case 2: PlaySound(fastInvaderSound3); break;
-            case 3: PlaySound(fastInvaderSound4); break;
-        }
-        alienMoveSoundIndex = (alienMoveSoundIndex + 1) % 4;
+// Threaded mode, render thread: keys become commands, the newest snapshot becomes what is drawn.
+// Held keys are sent when they change and fire on the press, so the tick that follows sees them
+// however long this frame takes to draw.
+static void UpdateThreadedGame(void)
+{
+    if ((currentScreen == GAMEPLAY) && IsKeyPressed(KEY_P)) SimPushCommand((SimCommand){ SIM_COMMAND_PAUSE });
+    if (!view.paused) {
+        if (IsKeyPressed(KEY_F5)) SimPushCommand((SimCommand){ SIM_COMMAND_QUICKSAVE });
+        if (IsKeyPressed(KEY_F9)) SimPushCommand((SimCommand){ SIM_COMMAND_QUICKLOAD });
 
-        // Reset timer
-        alienMoveTimer = alienMoveWaitTime;
+        bool rewind = IsKeyDown(KEY_BACKSPACE);
+        if ((rewind != sentRewind) && SimPushCommand((SimCommand){ SIM_COMMAND_REWIND, { 0 }, rewind })) sentRewind = rewind;
     }
 
-    // Alien Shooting Logic
-    alienShootTimer -= delta;
-    if (alienShootTimer <= 0 && aliensAlive > 0) {
-        int tries = 0;
-        bool shotFired = false;
-        while(tries < NUM_ALIENS && !shotFired) { // Limit tries to avoid infinite loop if logic fails
-            int shooterIndex = GetRandomValue(0, NUM_ALIENS - 1);
-
-            if (aliens[shooterIndex].active) {
-                // Check if this alien is clear below (simplification: just fire)
-                // More complex: Check if another alien is directly below it.
-                bool clearBelow = true;
-                /* // Optional: Check if blocked below
-                Rectangle shooterRect = { aliens[shooterIndex].position.x, aliens[shooterIndex].position.y, aliens[shooterIndex].size.x, aliens[shooterIndex].size.y };
-                for (int i = 0; i < NUM_ALIENS; i++) {
-                    if (i == shooterIndex || !aliens[i].active) continue;
-                    Rectangle otherRect = { aliens[i].position.x, aliens[i].position.y, aliens[i].size.x, aliens[i].size.y };
-                    // Check if 'other' is below and horizontally overlapping 'shooter'
-                    if (otherRect.y > shooterRect.y &&
-                        otherRect.x < shooterRect.x + shooterRect.width &&
-                        otherRect.x + otherRect.width > shooterRect.x) {
-                        clearBelow = false;
-                        break;
-                    }
-                }
-                */
+    GameInput input = ReadGameInput();
+    if ((input.fire || (input.left != sentInput.left) || (input.right != sentInput.right)) &&
+        SimPushCommand((SimCommand){ SIM_COMMAND_INPUT, input, GetLatencyInputSerial() })) sentInput = input;
 
-                if (clearBelow) {
-                    Vector2 shotPos = { aliens[shooterIndex].position.x + aliens[shooterIndex].size.x / 2 - alienBullets[0].size.x / 2,
-                                        aliens[shooterIndex].position.y + aliens[shooterIndex].size.y };
-                    SpawnAlienShot(shotPos);
-                    shotFired = true;
-                }
-            }
-             tries++;
-        }
+    const SimSnapshot *snapshot = (const SimSnapshot *)SimAcquireSnapshot();
+    if ((snapshot != NULL) && (snapshot->starts == simStartsSent)) view = *snapshot;
 
-        // Reset shoot timer with some randomness, scaling with fewer aliens
-        float shootIntervalMultiplier = ((float)aliensAlive / NUM_ALIENS) * 0.5f + 0.5f; // Becomes faster (0.5x to 1.0x interval) as aliens die
-        alienShootTimer = (GetRandomValue(ALIEN_SHOOT_INTERVAL_MIN * 100, ALIEN_SHOOT_INTERVAL_MAX * 100) / 100.0f) * shootIntervalMultiplier;
-        if (alienShootTimer < 0.1f) alienShootTimer = 0.1f; // Minimum interval cap
-    }
+    if (view.game.score > hiScore) hiScore = view.game.score;
+    SyncShieldSnapshot(&view.game);
 }
 
-
-void UpdateBullets(float delta) {
-    // Player Bullet
-    if (player.shotActive) {
-        player.shotPosition.y -= PLAYER_BULLET_SPEED;
-        if (player.shotPosition.y + player.shotSize.y < 0) {
-            player.shotActive = false;
-        }
-    }
-
-    // 5. Alien Shots vs Shields
-    for (int i = 0; i < MAX_ALIEN_BULLETS; i++)
-    {
-        if (!alienBullets[i].active) continue;
-        Rectangle bulletRect = {alienBullets[i].position.x, alienBullets[i].position.y,
-                                alienBullets[i].size.x, alienBullets[i].size.y};
-        for (int s = 0; s < NUM_SHIELDS; s++)
-        {
-#ifdef UNIT_TEST
+// Threaded mode, simulation thread: apply the queued commands, run one tick, publish a snapshot
+static void SimulationTick(void)
+{
+    SimCommand command;
+    while (SimPopCommand(&command)) {
+        switch (command.type) {
+            case SIM_COMMAND_INPUT:
             {
-                Vector2 wh; Color px;
-                if (TestAlienBulletShieldCollision(i, s, &wh, &px))
-                {
-                    assert(px.a > 10 && "UNIT_TEST: expected opaque pixel → damage");
-                    alienBullets[i].active = false;
-                    printf("[UNIT_TEST] calling DamageShield(%d)\n", s);
-                    DamageShield(s, wh);
-                }
-            }
-            break;
-#else
-            if (shields[s].active && CheckCollisionRecs(bulletRect, shields[s].bounds))
+                simInput.left = command.input.left;
+                simInput.right = command.input.right;
+                firePending |= command.input.fire;
+                simInputSerial = command.param;
+            } break;
+            case SIM_COMMAND_START:
             {
-                Vector2 worldHit = {bulletRect.x + bulletRect.width * 0.5f,
-                                     bulletRect.y + bulletRect.height};
-                Vector2 texHit = WorldToShieldTexCoords(s, worldHit);
-
-                Image texImg = LoadImageFromTexture(shields[s].renderTexture.texture);
-                Color px = GetImageColor(texImg, (int)texHit.x, (int)texHit.y);
-                UnloadImage(texImg);
-
-                if (px.a > 10)
-                {
-                    alienBullets[i].active = false;
-                    DamageShield(s, worldHit);
-                    SpawnExplosion(
-                        (Vector2){bulletRect.x + bulletRect.width*0.5f, bulletRect.y + bulletRect.height},
-                        shotExplosionTexture,
-                        (Rectangle){0,0,(float)shotExplosionTexture.width,(float)shotExplosionTexture.height},
-                        (Vector2){shotExplosionTexture.width, shotExplosionTexture.height}
-                    );
-                }
-                break;
-            }
-#endif
+                ResetSimulation(command.param);
+                simActive = true;
+                simStarts++;
+            } break;
+            case SIM_COMMAND_HALT: simActive = false; break;
+            case SIM_COMMAND_PAUSE: if (!game.gameOver) gamePaused = !gamePaused; break;
+            case SIM_COMMAND_REWIND:
+            {
+                rewinding = (command.param != 0);
+                if (rewinding) QueueGameEvent((GameEvent){ EVENT_UFO_GONE, 0 });
+                else ResyncUfoDrone();
+            } break;
+            case SIM_COMMAND_QUICKSAVE: QuickSave(); break;
+            case SIM_COMMAND_QUICKLOAD: QuickLoad(); break;
+            default: break;
         }
     }
 
-
-    // Alien Bullets
-    for (int i = 0; i < MAX_ALIEN_BULLETS; i++) {
-        if (alienBullets[i].active) {
-            alienBullets[i].position.y += alienBullets[i].speed; // Use individual speed if needed
-
-            // Animate alien bullet (simple example using rolling textures)
-            int frame = ((int)(GetTime() * 10.0f)) % 4; // Cycle through 4 frames based on time
-            switch(frame) {
-                case 0: alienBullets[i].texture = rollingTexture1; break;
-                case 1: alienBullets[i].texture = rollingTexture2; break;
-                case 2: alienBullets[i].texture = rollingTexture3; break;
-                case 3: alienBullets[i].texture = rollingTexture4; break;
-            }
-             alienBullets[i].textureRect = (Rectangle){0, 0, (float)alienBullets[i].texture.width, (float)alienBullets[i].texture.height};
-
-
-            if (alienBullets[i].position.y > SCREEN_HEIGHT) {
-                alienBullets[i].active = false;
-            }
+    if (simActive && rewinding) {
+        if (RewindStep(&game)) {
+            ReplayTruncate(&replay, (int)game.tick);
+            SpectatePublish(&game);
         }
     }
-}
-
-void UpdateUFO(float delta) {
-    if (!ufo.active) {
-        ufo.spawnTimer -= delta;
-#if 0        
-        if (ufo.spawnTimer <= 0) {
-             // Check chance every frame once timer is up
-             if (GetRandomValue(1, (int)(1.0f/UFO_SPAWN_CHANCE)) == 1) {
-                 SpawnUFO();
-             }
-             // Reset timer slightly so it doesn't check *every* frame forever
-              ufo.spawnTimer = 0.1f;
-        }
-#endif
-        if (ufo.spawnTimer <= 0) {
-            SpawnUFO();
-            // The timer will be reset automatically when this spawned UFO goes off-screen or is destroyed.
-        }
-        return;
+    else if (simActive && !gamePaused && !game.gameOver) {
+        GameInput input = simInput;
+        input.fire = firePending;
+        firePending = false;
+        if (autopilot) input = GetAutopilotInput(&game);
+
+        AdvanceGame(input);
+        tickInputSerial = simInputSerial;
+        QueueGameEvents(&game); // The sim thread is the only producer of the audio queue meanwhile
+        if (game.gameOver) SaveRecording();
     }
 
-    // UFO is active
-    ufo.position.x += ufo.speed * delta;
-    ufo.timeActive += delta;
+    SimSnapshot *snapshot = (SimSnapshot *)SimGetBackBuffer();
+    snapshot->game = game;
+    snapshot->starts = simStarts;
+    snapshot->paused = gamePaused;
+    snapshot->rewinding = rewinding;
+    snapshot->rewind = GetRewindStats();
+    snapshot->spectate = GetSpectateStats();
+    snapshot->inputSerial = tickInputSerial;
+    SimPublish();
+}
 
-    // Play UFO sound (restart periodically for classic effect)
-    if (fmodf(ufo.timeActive, 0.5f) < delta) { // Play roughly every 0.5 seconds
-         PlaySound(ufoLowSound); // Or alternate ufoLowSound
+// Hold BACKSPACE to run the game backwards one tick per frame, release to resume from there
+static bool UpdateRewind(void)
+{
+    bool wasRewinding = rewinding;
+    rewinding = IsKeyDown(KEY_BACKSPACE);
+    if (!rewinding) {
+        if (wasRewinding) ResyncUfoDrone();
+        return false;
     }
 
-
-    // Check if off screen
-    if (ufo.speed > 0 && ufo.position.x > SCREEN_WIDTH) {
-        ufo.active = false;
-         StopSound(ufoLowSound); // Stop sound when offscreen
-         ufo.spawnTimer = GetRandomValue(600, 1800) * delta; // Reset spawn timer
-    } else if (ufo.speed < 0 && ufo.position.x + ufo.size.x < 0) {
-        ufo.active = false;
-         StopSound(ufoLowSound);
-         ufo.spawnTimer = GetRandomValue(600, 1800) * delta;
+    if (IsKeyPressed(KEY_BACKSPACE)) QueueGameEvent((GameEvent){ EVENT_UFO_GONE, 0 }); // Silent while going backwards
+    if (RewindStep(&game)) {
+        ReplayTruncate(&replay, (int)game.tick); // The recording continues from the rewound tick
+        SpectatePublish(&game);
+        SyncShieldTextures(&game, shieldMasks[0]);
     }
+    tickAccumulator = 0.0f;
+    return true;
+}
 
-    // Update explosion if UFO was hit
-    if (ufo.exploding) {
-        ufo.explosionTimer -= delta;
-        if (ufo.explosionTimer <= 0) {
-            ufo.exploding = false;
-            ufo.active = false; // Deactivate fully after explosion
-            ufo.spawnTimer = GetRandomValue((int)(UFO_SPAWN_INTERVAL_MIN * 100), (int)(UFO_SPAWN_INTERVAL_MAX * 100)) / 100.0f; // Correct time-based reset
-        }
-    }
+static void SaveRecording(void)
+{
+    if ((recordFile == NULL) || (replay.tickCount == 0)) return;
 
+    if (SaveReplay(&replay, recordFile)) TraceLog(LOG_INFO, "GAME: Replay of %d ticks saved to %s", replay.tickCount, recordFile);
+    else TraceLog(LOG_WARNING, "GAME: Could not write replay %s", recordFile);
 }
 
-void UpdateExplosions(float delta) {
-    for(int i=0; i<MAX_EXPLOSIONS; ++i) {
-        if (explosions[i].active) {
-            explosions[i].timer -= delta;
-            if (explosions[i].timer <= 0) {
-                explosions[i].active = false;
-            }
-        }
-    }
+// The drone follows the UFO events; after a jump in time it is set from the state instead
+static void ResyncUfoDrone(void)
+{
+    bool flying = game.ufo.active && !game.ufo.exploding;
+    QueueGameEvent((GameEvent){ flying ? EVENT_UFO_SPAWN : EVENT_UFO_GONE, 0 });
 }
 
-void SpawnExplosion(Vector2 position, Texture2D tex, Rectangle texRect, Vector2 size) {
-    for(int i=0; i<MAX_EXPLOSIONS; ++i) {
-        if (!explosions[i].active) {
-            explosions[i].active = true;
-            explosions[i].position = (Vector2){position.x - size.x/2, position.y - size.y/2}; // Center explosion
-            explosions[i].texture = tex;
-            explosions[i].textureRect = texRect;
-            explosions[i].size = size;
-            explosions[i].timer = 0.3f; // Duration of explosion display
-            // Maybe play a generic small explosion sound here?
-            return; // Spawn only one
-        }
-    }
+static void QuickSave(void)
+{
+    unsigned char blob[GAME_STATE_MAX_SIZE];
+    int size = SaveState(&game, blob, sizeof(blob));
+
+    if ((size > 0) && SaveFileData(QUICKSAVE_FILE, blob, size)) TraceLog(LOG_INFO, "GAME: Quick saved %d bytes", size);
+    else TraceLog(LOG_WARNING, "GAME: Quick save failed");
 }
 
-void DamageShield(int shieldIndex, Vector2 hitPosition)
+static void QuickLoad(void)
 {
-    if (!shields[shieldIndex].active) return;
-    
-    Vector2 localHit = WorldToShieldTexCoords(shieldIndex, hitPosition);
-    const float damageRadius = 5.0f;
-    
-    // Get the texture image data
-    Image shieldImage = LoadImageFromTexture(shields[shieldIndex].renderTexture.texture);
-    
-    // Create a damage pattern in the image
-    for (int y = 0; y < shieldImage.height; y++) {
-        for (int x = 0; x < shieldImage.width; x++) {
-            float distance = sqrtf((x - localHit.x) * (x - localHit.x) + 
-                                  (y - localHit.y) * (y - localHit.y));
-            
-            if (distance <= damageRadius) {
-                // Make pixels transparent within the damage radius
-                Color* pixel = &((Color*)shieldImage.data)[y * shieldImage.width + x];
-                pixel->a = 0; // Set alpha to transparent
-            }
-        }
+    if (recordFile != NULL) {
+        TraceLog(LOG_WARNING, "GAME: Quick load is disabled while recording a replay");
+        return;
     }
-    
-    // Update the texture with the modified image data
-    UpdateTexture(shields[shieldIndex].renderTexture.texture, shieldImage.data);
-    
-    // Free the image data
-    UnloadImage(shieldImage);
-    
-    // Print for debugging
-    //printf("[UNIT_TEST] DamageShield(%d) hit=(%.1f,%.1f) tex=(%.1f,%.1f)\n",
-    //       shieldIndex, hitPosition.x, hitPosition.y, localHit.x, localHit.y);
-}
 
-#if 0
-// Gemini version
-void DamageShield(int shieldIndex, Vector2 hitPosition)
-{
-    if (!shields[shieldIndex].active) return;
+    int size = 0;
+    unsigned char *blob = LoadFileData(QUICKSAVE_FILE, &size);
+    if (blob == NULL) return;
 
-    Vector2 localHit = WorldToShieldTexCoords(shieldIndex, hitPosition);
+    if (LoadState(&game, blob, size)) {
+        RewindReset(&game);
+        ResyncUfoDrone();
+        TraceLog(LOG_INFO, "GAME: Quick loaded %d bytes (wave %d, score %d)", size, game.currentWave, game.score);
+    }
+    else TraceLog(LOG_WARNING, "GAME: %s is corrupt or from another version", QUICKSAVE_FILE);
 
-    const float damageRadius = 5.0f;
-    const float damageSize   = damageRadius * 2.0f;
+    UnloadFileData(blob);
+}
 
-    // Print for debugging
-    printf("[UNIT_TEST] DamageShield(%d) hit=(%.1f,%.1f) tex=(%.1f,%.1f)\n",
-           shieldIndex, hitPosition.x, hitPosition.y, localHit.x, localHit.y);
+// Debris of the board on screen: frozen while paused, no new bursts while rewinding
+static void UpdateParticleEffects(void)
+{
+    bool paused = simThreaded ? view.paused : gamePaused;
+    bool rewound = simThreaded ? view.rewinding : rewinding;
 
-    BeginTextureMode(shields[shieldIndex].renderTexture);
-        DrawRectangleRec((Rectangle){ localHit.x - damageRadius,
-                                      localHit.y - damageRadius,
-                                      damageSize, damageSize },
-                         BLANK);
-        // Draw a black circle for debugging
-        DrawCircle((int)localHit.x, (int)localHit.y, damageRadius, BLACK); 
-    EndTextureMode();
+    WatchBoardParticles(GetDisplayedGame(), !rewound);
+    if (!paused) UpdateParticles(GetFrameTime());
 }
-    #endif
-
-#if 0
-void DamageShield(int shieldIndex, Vector2 hitPosition) {
-    if (!shields[shieldIndex].active) return;
-
-    // Calculate hit position relative to the shield's render texture
-    Vector2 localHit;
-    localHit.x = hitPosition.x - shields[shieldIndex].position.x;
-    localHit.y = hitPosition.y - shields[shieldIndex].position.y;
-
-    // Scale local hit position to the original texture coordinates (since we scale drawing)
-    localHit.x /= (shields[shieldIndex].bounds.width / shields[shieldIndex].renderTexture.texture.width);
-    localHit.y /= (shields[shieldIndex].bounds.height / shields[shieldIndex].renderTexture.texture.height);
-
-
-    // Define the damage radius/size
-    float damageRadius = 5.0f; // Size of the hole to make (half-width of rectangle)
-    float damageSize = damageRadius * 2.0f; // Full width/height of rectangle
-
-    // Draw transparent rectangle onto the render texture at the hit location
-    BeginTextureMode(shields[shieldIndex].renderTexture);
-        // DrawRectangleBlend or DrawCircleBlend not standard, use DrawRectangleRec with BLANK
-        DrawRectangleRec(
-            (Rectangle){localHit.x - damageRadius, localHit.y - damageRadius, damageSize, damageSize},
-            BLANK // BLANK color makes the pixels transparent (Color){ 0, 0, 0, 0 }
-        );
-    EndTextureMode();
-    // Optional: Check if shield is destroyed (e.g., count transparent pixels - expensive!)
-    // Simpler: Deactivate after N hits (needs a counter per shield)
-}
-#endif
-
 
 //----------------------------------------------------------------------------------
-// Module Functions Definition - Collision Detection
+// Module Functions Definition - Game Drawing
 //----------------------------------------------------------------------------------
-void CheckCollisions() {
-
-    // --- Player Shot Collisions ---
-
-    if (player.shotActive) {
-        Rectangle playerShotRect = { player.shotPosition.x, player.shotPosition.y, player.shotSize.x, player.shotSize.y };
-
-        // 1. Player Shot vs Aliens
-        for (int i = 0; i < NUM_ALIENS; i++) {
-            if (aliens[i].active) {
-                Rectangle alienRect = { aliens[i].position.x, aliens[i].position.y, aliens[i].size.x, aliens[i].size.y };
-                if (CheckCollisionRecs(playerShotRect, alienRect)) {
-                    player.shotActive = false;
-                    aliens[i].active = false;
-                    aliensAlive--;
-                    score += aliens[i].points;
-                    if (score > hiScore) hiScore = score;
-
-                    SpawnExplosion(
-                        (Vector2){aliens[i].position.x + aliens[i].size.x/2, aliens[i].position.y + aliens[i].size.y/2},
-                        alienExplosionTexture,
-                        (Rectangle){0,0, (float)alienExplosionTexture.width, (float)alienExplosionTexture.height},
-                        (Vector2){(float)alienExplosionTexture.width * 1.5f, (float)alienExplosionTexture.height * 1.5f}
-                    );
-                    PlaySound(invaderKilledSound);
-                    alienMoveWaitTime *= ALIEN_MOVE_SPEEDUP_FACTOR;
-                    if (alienMoveWaitTime < 0.05f) alienMoveWaitTime = 0.05f;
-                    goto next_collision_check; // Exit alien loop once shot hits
-                }
-            }
-        }
-
-        // 2. Player Shot vs UFO
-        if (ufo.active && !ufo.exploding) {
-            Rectangle ufoRect = { ufo.position.x, ufo.position.y, ufo.size.x, ufo.size.y };
-            if (CheckCollisionRecs(playerShotRect, ufoRect)) {
-                player.shotActive = false;
-                ufo.exploding = true;
-                ufo.explosionTimer = 0.5f;
-                score += UFO_POINTS; // Using defined constant
-                if (score > hiScore) hiScore = score;
-                StopSound(ufoLowSound);
-                PlaySound(ufoExplosionSound);
-                goto next_collision_check; // Exit checks for this shot
-            }
-        }
-
-        // 3. Player Shot vs Shields
-        for (int i = 0; i < NUM_SHIELDS; i++) {
-            if (shields[i].active && CheckCollisionRecs(playerShotRect, shields[i].bounds)) {
-                Vector2 worldHit = { playerShotRect.x + playerShotRect.width * 0.5f, playerShotRect.y }; // Top of bullet
-                Vector2 texHit = WorldToShieldTexCoords(i, worldHit);
-
-                // Optimization: Avoid LoadImageFromTexture every frame if possible
-                // For now, keeping the precise check:
-                Image texImg = LoadImageFromTexture(shields[i].renderTexture.texture);
-                Color px = GetImageColor(texImg, (int)texHit.x, (int)texHit.y);
-                UnloadImage(texImg);
-
-                if (px.a > 10) { // Opaque pixel hit
-                    player.shotActive = false;
-                    DamageShield(i, worldHit);
-                    SpawnExplosion(worldHit, shotExplosionTexture,
-                                   (Rectangle){0, 0, (float)shotExplosionTexture.width, (float)shotExplosionTexture.height},
-                                   (Vector2){shotExplosionTexture.width * 1.5f, shotExplosionTexture.height * 1.5f});
-                    goto next_collision_check; // Exit shield loop and checks for this shot
-                }
-                // If transparent, bullet passes through
-            }
+// World objects of one board in screen coordinates, the caller picks the camera
+static void DrawBoard(const Game *board, const Texture2D *masks)
+{
+    // Draw Shields, coverage masks colored by the palette shader
+    BeginMaskDrawing();
+    for (int i = 0; i < NUM_SHIELDS; i++) {
+        if (board->shields[i].active) {
+            DrawTexturePro(masks[i],
+                           (Rectangle){ 0, 0, (float)masks[i].width, (float)masks[i].height },
+                           board->shields[i].bounds, // Destination rect (already scaled)
+                           (Vector2){ 0, 0 }, // Origin
+                           0.0f, shieldColor);
         }
     }
+    EndMaskDrawing();
 
-next_collision_check: // Label used by goto to skip further checks for the same player shot
-
-    // --- Alien Shot Collisions ---
-
-    // 4. Alien Shots vs Player   <--- THIS WAS THE MISSING PART
-    if (player.explosionTimer <= 0) { // Player can only be hit if not already exploding
-        Rectangle playerRect = { player.position.x, player.position.y, player.size.x, player.size.y };
-        for (int i = 0; i < MAX_ALIEN_BULLETS; i++) {
-            if (alienBullets[i].active) {
-                Rectangle bulletRect = { alienBullets[i].position.x, alienBullets[i].position.y, alienBullets[i].size.x, alienBullets[i].size.y };
-                if (CheckCollisionRecs(bulletRect, playerRect)) {
-                    alienBullets[i].active = false;
-                    player.explosionTimer = 1.0f; // Start player explosion timer
-                    PlaySound(explosionSound);    // Play player death sound
-                    // Lives are decremented in UpdateGame when the timer runs out
-                    break; // Player hit, no need to check other bullets against player this frame
-                }
-            }
-        }
-    } // End of Alien Shots vs Player Check
-
-
-    // 5. Alien Shots vs Shields
-    for (int i = 0; i < MAX_ALIEN_BULLETS; i++) {
-        if (!alienBullets[i].active) continue; // Skip inactive bullets or bullets that just hit the player
-
-        Rectangle bulletRect = { alienBullets[i].position.x, alienBullets[i].position.y, alienBullets[i].size.x, alienBullets[i].size.y };
-        for (int s = 0; s < NUM_SHIELDS; s++) {
-            if (shields[s].active && CheckCollisionRecs(bulletRect, shields[s].bounds)) {
-                Vector2 worldHit = { bulletRect.x + bulletRect.width * 0.5f, bulletRect.y + bulletRect.height }; // Bottom of bullet
-                Vector2 texHit = WorldToShieldTexCoords(s, worldHit);
-
-                Image texImg = LoadImageFromTexture(shields[s].renderTexture.texture);
-                Color px = GetImageColor(texImg, (int)texHit.x, (int)texHit.y);
-                UnloadImage(texImg);
-
-                if (px.a > 10) { // Opaque pixel hit
-                    alienBullets[i].active = false; // Deactivate bullet
-                    DamageShield(s, worldHit);
-                    SpawnExplosion(worldHit, shotExplosionTexture, // Use shot explosion for bullet hitting shield
-                                   (Rectangle){0, 0, (float)shotExplosionTexture.width, (float)shotExplosionTexture.height},
-                                   (Vector2){shotExplosionTexture.width, shotExplosionTexture.height}); // Maybe smaller explosion
-                    goto next_alien_bullet; // Stop checking this bullet against other shields
-                }
-                // If transparent, bullet passes through
+     // Draw Aliens, the whole formation in one instanced draw where the GPU allows
+    if (IsFormationRendererReady()) DrawFormation(board);
+    else {
+        for (int i = 0; i < NUM_ALIENS; i++) {
+            const Alien *alien = &board->aliens[i];
+            if (alien->active) {
+                Texture2D texture = GetAlienTexture(alien->type, alien->currentFrame);
+                DrawTexturePro(texture,
+                               (Rectangle){ 0, 0, (float)texture.width, (float)texture.height },
+                               (Rectangle){ alien->position.x, alien->position.y, alien->size.x, alien->size.y },
+                               (Vector2){ 0, 0 }, 0.0f, WHITE);
             }
         }
-    next_alien_bullet:; // Label used by goto
-    } // End of Alien Bullet Loop
-
-
-    // --- Alien vs Shield Collision (When aliens reach them) ---
-    // This logic is currently in UpdateGame() where aliens move down. It can stay there.
+    }
 
-} // End of CheckCollisions
+    // Draw Player
+    const Player *player = &board->player;
+    if (player->exploding) {
+        // Draw explosion centered on player pos
+         DrawTexturePro(playerExplosionTexture,
+                       (Rectangle){0,0, (float)playerExplosionTexture.width, (float)playerExplosionTexture.height},
+                       (Rectangle){ player->position.x + player->size.x/2 - playerExplosionTexture.width, // Center explosion roughly
+                                    player->position.y + player->size.y/2 - playerExplosionTexture.height,
+                                    (float)playerExplosionTexture.width * 2.0f, (float)playerExplosionTexture.height * 2.0f },
+                       (Vector2){ 0, 0 }, 0.0f, WHITE);
+    } else if (player->lives > 0) {
+        DrawTexturePro(playerTexture, (Rectangle){ 0, 0, (float)playerTexture.width, (float)playerTexture.height },
+                       (Rectangle){ player->position.x, player->position.y, player->size.x, player->size.y },
+                       (Vector2){ 0, 0 }, 0.0f, WHITE);
+    }
 
 
-void SpawnPlayerShot() {
-    if (!player.shotActive && player.explosionTimer <= 0) {
-        player.shotActive = true;
-        player.shotPosition.x = player.position.x + player.size.x / 2 - player.shotSize.x / 2;
-        player.shotPosition.y = player.position.y - player.shotSize.y;
-        PlaySound(shootSound);
+    // Draw Player Shot
+    if (player->shotActive) {
+         DrawTexturePro(playerShotTexture, (Rectangle){ 0, 0, (float)playerShotTexture.width, (float)playerShotTexture.height },
+                       (Rectangle){ player->shotPosition.x, player->shotPosition.y, player->shotSize.x, player->shotSize.y },
+                       (Vector2){ 0, 0 }, 0.0f, WHITE);
     }
-}
 
-void SpawnAlienShot(Vector2 position) {
+    // Draw Alien Shots, animated using the rolling textures
+    Texture2D alienShotFrame = rollingTexture1;
+    switch (((int)(GetTime() * 10.0f)) % 4) { // Cycle through 4 frames based on time
+        case 0: alienShotFrame = rollingTexture1; break;
+        case 1: alienShotFrame = rollingTexture2; break;
+        case 2: alienShotFrame = rollingTexture3; break;
+        case 3: alienShotFrame = rollingTexture4; break;
+    }
     for (int i = 0; i < MAX_ALIEN_BULLETS; i++) {
-        if (!alienBullets[i].active) {
-            alienBullets[i].active = true;
-            alienBullets[i].position = position;
-            // Add randomness to bullet type/speed later if needed
-            return; // Spawn only one
+        const Bullet *bullet = &board->alienBullets[i];
+        if (bullet->active) {
+            DrawTexturePro(alienShotFrame, (Rectangle){ 0, 0, (float)alienShotFrame.width, (float)alienShotFrame.height },
+                           (Rectangle){ bullet->position.x, bullet->position.y, bullet->size.x, bullet->size.y },
+                           (Vector2){ 0, 0 }, 0.0f, WHITE);
         }
     }
-}
 
-void SpawnUFO() {
-    ufo.active = true;
-    ufo.exploding = false;
-    ufo.explosionTimer = 0.0f;
-    ufo.timeActive = 0.0f;
-    // Random direction
-    if (GetRandomValue(0, 1) == 0) { // From left
-        ufo.position = (Vector2){ -ufo.size.x, 50.0f };
-        ufo.speed = UFO_SPEED;
-    } else { // From right
-        ufo.position = (Vector2){ SCREEN_WIDTH, 50.0f };
-        ufo.speed = -UFO_SPEED;
+    // Draw UFO
+    const UFO *ufo = &board->ufo;
+    if (ufo->active) {
+         if (ufo->exploding) {
+             // Draw UFO explosion centered
+             DrawTexturePro(ufoExplosionTexture, (Rectangle){ 0, 0, (float)ufoExplosionTexture.width, (float)ufoExplosionTexture.height },
+                           (Rectangle){ ufo->position.x + ufo->size.x/2 - ufoExplosionTexture.width*1.5f/2, // Center explosion
+                                        ufo->position.y + ufo->size.y/2 - ufoExplosionTexture.height*1.5f/2,
+                                        ufoExplosionTexture.width * 1.5f, ufoExplosionTexture.height * 1.5f },
+                           (Vector2){ 0, 0 }, 0.0f, WHITE);
+         } else {
+              DrawTexturePro(ufoTexture, (Rectangle){ 0, 0, (float)ufoTexture.width, (float)ufoTexture.height },
+                           (Rectangle){ ufo->position.x, ufo->position.y, ufo->size.x, ufo->size.y },
+                           (Vector2){ 0, 0 }, 0.0f, RED); // UFO is often red
+         }
     }
-     PlaySound(ufoLowSound); // Start sound
-}
-
-void ResetLevel(bool playerDied) {
-     // Reset aliens to top
-    InitAliens();
-    // Reset player position
-    player.position = (Vector2){ SCREEN_WIDTH / 2.0f - player.size.x / 2.0f, SCREEN_HEIGHT - player.size.y - 20.0f };
-    // Deactivate all bullets
-    player.shotActive = false;
-    for(int i=0; i<MAX_ALIEN_BULLETS; ++i) alienBullets[i].active = false;
-    // Deactivate UFO
-    ufo.active = false;
-    StopSound(ufoLowSound);
-    // Reset Shields (only if starting new game or new wave, not on player death?) - Classic game keeps shield damage.
-    // If we want to reset shields on death/new wave:
-    // for(int i=0; i<NUM_SHIELDS; ++i) UnloadRenderTexture(shields[i].renderTexture);
-    // InitShields();
-
-    // If player died, potentially keep score, decrease life (already handled by explosion timer end)
-    // If new wave, reset alien speed multiplier? No, it should persist within a game.
-}
 
-void NextLevel() {
-    currentWave++;
-    // Increase base speed slightly for the new wave? (Handled by InitAliens)
-    // Reset aliens
-    InitAliens();
-    // Reset player position
-    player.position = (Vector2){ SCREEN_WIDTH / 2.0f - player.size.x / 2.0f, SCREEN_HEIGHT - player.size.y - 20.0f };
-     // Deactivate bullets
-    player.shotActive = false;
-    for(int i=0; i<MAX_ALIEN_BULLETS; ++i) alienBullets[i].active = false;
-    // Reset UFO spawn timer potentially faster
-    ufo.spawnTimer = GetRandomValue((int)(UFO_SPAWN_INTERVAL_MIN * 100), (int)(UFO_SPAWN_INTERVAL_MAX * 100)) / 100.0f; 
-    // Reset shields? (Classic game keeps damage)
-    // If resetting shields:
-    for(int i=0; i<NUM_SHIELDS; ++i) UnloadRenderTexture(shields[i].renderTexture); // Unload old ones first
-    InitShields();
-
-    // Add brief "Wave X" message?
+     // Draw Explosions
+     for (int i = 0; i < MAX_EXPLOSIONS; i++) {
+        const Explosion *explosion = &board->explosions[i];
+        if (explosion->active) {
+            Texture2D texture = (explosion->type == EXPLOSION_ALIEN) ? alienExplosionTexture : shotExplosionTexture;
+            DrawTexturePro(texture, (Rectangle){ 0, 0, (float)texture.width, (float)texture.height },
+                           (Rectangle){ explosion->position.x, explosion->position.y, explosion->size.x, explosion->size.y },
+                           (Vector2){ 0, 0 }, 0.0f, WHITE);
+        }
+     }
 }
 
-
-//----------------------------------------------------------------------------------
-// Module Functions Definition - Game Drawing
-//----------------------------------------------------------------------------------
 void DrawGame(void)
 {
+    const Game *board = GetDisplayedGame();
+    bool finished = versusMode ? IsVersusDecided() : (board->gameOver && !spectating);
+    bool paused = simThreaded ? view.paused : gamePaused;
+    bool rewound = simThreaded ? view.rewinding : rewinding;
+
     BeginDrawing();
         ClearBackground(BLACK);
 
-        if (gameOver) {
-            DrawText("GAME OVER", SCREEN_WIDTH/2 - MeasureText("GAME OVER", 40)/2, SCREEN_HEIGHT/2 - 40, 40, RED);
-            DrawText(TextFormat("FINAL SCORE: %d", score), SCREEN_WIDTH/2 - MeasureText(TextFormat("FINAL SCORE: %d", score), 20)/2, SCREEN_HEIGHT/2 + 10, 20, RAYWHITE);
-            DrawText("PRESS [ENTER] or TAP TO RESTART", SCREEN_WIDTH/2 - MeasureText("PRESS [ENTER] or TAP TO RESTART", 20)/2, SCREEN_HEIGHT/2 + 40, 20, LIGHTGRAY);
+        if (finished && versusMode) {
+            int local = GetNetplayLocalPlayer();
+            bool won = (versus.result == ((local == 0) ? VERSUS_WIN_P1 : VERSUS_WIN_P2));
+            const char *title = (versus.result == VERSUS_DRAW) ? "DRAW" : (won ? "YOU WIN" : "YOU LOSE");
+            DrawText(title, SCREEN_WIDTH/2 - MeasureText(title, 40)/2, SCREEN_HEIGHT/2 - 40, 40, won ? GREEN : RED);
+            DrawText(TextFormat("SCORE: %d - %d", board->score, versus.games[1 - local].score), SCREEN_WIDTH/2 - MeasureText(TextFormat("SCORE: %d - %d", board->score, versus.games[1 - local].score), 20)/2, SCREEN_HEIGHT/2 + 10, 20, RAYWHITE);
+            DrawText("PRESS [ENTER] or TAP TO LEAVE", SCREEN_WIDTH/2 - MeasureText("PRESS [ENTER] or TAP TO LEAVE", 20)/2, SCREEN_HEIGHT/2 + 40, 20, LIGHTGRAY);
+        } else if (finished) {
+            DrawGameOverScreen(board->score);
+        } else if (spectating && !IsSpectateSynced()) {
+            const char *waiting = spectateEnded ? "STREAM ENDED" : "WAITING FOR STREAM...";
+            DrawText(waiting, SCREEN_WIDTH/2 - MeasureText(waiting, 20)/2, SCREEN_HEIGHT/2 - 10, 20, RAYWHITE);
+        } else if (versusMode && (GetNetplayStatus() == NETPLAY_CONNECTING)) {
+            const char *waiting = netConfig.host ? TextFormat("WAITING FOR OPPONENT ON PORT %d...", netConfig.port) : "CONNECTING TO HOST...";
+            DrawText(waiting, SCREEN_WIDTH/2 - MeasureText(waiting, 20)/2, SCREEN_HEIGHT/2 - 10, 20, RAYWHITE);
         } else {
-            // Draw Shields
-            for (int i = 0; i < NUM_SHIELDS; i++) {
-                if (shields[i].active) {
-                    // Draw the render texture, scaled up
-                    #if 1
-                    DrawTexturePro(shields[i].renderTexture.texture,
-                                   (Rectangle){ 0, 0, (float)shields[i].renderTexture.texture.width, (float)-shields[i].renderTexture.texture.height }, // Source rect, Y flipped!
-                                   shields[i].bounds, // Destination rect (already scaled)
-                                   (Vector2){ 0, 0 }, // Origin
-                                   0.0f, WHITE);
-                    #endif
-                }
+            const int local = versusMode ? GetNetplayLocalPlayer() : 0;
+            if (IsUpscalerReady()) {
+                BeginLowResBoard();
+                    DrawBoard(board, shieldMasks[local]);
+                    DrawParticles();
+                EndLowResBoard();
             }
-
-             // Draw Aliens
-            for (int i = 0; i < NUM_ALIENS; i++) {
-                if (aliens[i].active) {
-                    DrawTexturePro(aliens[i].currentFrame ? aliens[i].texture2 : aliens[i].texture1,
-                                   aliens[i].textureRect,
-                                   (Rectangle){ aliens[i].position.x, aliens[i].position.y, aliens[i].size.x, aliens[i].size.y },
-                                   (Vector2){ 0, 0 }, 0.0f, aliens[i].color);
-                }
+            else {
+                DrawBoard(board, shieldMasks[local]);
+                DrawParticles();
             }
 
-            // Draw Player
-            if (player.explosionTimer > 0) {
-                // Draw explosion centered on player pos
-                 DrawTexturePro(playerExplosionTexture,
-                               (Rectangle){0,0, (float)playerExplosionTexture.width, (float)playerExplosionTexture.height},
-                               (Rectangle){ player.position.x + player.size.x/2 - playerExplosionTexture.width, // Center explosion roughly
-                                            player.position.y + player.size.y/2 - playerExplosionTexture.height,
-                                            (float)playerExplosionTexture.width * 2.0f, (float)playerExplosionTexture.height * 2.0f },
-                               (Vector2){ 0, 0 }, 0.0f, WHITE);
-            } else if (player.lives > 0) {
-                DrawTexturePro(player.texture, player.textureRect,
-                               (Rectangle){ player.position.x, player.position.y, player.size.x, player.size.y },
-                               (Vector2){ 0, 0 }, 0.0f, WHITE);
-            }
-
-
-            // Draw Player Shot
-            if (player.shotActive) {
-                 DrawTexturePro(player.shotTexture, player.shotTextureRect,
-                               (Rectangle){ player.shotPosition.x, player.shotPosition.y, player.shotSize.x, player.shotSize.y },
-                               (Vector2){ 0, 0 }, 0.0f, WHITE);
+            // Draw UI: score, hi-score, lives and wave, cached until one of them changes
+            DrawHudStatus(board->score, hiScore, board->currentWave, board->player.lives);
+
+            if (versusMode) {
+                // Opponent board, quarter size in the top right corner
+                const Game *opponent = &versus.games[1 - local];
+                Camera2D camera = { .offset = { SCREEN_WIDTH*0.75f - 10, 40 }, .zoom = 0.25f };
+                DrawRectangle((int)camera.offset.x, (int)camera.offset.y, SCREEN_WIDTH/4, SCREEN_HEIGHT/4, Fade(DARKBLUE, 0.5f));
+                BeginMode2D(camera);
+                    DrawBoard(opponent, shieldMasks[1 - local]);
+                EndMode2D();
+                DrawRectangleLines((int)camera.offset.x, (int)camera.offset.y, SCREEN_WIDTH/4, SCREEN_HEIGHT/4, GRAY);
+                DrawText(TextFormat("OPPONENT %04d  LIVES %d", opponent->score, opponent->player.lives), (int)camera.offset.x + 4, (int)camera.offset.y + SCREEN_HEIGHT/4 + 4, 10, LIGHTGRAY);
+                DrawText(TextFormat("SENT %d  RECEIVED %d", versus.aliensSent[local], versus.aliensSent[1 - local]), 10, SCREEN_HEIGHT - 30, 20, LIGHTGRAY);
+                if (GetNetplayStatus() == NETPLAY_DESYNCED) DrawText("DESYNC", SCREEN_WIDTH/2 - MeasureText("DESYNC", 20)/2, 40, 20, RED);
             }
 
-            // Draw Alien Shots
-            for (int i = 0; i < MAX_ALIEN_BULLETS; i++) {
-                if (alienBullets[i].active) {
-                    DrawTexturePro(alienBullets[i].texture, alienBullets[i].textureRect,
-                                   (Rectangle){ alienBullets[i].position.x, alienBullets[i].position.y, alienBullets[i].size.x, alienBullets[i].size.y },
-                                   (Vector2){ 0, 0 }, 0.0f, WHITE);
-                }
+            if (spectating) {
+                DrawText(spectateEnded ? "SPECTATING - STREAM ENDED" : "SPECTATING", 10, SCREEN_HEIGHT - 30, 20, spectateEnded ? RED : SKYBLUE);
+                if (board->gameOver) DrawText("GAME OVER", SCREEN_WIDTH/2 - MeasureText("GAME OVER", 40)/2, SCREEN_HEIGHT/2 - 20, 40, RED);
             }
 
-            // Draw UFO
-            if (ufo.active) {
-                 if (ufo.exploding) {
-                     // Draw UFO explosion centered
-                     DrawTexturePro(ufo.explosionTexture, ufo.explosionTextureRect,
-                                   (Rectangle){ ufo.position.x + ufo.size.x/2 - ufo.explosionTexture.width*1.5f/2, // Center explosion
-                                                ufo.position.y + ufo.size.y/2 - ufo.explosionTexture.height*1.5f/2,
-                                                ufo.explosionTexture.width * 1.5f, ufo.explosionTexture.height * 1.5f },
-                                   (Vector2){ 0, 0 }, 0.0f, WHITE);
-                 } else {
-                      DrawTexturePro(ufo.texture, ufo.textureRect,
-                                   (Rectangle){ ufo.position.x, ufo.position.y, ufo.size.x, ufo.size.y },
-                                   (Vector2){ 0, 0 }, 0.0f, RED); // UFO is often red
-                 }
+            if (rewound) {
+                DrawText(TextFormat("<< REWIND %.1fs", (simThreaded ? view.rewind : GetRewindStats()).ticks/60.0f), 10, SCREEN_HEIGHT - 30, 20, YELLOW);
             }
 
-             // Draw Explosions
-             for(int i=0; i<MAX_EXPLOSIONS; ++i) {
-                if (explosions[i].active) {
-                    DrawTexturePro(explosions[i].texture, explosions[i].textureRect,
-                                   (Rectangle){ explosions[i].position.x, explosions[i].position.y, explosions[i].size.x, explosions[i].size.y },
-                                   (Vector2){ 0, 0 }, 0.0f, WHITE);
-                }
-             }
-
-
-            // Draw UI
-            DrawText(TextFormat("SCORE: %04d", score), 10, 10, 20, RAYWHITE);
-            DrawText(TextFormat("HI-SCORE: %04d", hiScore), SCREEN_WIDTH / 2 - MeasureText("HI-SCORE: 0000", 20)/2, 10, 20, RAYWHITE);
-            DrawText(TextFormat("WAVE: %d", currentWave), SCREEN_WIDTH - 100, SCREEN_HEIGHT - 30, 20, LIGHTGRAY);
-
-            // Draw Lives
-            for (int i = 0; i < player.lives; i++) {
-                DrawTextureEx(player.texture, (Vector2){ (float)(SCREEN_WIDTH - 110 + i * (player.texture.width * 0.7f + 5)), 10.0f }, 0.0f, 0.7f, WHITE);
-            }
-            if (player.lives > 0) DrawText("LIVES:", SCREEN_WIDTH - 110 - MeasureText("LIVES: ", 20), 10, 20, RAYWHITE);
-
-
-            if (gamePaused) {
+            if (paused) {
                 DrawText("PAUSED", SCREEN_WIDTH/2 - MeasureText("PAUSED", 40)/2, SCREEN_HEIGHT/2 - 20, 40, GRAY);
             }
         }
 
         // Draw FPS (optional)
         //DrawFPS(SCREEN_WIDTH - 90, 10);
+        DrawProfiler();
 
+        if (latencyMode) MarkLatencyFrame(simThreaded ? view.inputSerial : tickInputSerial);
     EndDrawing();
 }
 
+void DrawProfiler(void)
+{
+    if (!showProfiler) return;
+
+    MemStats mem = GetMemStats();
+    LedgerStats res = GetLedgerStats();
+    int lines = 9 + (versusMode ? 2 : 0) + ((spectateHost != NULL) ? 1 : 0) + (simThreaded ? 1 : 0) + (latencyMode ? 1 : 0);
+    DrawRectangle(8, 36, 260, 14*lines + 14, Fade(BLACK, 0.7f));
+    DrawText(TextFormat("FRAME: %.2f ms (%d FPS)", GetFrameTime() * 1000.0f, GetFPS()), 14, 40, 10, LIME);
+    DrawText(TextFormat("HEAP/FRAME: %d allocs, %d bytes", mem.frameAllocs, (int)mem.frameBytes), 14, 54, 10,
+             (mem.frameAllocs == 0) ? LIME : RED);
+    DrawText(TextFormat("HEAP LIVE: %d blocks, %d bytes", mem.liveAllocs, (int)mem.liveBytes), 14, 68, 10, LIME);
+    DrawText(TextFormat("TEXTURES: %d live, %d bytes", res.live[LEDGER_TEXTURE], res.liveBytes[LEDGER_TEXTURE]), 14, 82, 10, LIME);
+    HudStats hud = GetHudStats();
+    DrawText(TextFormat("RENDER TEXTURES: %d live, %d bytes (HUD redrawn %d)", res.live[LEDGER_RENDER_TEXTURE], res.liveBytes[LEDGER_RENDER_TEXTURE], hud.statusRedraws + hud.screenRedraws), 14, 96, 10,
+             (res.live[LEDGER_RENDER_TEXTURE] <= HUD_RENDER_TARGETS + (IsUpscalerReady() ? 1 : 0)) ? LIME : RED);
+    DrawText(TextFormat("SOUNDS: %d live, %d bytes", res.live[LEDGER_SOUND], res.liveBytes[LEDGER_SOUND]), 14, 110, 10, LIME);
+    RewindStats rewind = simThreaded ? view.rewind : GetRewindStats();
+    DrawText(TextFormat("REWIND: %d ticks, %d bytes (last %d)", rewind.ticks, rewind.bytesUsed, rewind.lastDeltaBytes), 14, 124, 10, LIME);
+    AudioStats audio = GetAudioStats();
+    DrawText(TextFormat("AUDIO: %d voices, %d played, %d merged, %d stolen, %d dropped", audio.voicesPlaying, audio.played, audio.merged, audio.stolen, audio.dropped), 14, 138, 10,
+             (audio.dropped == 0) ? LIME : ORANGE);
+    ParticleStats particles = GetParticleStats();
+    DrawText(TextFormat("PARTICLES: %d live, %d spawned, %d dropped", particles.live, particles.spawned, particles.dropped), 14, 152, 10,
+             (particles.dropped == 0) ? LIME : ORANGE);
+    int y = 166;
+    if (versusMode) {
+        NetplayStats net = GetNetplayStats();
+        DrawText(TextFormat("NET: lag %d, rollbacks %d (max %d), stalls %d", net.remoteLag, net.rollbacks, net.maxRollback, net.stalls), 14, y, 10,
+                 (net.desyncTick == 0) ? LIME : RED);
+        DrawText(TextFormat("NET: sent %d, dropped %d, received %d, hash ok %d", net.packetsSent, net.packetsDropped, net.packetsReceived, net.hashChecks), 14, y + 14, 10, LIME);
+        y += 28;
+    }
+    if (spectateHost != NULL) {
+        SpectateStats spectate = simThreaded ? view.spectate : GetSpectateStats();
+        DrawText(TextFormat("SPECTATE: %d viewers, %d B/tick, %d keyframes, %d dropped", spectate.viewers, spectate.lastMessageBytes, spectate.keyframes, spectate.dropped), 14, y, 10,
+                 (spectate.dropped == 0) ? LIME : ORANGE);
+        y += 14;
+    }
+    if (simThreaded) {
+        SimThreadStats sim = GetSimThreadStats();
+        DrawText(TextFormat("SIM THREAD: tick %.3f ms, dropped %d ticks", sim.lastTickMs, sim.droppedTicks), 14, y, 10,
+                 (sim.droppedTicks == 0) ? LIME : ORANGE);
+        y += 14;
+    }
+    if (latencyMode) {
+        LatencyStats latency = GetLatencyStats();
+        DrawText(TextFormat("LATENCY: p50 %.1f, p99 %.1f ms (%d), delay %.1f ms, missed %d", latency.p50Ms, latency.p99Ms, latency.samples, latency.frameDelayMs, latency.missedFrames), 14, y, 10,
+                 (latency.missedFrames == 0) ? LIME : ORANGE);
+    }
+}
+
 //----------------------------------------------------------------------------------
 // Module Functions Definition - Game Unloading
 //----------------------------------------------------------------------------------
 void UnloadGame(void)
 {
-    // Unload render textures
-    for(int i=0; i<NUM_SHIELDS; ++i) {
-        if (shields[i].renderTexture.id != 0) UnloadRenderTexture(shields[i].renderTexture);
+    // Unload shield masks
+    for (int p = 0; p < VERSUS_PLAYERS; p++) {
+        for (int i = 0; i < NUM_SHIELDS; i++) {
+            UnloadMaskTexture(shieldMasks[p][i]);
+            shieldMasks[p][i] = (Texture2D){ 0 };
+        }
     }
     // Resource unloading is handled separately in UnloadResources()
 }
@@ -1332,10 +1058,86 @@ void UnloadGame(void)
 //----------------------------------------------------------------------------------
 // Module Functions Definition - Update and Draw Frame Loop
 //----------------------------------------------------------------------------------
+// Title, single player game over and pause show a picture that only input changes. Versus, spectating
+// and the autopilot move on by themselves and always run at full rate.
+static bool IsIdleScreen(void)
+{
+    if (versusMode || spectating || autopilot) return false;
+    if ((currentScreen == TITLE) || (currentScreen == GAME_OVER)) return true;
+    return (currentScreen == GAMEPLAY) && (simThreaded ? view.paused : gamePaused);
+}
+
+// Latency samples come from single player games under the player's control
+static bool IsLatencyTracked(void)
+{
+    if (versusMode || spectating || autopilot || (currentScreen != GAMEPLAY)) return false;
+    return !(simThreaded ? view.paused : gamePaused);
+}
+
+// Anything the still screens react to, polled by the last frame
+static bool IsInputPending(void)
+{
+    return (GetKeyPressed() != 0) || IsKeyDown(KEY_BACKSPACE) || IsMouseButtonPressed(MOUSE_BUTTON_LEFT) ||
+           IsGestureDetected(GESTURE_TAP) || IsWindowResized();
+}
+
+// Still screens are not drawn again once they have settled: the frame only takes in input and the
+// loop slows down (sleeps on desktop, a slower timer on the web) until something happens
+static bool SkipIdleFrame(void)
+{
+    bool idle = IsIdleScreen();
+
+    if (!idle || IsInputPending() || (GetTime() - idleDrawTime >= IDLE_REFRESH_TIME)) idleFrames = 0;
+    bool skip = idle && (idleFrames >= IDLE_SETTLE_FRAMES);
+
+#if defined(PLATFORM_WEB)
+    static bool throttled = false;
+    if (skip != throttled) {
+        if (skip) emscripten_set_main_loop_timing(EM_TIMING_SETTIMEOUT, (int)(IDLE_POLL_TIME*1000));
+        else emscripten_set_main_loop_timing(EM_TIMING_RAF, 1);
+        throttled = skip;
+    }
+#else
+    if (skip) WaitTime(IDLE_POLL_TIME);
+#endif
+
+    if (skip) PollInputEvents(); // What EndDrawing() would have done
+    else if (idle) {
+        idleFrames++;
+        idleDrawTime = GetTime();
+    }
+    return skip;
+}
+
+#if defined(PLATFORM_WEB)
+// Time to the first frame, in the console, and sent back to the server when the page was opened
+// with ?budget (the startup check of make web-budget, see webbudget.c). The browser composites the
+// frame after this callback returns.
+static void ReportStartup(void)
+{
+    static bool reported = false;
+    if (reported) return;
+    reported = true;
+
+    double frameMs = emscripten_get_now();
+    TraceLog(LOG_INFO, "GAME: Startup, main() at %.0f ms, first frame at %.0f ms", startupMainMs, frameMs);
+    EM_ASM({
+        if (location.search.indexOf('budget') >= 0) fetch('/startup?main=' + Math.round($0) + '&frame=' + Math.round($1));
+    }, startupMainMs, frameMs);
+}
+#endif
+
 void UpdateDrawFrame(void)
 {
+    MemBeginFrame(); // Closes the heap counters of the previous frame
+    if (latencyMode) BeginLatencyFrame(IsLatencyTracked());
+    UpdateGameAudio(GetDisplayedGame()); // Sounds of the ticks since the last frame
+    if (SkipIdleFrame()) return;
+    if (latencyMode) WaitFrameDelay(IsInputPending()); // Input is sampled after this, right before the ticks
     framesCounter++;
 
+    if (IsKeyPressed(KEY_F1)) showProfiler = !showProfiler;
+
     switch(currentScreen)
     {
         case LOGO:
@@ -1355,34 +1157,25 @@ void UpdateDrawFrame(void)
         case TITLE:
         {
             if (IsKeyPressed(KEY_ENTER) || IsGestureDetected(GESTURE_TAP)) {
-                 // Reset necessary game state before starting gameplay
-                 InitAliens(); // Re-init aliens for first wave
-                 // Reset player lives and score if restarting from Title
-                 player.lives = 3;
-                 score = 0;
-                 currentWave = 1;
-                 // Reset shields completely
-                 for(int i=0; i<NUM_SHIELDS; ++i) UnloadRenderTexture(shields[i].renderTexture);
-                 InitShields();
+                 // New game: wave 1, full lives, zero score, intact shields (reuses the pooled render textures)
+                 StartGame();
 
                  currentScreen = GAMEPLAY;
             }
              BeginDrawing();
                 ClearBackground(BLACK);
-                DrawText("SPACE INVADERS", SCREEN_WIDTH/2 - MeasureText("SPACE INVADERS", 40)/2, SCREEN_HEIGHT/2 - 80, 40, GREEN);
-                DrawText("PRESS [ENTER] or TAP to START", SCREEN_WIDTH/2 - MeasureText("PRESS [ENTER] or TAP to START", 20)/2, SCREEN_HEIGHT/2 - 10, 20, RAYWHITE);
-                DrawText("CONTROLS:", 20, SCREEN_HEIGHT - 60, 20, LIGHTGRAY);
-                DrawText("ARROW KEYS / A / D / TOUCH SIDES: MOVE", 20, SCREEN_HEIGHT - 40, 20, LIGHTGRAY);
-                DrawText("SPACE / TAP: SHOOT", 20, SCREEN_HEIGHT - 20, 20, LIGHTGRAY);
-
+                DrawTitleScreen();
+                DrawProfiler();
             EndDrawing();
 
         } break;
         case GAMEPLAY:
         {
             UpdateGame();
+            UpdateParticleEffects();
             DrawGame();
-             if (gameOver) {
+             if (!spectating && (versusMode ? IsVersusDecided() : GetDisplayedGame()->gameOver)) {
+                if (!versusMode && !simThreaded) SaveRecording(); // The simulation thread saves on its own
                 currentScreen = GAME_OVER;
                 framesCounter = 0; // Reset timer for game over screen
             }
@@ -1393,21 +1186,42 @@ void UpdateDrawFrame(void)
             framesCounter++;
 
             // Draw Game Over Screen (already done in DrawGame when gameOver is true, but can add overlays here)
+            UpdateParticleEffects();
             DrawGame(); // Keep drawing the final state
 
+            if (versusMode) UpdateVersusMatch(); // Keep answering the peer until it has seen the end too
+            // Rewinding out of the final tick brings the game back to life
+            else if (simThreaded) {
+                UpdateThreadedGame();
+                if (!view.game.gameOver) currentScreen = GAMEPLAY;
+            }
+            else if (UpdateRewind() && !game.gameOver) currentScreen = GAMEPLAY;
+
              // Add specific Game Over overlays if needed
             // if ((framesCounter/30)%2) // Flashing text example
             // {
             //     DrawText("PRESS [ENTER] or TAP TO RESTART", GetScreenWidth()/2 - MeasureText("PRESS [ENTER] or TAP TO RESTART", 20)/2, GetScreenHeight()/2 + 40, 20, YELLOW);
             // }
 
-             if (IsKeyPressed(KEY_ENTER) || IsGestureDetected(GESTURE_TAP))
+            if (autopilot && !versusMode && (framesCounter > 120)) {
+                StartGame(); // Next soak game after a short look at the final board
+                framesCounter = 0;
+                currentScreen = GAMEPLAY;
+            }
+            else if (IsKeyPressed(KEY_ENTER) || IsGestureDetected(GESTURE_TAP))
             {
+                if (versusMode) {
+                    NetplayStop();
+                    versusMode = false;
+                }
                 InitGame(); // Reinitialize everything
                 currentScreen = TITLE; // Go back to title
             }
         } break;
         default: break;
     }
-}
 
+#if defined(PLATFORM_WEB)
+    ReportStartup();
+#endif
+}
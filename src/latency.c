@@ -0,0 +1,232 @@
+#include "raylib.h"
+#include "latency.h"
+#include <stdlib.h> // For qsort()
+#include <string.h> // For memcpy()
+
+//----------------------------------------------------------------------------------
+// Defines
+//----------------------------------------------------------------------------------
+#define MISSED_FRAME_FACTOR     1.5     // Presents further apart than this many refresh periods missed one
+#define FRAME_DELAY_TUNE_FRAMES 30      // Auto delay: frames per adjustment
+#define FRAME_DELAY_STEP_MS     1.0f    // Auto delay: largest increase per adjustment, and the back-off on a miss
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef struct PendingEvent {
+    uint32_t serial;
+    double time;                        // Poll that saw it
+} PendingEvent;
+
+//------------------------------------------------------------------------------------
+// Global Variables Declaration
+//------------------------------------------------------------------------------------
+static LatencyConfig settings = { 0 };
+static bool pacing = false;             // WaitFrameDelay() waits: a frame delay or the limiter
+static double period = 1.0/60;          // Refresh period (vsync) or limiter period, seconds
+static float frameDelayMs = 0.0f;
+static double frameDeadline = 0.0;      // Limiter: when the next frame may start
+
+static bool tracking = false;           // This frame's events are counted
+static GameInput lastInput = { 0 };     // Held keys at the last poll
+static uint32_t inputSerial = 0;
+static PendingEvent pending[LATENCY_MAX_PENDING] = { 0 };   // Oldest first
+static int pendingCount = 0;
+static double lastPoll = 0.0;
+static double frameStart = 0.0;         // BeginLatencyFrame(): right after the last frame's EndDrawing()
+static double sampleTime = 0.0;         // Last poll before the frame's work
+
+static bool frameMarked = false;        // MarkLatencyFrame() was called since BeginLatencyFrame()
+static uint32_t shownSerial = 0;
+static bool presentValid = false;       // lastPresent is the frame right before
+static double lastPresent = 0.0;
+
+static float samples[LATENCY_WINDOW] = { 0 };   // Ring, milliseconds
+static LatencyStats stats = { 0 };
+static double gapSum = 0.0;             // Poll to previous poll, summed over the events
+static int gapCount = 0;
+static int tuneFrames = 0;
+static float tuneWorkMax = 0.0f;
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+void InitLatency(const LatencyConfig *config)
+{
+    settings = *config;
+    frameDelayMs = (settings.frameDelayMs > 0.0f) ? settings.frameDelayMs : 0.0f;
+
+    int refresh = settings.vsync ? GetMonitorRefreshRate(GetCurrentMonitor()) : settings.targetFPS;
+    period = 1.0/((refresh > 0) ? refresh : 60);
+    if (frameDelayMs > period*1000.0 - FRAME_DELAY_MARGIN_MS) frameDelayMs = (float)(period*1000.0 - FRAME_DELAY_MARGIN_MS);
+    if (frameDelayMs < 0.0f) frameDelayMs = 0.0f;
+
+#if defined(PLATFORM_WEB)
+    pacing = false; // The browser calls the frames, a wait inside one only delays everything
+#else
+    pacing = settings.vsync ? ((frameDelayMs > 0.0f) || settings.autoFrameDelay) : (settings.targetFPS > 0);
+#endif
+
+    stats = (LatencyStats){ 0 };
+    pendingCount = 0;
+    inputSerial = 0;
+    frameMarked = presentValid = false;
+    gapSum = 0.0;
+    gapCount = 0;
+    tuneFrames = 0;
+    tuneWorkMax = 0.0f;
+    lastPoll = frameDeadline = GetTime();
+
+    TraceLog(LOG_INFO, "GAME: Latency tracking, %s at %.1f Hz, frame delay %s%.1f ms", settings.vsync ? "vsync" : "limiter",
+             1.0/period, settings.autoFrameDelay ? "auto from " : "", frameDelayMs);
+}
+
+// Input of the poll just made: a fire press or a held key changing is a new event
+static void RecordPoll(double now)
+{
+    GameInput input = settings.readInput();
+    bool changed = input.fire || (input.left != lastInput.left) || (input.right != lastInput.right);
+    lastInput = input;
+
+    if (changed && tracking) {
+        if (pendingCount == LATENCY_MAX_PENDING) {
+            memmove(pending, pending + 1, (LATENCY_MAX_PENDING - 1)*sizeof(PendingEvent));
+            pendingCount--;
+            stats.dropped++;
+        }
+        pending[pendingCount++] = (PendingEvent){ ++inputSerial, now };
+        gapSum += now - lastPoll;
+        gapCount++;
+    }
+    lastPoll = now;
+    sampleTime = now;
+}
+
+// Auto delay: as late as the slowest frame of the last window allows, creeping up by steps
+static void TuneFrameDelay(void)
+{
+    if (stats.workMs > tuneWorkMax) tuneWorkMax = stats.workMs;
+    if (++tuneFrames < FRAME_DELAY_TUNE_FRAMES) return;
+
+    float room = (float)(period*1000.0) - tuneWorkMax - FRAME_DELAY_MARGIN_MS;
+    if (room < 0.0f) room = 0.0f;
+    if (room < frameDelayMs) frameDelayMs = room;
+    else frameDelayMs = (frameDelayMs + FRAME_DELAY_STEP_MS < room) ? frameDelayMs + FRAME_DELAY_STEP_MS : room;
+
+    tuneFrames = 0;
+    tuneWorkMax = 0.0f;
+}
+
+void BeginLatencyFrame(bool track)
+{
+    if (settings.readInput == NULL) return;
+    double now = GetTime();
+
+    if (frameMarked) {
+        // That frame is out: everything its board had applied has been presented
+        int kept = 0;
+        for (int i = 0; i < pendingCount; i++) {
+            if ((int32_t)(pending[i].serial - shownSerial) <= 0) {
+                samples[stats.samples%LATENCY_WINDOW] = (float)((now - pending[i].time)*1000.0);
+                stats.samples++;
+            }
+            else pending[kept++] = pending[i];
+        }
+        pendingCount = kept;
+
+        if (presentValid && settings.vsync && (now - lastPresent > MISSED_FRAME_FACTOR*period)) {
+            stats.missedFrames++;
+            if (settings.autoFrameDelay) {
+                frameDelayMs = (frameDelayMs > FRAME_DELAY_STEP_MS) ? frameDelayMs - FRAME_DELAY_STEP_MS : 0.0f;
+                tuneFrames = 0;
+                tuneWorkMax = 0.0f;
+            }
+        }
+        else if (settings.autoFrameDelay) TuneFrameDelay();
+
+        lastPresent = now;
+        presentValid = true;
+    }
+    else presentValid = false;
+    frameMarked = false;
+
+    // Menus and pause: nothing is ticked, the waiting events say nothing about latency
+    tracking = track;
+    if (!tracking) pendingCount = 0;
+
+    int kept = 0;
+    for (int i = 0; i < pendingCount; i++) {
+        if (now - pending[i].time > LATENCY_MAX_AGE) stats.dropped++;
+        else pending[kept++] = pending[i];
+    }
+    pendingCount = kept;
+
+    frameStart = now;
+    RecordPoll(now); // EndDrawing() polled last thing before returning
+}
+
+void WaitFrameDelay(bool inputPending)
+{
+    if (!pacing || (settings.readInput == NULL)) return;
+
+    double now = GetTime();
+    double wake = frameStart + frameDelayMs/1000.0;
+    if (!settings.vsync) {
+        wake = frameDeadline;
+        frameDeadline = ((now > wake + period) ? now : wake) + period; // More than a frame behind: the schedule starts over
+    }
+    if (inputPending || (now >= wake)) return;
+
+    WaitTime(wake - now);
+    PollInputEvents();
+    RecordPoll(GetTime());
+}
+
+uint32_t GetLatencyInputSerial(void)
+{
+    return inputSerial;
+}
+
+void MarkLatencyFrame(uint32_t serial)
+{
+    if (settings.readInput == NULL) return;
+    shownSerial = serial;
+    frameMarked = true;
+    stats.workMs = (float)((GetTime() - sampleTime)*1000.0);
+}
+
+static int CompareFloats(const void *a, const void *b)
+{
+    return (*(const float *)a > *(const float *)b) - (*(const float *)a < *(const float *)b);
+}
+
+// Nearest rank percentiles over the window
+LatencyStats GetLatencyStats(void)
+{
+    static float sorted[LATENCY_WINDOW];
+    LatencyStats result = stats;
+    result.frameDelayMs = frameDelayMs;
+
+    int count = (stats.samples < LATENCY_WINDOW) ? stats.samples : LATENCY_WINDOW;
+    if (count > 0) {
+        memcpy(sorted, samples, count*sizeof(float));
+        qsort(sorted, count, sizeof(float), CompareFloats);
+        result.p50Ms = sorted[(count - 1)/2];
+        result.p90Ms = sorted[(count - 1)*9/10];
+        result.p99Ms = sorted[(count - 1)*99/100];
+        result.maxMs = sorted[count - 1];
+    }
+    if (gapCount > 0) result.eventGapMs = (float)(gapSum/gapCount*1000.0);
+    return result;
+}
+
+void LogLatencyReport(void)
+{
+    if (settings.readInput == NULL) return;
+    LatencyStats report = GetLatencyStats();
+
+    TraceLog(LOG_INFO, "GAME: Latency, %d inputs shown (%d dropped), poll to present p50 %.1f ms, p90 %.1f ms, p99 %.1f ms, max %.1f ms",
+             report.samples, report.dropped, report.p50Ms, report.p90Ms, report.p99Ms, report.maxMs);
+    TraceLog(LOG_INFO, "GAME: Latency, %.1f ms between polls around an input, frame delay %.1f ms, %d missed refreshes",
+             report.eventGapMs, report.frameDelayMs, report.missedFrames);
+}
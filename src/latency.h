@@ -0,0 +1,66 @@
+#ifndef LATENCY_H
+#define LATENCY_H
+
+// Input-to-present latency and late input sampling. Every change of the game input (a held key
+// going down or up, fire) is stamped with the time of the poll that saw it and numbered; the game
+// hands that number to the tick that applies it, and the first frame presented with that tick (or
+// a later one) closes the sample. Presents are taken when EndDrawing() returns, so the swap has
+// been issued; scanout and the display's own processing come on top.
+//  - frame delay: with vsync the swap returns at the start of a refresh, input polled right then is
+//    a whole frame old by the time the next one shows it. Waiting after the present, polling again
+//    and only then ticking and drawing moves the sample closer to the flip by the delay. "auto"
+//    keeps the delay just under the refresh period minus the slowest recent frame, and backs off
+//    when a refresh is missed
+//  - without vsync the frame limiter runs here too (raylib's waits between the swap and the poll),
+//    so the measured present is the swap and not the end of the wait
+//  - a frame that already polled a press skips the wait: the second poll would drop that edge
+// Events are only seen at polls, the time they spent queued before one is not in the numbers
+// (eventGapMs, the time since the previous poll, bounds it).
+
+#include "raylib.h"
+#include "game.h"
+
+//----------------------------------------------------------------------------------
+// Defines
+//----------------------------------------------------------------------------------
+#define LATENCY_WINDOW          512     // Samples kept for the percentiles
+#define LATENCY_MAX_PENDING     32      // Input events waiting for their frame
+#define LATENCY_MAX_AGE         0.5     // Seconds: events not shown by then are dropped (pause, menus)
+#define FRAME_DELAY_MARGIN_MS   2.0f    // Auto delay leaves this much beyond the slowest recent frame
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef struct LatencyConfig {
+    bool vsync;                         // Frames are paced by the swap (FLAG_VSYNC_HINT, no limiter)
+    float frameDelayMs;                 // With vsync: wait after each present before sampling input
+    bool autoFrameDelay;                // Tune the delay from the frame times, starting at frameDelayMs
+    int targetFPS;                      // Without vsync: frame limiter rate, 0 leaves pacing to the caller
+    GameInput (*readInput)(void);       // Keyboard/touch state as the game reads it
+} LatencyConfig;
+
+typedef struct LatencyStats {
+    int samples;                        // Input events shown since start
+    int dropped;                        // Events that timed out before a frame showed them
+    float p50Ms, p90Ms, p99Ms, maxMs;   // Poll to present, over the last LATENCY_WINDOW samples
+    float eventGapMs;                   // Mean time between the poll that saw an event and the poll before
+    float workMs;                       // Input sample to EndDrawing() of the last frame
+    float frameDelayMs;                 // Current delay after the present (vsync)
+    int missedFrames;                   // Presents more than 1.5 refresh periods apart (vsync)
+} LatencyStats;
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+void InitLatency(const LatencyConfig *config);  // After InitWindow()
+
+// Frame loop, in this order
+void BeginLatencyFrame(bool track);         // First thing in the frame: closes the samples of the last present, reads the input of its poll
+void WaitFrameDelay(bool inputPending);     // Before anything reads input: waits (delay or limiter) and polls again, unless inputPending
+uint32_t GetLatencyInputSerial(void);       // Newest input event, passed to the tick that applies the input
+void MarkLatencyFrame(uint32_t shownSerial);    // Right before EndDrawing(): newest input event the drawn board has applied
+
+LatencyStats GetLatencyStats(void);
+void LogLatencyReport(void);                // Summary through TraceLog(), at exit
+
+#endif // LATENCY_H
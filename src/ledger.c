@@ -0,0 +1,170 @@
+#include "ledger.h"
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef struct LedgerEntry {
+    LedgerKind kind;
+    const void *handle;     // GL id (as pointer-sized key) for textures, audio buffer for sounds
+    int bytes;
+    const char *file;       // Load site
+    int line;
+    bool live;
+} LedgerEntry;
+
+//------------------------------------------------------------------------------------
+// Global Variables Declaration
+//------------------------------------------------------------------------------------
+static LedgerEntry entries[LEDGER_MAX_ENTRIES] = { 0 };
+static LedgerStats stats = { 0 };
+
+static const char *kindNames[LEDGER_KIND_COUNT] = { "texture", "render texture", "sound", "audio stream" };
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition - Internal
+//----------------------------------------------------------------------------------
+static const void *TextureKey(unsigned int id) { return (const void *)(size_t)id; }
+
+static void LedgerAdd(LedgerKind kind, const void *handle, int bytes, const char *file, int line)
+{
+    // Reuse released slots first so long sessions never run out of entries
+    for (int i = 0; i < LEDGER_MAX_ENTRIES; i++) {
+        if (!entries[i].live) {
+            entries[i] = (LedgerEntry){ kind, handle, bytes, file, line, true };
+            stats.live[kind]++;
+            stats.liveBytes[kind] += bytes;
+            stats.created++;
+            return;
+        }
+    }
+
+    TraceLog(LOG_WARNING, "LEDGER: Table full, %s from %s:%d is untracked", kindNames[kind], file, line);
+}
+
+static void LedgerRemove(LedgerKind kind, const void *handle, const char *file, int line)
+{
+    for (int i = 0; i < LEDGER_MAX_ENTRIES; i++) {
+        if (entries[i].live && (entries[i].kind == kind) && (entries[i].handle == handle)) {
+            entries[i].live = false;
+            stats.live[kind]--;
+            stats.liveBytes[kind] -= entries[i].bytes;
+            stats.destroyed++;
+            return;
+        }
+    }
+
+    stats.badUnloads++;
+    TraceLog(LOG_WARNING, "LEDGER: Unload of unknown or already released %s at %s:%d", kindNames[kind], file, line);
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition - Tracked loaders
+//----------------------------------------------------------------------------------
+Texture2D LedgerLoadTexture(const char *fileName, const char *file, int line)
+{
+    Texture2D texture = LoadTexture(fileName);
+    if (texture.id != 0) {
+        LedgerAdd(LEDGER_TEXTURE, TextureKey(texture.id),
+                  GetPixelDataSize(texture.width, texture.height, texture.format), file, line);
+    }
+    return texture;
+}
+
+Texture2D LedgerLoadTextureFromImage(Image image, const char *file, int line)
+{
+    Texture2D texture = LoadTextureFromImage(image);
+    if (texture.id != 0) {
+        LedgerAdd(LEDGER_TEXTURE, TextureKey(texture.id),
+                  GetPixelDataSize(texture.width, texture.height, texture.format), file, line);
+    }
+    return texture;
+}
+
+RenderTexture2D LedgerLoadRenderTexture(int width, int height, const char *file, int line)
+{
+    RenderTexture2D target = LoadRenderTexture(width, height);
+    if (target.id != 0) {
+        // Color attachment plus the 24-bit depth renderbuffer raylib attaches (padded to 32 bits)
+        int bytes = GetPixelDataSize(width, height, target.texture.format) + width * height * 4;
+        LedgerAdd(LEDGER_RENDER_TEXTURE, TextureKey(target.id), bytes, file, line);
+    }
+    return target;
+}
+
+static Sound TrackSound(Sound sound, const char *file, int line)
+{
+    if (sound.stream.buffer != NULL) {
+        int bytes = (int)(sound.frameCount * sound.stream.channels * (sound.stream.sampleSize / 8));
+        LedgerAdd(LEDGER_SOUND, sound.stream.buffer, bytes, file, line);
+    }
+    return sound;
+}
+
+Sound LedgerLoadSound(const char *fileName, const char *file, int line)
+{
+    return TrackSound(LoadSound(fileName), file, line);
+}
+
+Sound LedgerLoadSoundFromWave(Wave wave, const char *file, int line)
+{
+    return TrackSound(LoadSoundFromWave(wave), file, line);
+}
+
+AudioStream LedgerLoadAudioStream(unsigned int sampleRate, unsigned int sampleSize, unsigned int channels, const char *file, int line)
+{
+    AudioStream stream = LoadAudioStream(sampleRate, sampleSize, channels);
+    if (stream.buffer != NULL) LedgerAdd(LEDGER_AUDIO_STREAM, stream.buffer, 0, file, line); // Filled block by block
+    return stream;
+}
+
+void LedgerUnloadTexture(Texture2D texture, const char *file, int line)
+{
+    if (texture.id == 0) return;
+    LedgerRemove(LEDGER_TEXTURE, TextureKey(texture.id), file, line);
+    UnloadTexture(texture);
+}
+
+void LedgerUnloadRenderTexture(RenderTexture2D target, const char *file, int line)
+{
+    if (target.id == 0) return;
+    LedgerRemove(LEDGER_RENDER_TEXTURE, TextureKey(target.id), file, line);
+    UnloadRenderTexture(target);
+}
+
+void LedgerUnloadSound(Sound sound, const char *file, int line)
+{
+    if (sound.stream.buffer == NULL) return;
+    LedgerRemove(LEDGER_SOUND, sound.stream.buffer, file, line);
+    UnloadSound(sound);
+}
+
+void LedgerUnloadAudioStream(AudioStream stream, const char *file, int line)
+{
+    if (stream.buffer == NULL) return;
+    LedgerRemove(LEDGER_AUDIO_STREAM, stream.buffer, file, line);
+    UnloadAudioStream(stream);
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition - Reporting
+//----------------------------------------------------------------------------------
+LedgerStats GetLedgerStats(void)
+{
+    return stats;
+}
+
+int LedgerReportLeaks(void)
+{
+    int leaks = 0;
+
+    for (int i = 0; i < LEDGER_MAX_ENTRIES; i++) {
+        if (entries[i].live) {
+            TraceLog(LOG_WARNING, "LEDGER: Leaked %s (%d bytes) loaded at %s:%d",
+                     kindNames[entries[i].kind], entries[i].bytes, entries[i].file, entries[i].line);
+            leaks++;
+        }
+    }
+
+    if (leaks == 0) TraceLog(LOG_INFO, "LEDGER: No leaks (%d loads, %d unloads)", stats.created, stats.destroyed);
+    return leaks;
+}
@@ -0,0 +1,53 @@
+#ifndef LEDGER_H
+#define LEDGER_H
+
+#include "raylib.h"
+
+//----------------------------------------------------------------------------------
+// Defines
+//----------------------------------------------------------------------------------
+#define LEDGER_MAX_ENTRIES      128     // Max resources tracked at once (live or released)
+
+// Call-site capturing wrappers, use these instead of the raw raylib load/unload calls
+#define LoadTextureTracked(fileName)        LedgerLoadTexture(fileName, __FILE__, __LINE__)
+#define LoadTextureFromImageTracked(image) LedgerLoadTextureFromImage(image, __FILE__, __LINE__)
+#define LoadRenderTextureTracked(w, h)      LedgerLoadRenderTexture(w, h, __FILE__, __LINE__)
+#define LoadSoundTracked(fileName)          LedgerLoadSound(fileName, __FILE__, __LINE__)
+#define LoadSoundFromWaveTracked(wave)      LedgerLoadSoundFromWave(wave, __FILE__, __LINE__)
+#define LoadAudioStreamTracked(rate, bits, channels) LedgerLoadAudioStream(rate, bits, channels, __FILE__, __LINE__)
+#define UnloadTextureTracked(texture)       LedgerUnloadTexture(texture, __FILE__, __LINE__)
+#define UnloadRenderTextureTracked(target)  LedgerUnloadRenderTexture(target, __FILE__, __LINE__)
+#define UnloadSoundTracked(sound)           LedgerUnloadSound(sound, __FILE__, __LINE__)
+#define UnloadAudioStreamTracked(stream)    LedgerUnloadAudioStream(stream, __FILE__, __LINE__)
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef enum LedgerKind { LEDGER_TEXTURE = 0, LEDGER_RENDER_TEXTURE, LEDGER_SOUND, LEDGER_AUDIO_STREAM, LEDGER_KIND_COUNT } LedgerKind;
+
+typedef struct LedgerStats {
+    int live[LEDGER_KIND_COUNT];        // Resources currently loaded, per kind
+    int liveBytes[LEDGER_KIND_COUNT];   // Estimated GPU/audio memory held, per kind
+    int created;                        // Total loads since startup
+    int destroyed;                      // Total unloads since startup
+    int badUnloads;                     // Unloads of resources the ledger never saw (or saw twice)
+} LedgerStats;
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+Texture2D LedgerLoadTexture(const char *fileName, const char *file, int line);
+Texture2D LedgerLoadTextureFromImage(Image image, const char *file, int line);
+RenderTexture2D LedgerLoadRenderTexture(int width, int height, const char *file, int line);
+Sound LedgerLoadSound(const char *fileName, const char *file, int line);
+Sound LedgerLoadSoundFromWave(Wave wave, const char *file, int line);
+AudioStream LedgerLoadAudioStream(unsigned int sampleRate, unsigned int sampleSize, unsigned int channels, const char *file, int line);
+void LedgerUnloadTexture(Texture2D texture, const char *file, int line);
+void LedgerUnloadRenderTexture(RenderTexture2D target, const char *file, int line);
+void LedgerUnloadSound(Sound sound, const char *file, int line);
+void LedgerUnloadAudioStream(AudioStream stream, const char *file, int line);
+
+LedgerStats GetLedgerStats(void);
+int LedgerReportLeaks(void);        // Log every resource still live with its load site, returns count
+
+#endif // LEDGER_H
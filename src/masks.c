@@ -0,0 +1,81 @@
+#include "raylib.h"
+#include "masks.h"
+#include "ledger.h"
+#include "memory.h"
+
+//----------------------------------------------------------------------------------
+// Defines
+//----------------------------------------------------------------------------------
+#if defined(PLATFORM_WEB)
+    #define MASK_SHADER_HEADER  "#version 100\nprecision mediump float;\n#define IN varying\n#define TEXTURE texture2D\n#define OUTPUT gl_FragColor\n"
+#else
+    #define MASK_SHADER_HEADER  "#version 330\n#define IN in\n#define TEXTURE texture\nout vec4 finalColor;\n#define OUTPUT finalColor\n"
+#endif
+
+//------------------------------------------------------------------------------------
+// Global Variables Declaration
+//------------------------------------------------------------------------------------
+static Shader maskShader = { 0 };
+static bool maskShaderLoaded = false;
+
+// Grayscale textures sample as (c, c, c, 1) on every GL version, red is the coverage
+static const char *maskShaderCode = MASK_SHADER_HEADER
+    "IN vec2 fragTexCoord;\n"
+    "IN vec4 fragColor;\n"
+    "uniform sampler2D texture0;\n"
+    "uniform vec4 colDiffuse;\n"
+    "void main()\n"
+    "{\n"
+    "    float coverage = TEXTURE(texture0, fragTexCoord).r;\n"
+    "    vec4 color = fragColor*colDiffuse;\n"
+    "    OUTPUT = vec4(color.rgb, color.a*coverage);\n"
+    "}\n";
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+bool LoadMaskShader(void)
+{
+    maskShader = LoadShaderFromMemory(NULL, maskShaderCode);
+    maskShaderLoaded = IsShaderReady(maskShader);
+    if (!maskShaderLoaded) TraceLog(LOG_WARNING, "GAME: Mask shader did not compile, masks are drawn opaque");
+    return maskShaderLoaded;
+}
+
+void UnloadMaskShader(void)
+{
+    if (maskShaderLoaded) UnloadShader(maskShader);
+    maskShaderLoaded = false;
+}
+
+Texture2D LoadMaskTexture(int width, int height)
+{
+    Image image = { GameCalloc(width*height, 1), width, height, 1, PIXELFORMAT_UNCOMPRESSED_GRAYSCALE };
+    if (image.data == NULL) return (Texture2D){ 0 };
+
+    Texture2D mask = LoadTextureFromImageTracked(image);
+    GameFree(image.data);
+    return mask;
+}
+
+void UnloadMaskTexture(Texture2D mask)
+{
+    if (mask.id != 0) UnloadTextureTracked(mask);
+}
+
+// Whole rows are contiguous in the source, so a band of them goes up in one call with no copy
+void UpdateMaskRows(Texture2D mask, int firstRow, int rows, const unsigned char *coverage)
+{
+    if ((mask.id == 0) || (rows <= 0)) return;
+    UpdateTextureRec(mask, (Rectangle){ 0, (float)firstRow, (float)mask.width, (float)rows }, coverage);
+}
+
+void BeginMaskDrawing(void)
+{
+    if (maskShaderLoaded) BeginShaderMode(maskShader);
+}
+
+void EndMaskDrawing(void)
+{
+    if (maskShaderLoaded) EndShaderMode();
+}
@@ -0,0 +1,25 @@
+#ifndef MASKS_H
+#define MASKS_H
+
+// One-color sprites with holes (the shields) kept on the GPU as single channel 8-bit coverage
+// masks: a quarter of the memory and upload bandwidth of RGBA, and simulation rows can go up
+// as they are, without a staging copy. A palette shader colors them at draw time: the tint
+// passed to DrawTexture*() is the color, the texture the coverage. Without shader support the
+// mask is drawn opaque, covered texels in the tint and holes black.
+
+#include "raylib.h"
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+bool LoadMaskShader(void);
+void UnloadMaskShader(void);
+
+Texture2D LoadMaskTexture(int width, int height);   // All texels uncovered, tracked by the ledger
+void UnloadMaskTexture(Texture2D mask);
+void UpdateMaskRows(Texture2D mask, int firstRow, int rows, const unsigned char *coverage); // rows*width bytes, top row first
+
+void BeginMaskDrawing(void);                // Masks drawn until EndMaskDrawing() take their color from the tint
+void EndMaskDrawing(void);
+
+#endif // MASKS_H
@@ -0,0 +1,107 @@
+#include "memory.h"
+#include <stdlib.h> // For malloc(), free()
+#include <string.h> // For memset()
+#include <stdint.h> // For SIZE_MAX
+#include <stdatomic.h>
+
+//----------------------------------------------------------------------------------
+// Defines
+//----------------------------------------------------------------------------------
+#define ALLOC_HEADER_ALIGN      16  // Keeps the pointer after the header at malloc() alignment
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+// Prefix stored in front of every counted heap block so GameFree() knows its size.
+typedef union AllocHeader {
+    size_t size;
+    unsigned char pad[ALLOC_HEADER_ALIGN];
+} AllocHeader;
+
+//------------------------------------------------------------------------------------
+// Global Variables Declaration
+//------------------------------------------------------------------------------------
+// Heap counters are atomic: the simulation thread (see simthread.h) allocates too.
+static atomic_int curFrameAllocs = 0;       // Counters of the frame in progress
+static atomic_size_t curFrameBytes = 0;
+static atomic_int totalAllocs = 0;
+static atomic_int liveAllocs = 0;
+static atomic_size_t liveBytes = 0;
+static MemStats stats = { 0 };      // Counters of the last completed frame
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition - Counted heap
+//----------------------------------------------------------------------------------
+void *GameMalloc(size_t size)
+{
+    if (size > SIZE_MAX - sizeof(AllocHeader)) return NULL;
+    AllocHeader *header = (AllocHeader *)malloc(sizeof(AllocHeader) + size);
+    if (header == NULL) return NULL;
+
+    header->size = size;
+    atomic_fetch_add(&curFrameAllocs, 1);
+    atomic_fetch_add(&curFrameBytes, size);
+    atomic_fetch_add(&totalAllocs, 1);
+    atomic_fetch_add(&liveAllocs, 1);
+    atomic_fetch_add(&liveBytes, size);
+
+    return header + 1;
+}
+
+void *GameCalloc(size_t count, size_t size)
+{
+    if ((size != 0) && (count > (SIZE_MAX - sizeof(AllocHeader))/size)) return NULL; // Like calloc(), no wrapped size
+
+    void *ptr = GameMalloc(count * size);
+    if (ptr != NULL) memset(ptr, 0, count * size);
+    return ptr;
+}
+
+void *GameRealloc(void *ptr, size_t size)
+{
+    if (ptr == NULL) return GameMalloc(size);
+    if (size > SIZE_MAX - sizeof(AllocHeader)) return NULL;
+
+    AllocHeader *header = (AllocHeader *)ptr - 1;
+    size_t oldSize = header->size;
+
+    AllocHeader *moved = (AllocHeader *)realloc(header, sizeof(AllocHeader) + size);
+    if (moved == NULL) return NULL;
+
+    moved->size = size;
+    atomic_fetch_add(&curFrameAllocs, 1);
+    atomic_fetch_add(&curFrameBytes, size);
+    atomic_fetch_add(&totalAllocs, 1);
+    atomic_fetch_add(&liveBytes, size);
+    atomic_fetch_sub(&liveBytes, oldSize);
+
+    return moved + 1;
+}
+
+void GameFree(void *ptr)
+{
+    if (ptr == NULL) return;
+
+    AllocHeader *header = (AllocHeader *)ptr - 1;
+    atomic_fetch_sub(&liveAllocs, 1);
+    atomic_fetch_sub(&liveBytes, header->size);
+    free(header);
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition - Stats
+//----------------------------------------------------------------------------------
+void MemBeginFrame(void)
+{
+    stats.frameAllocs = atomic_exchange(&curFrameAllocs, 0);
+    stats.frameBytes = atomic_exchange(&curFrameBytes, 0);
+}
+
+MemStats GetMemStats(void)
+{
+    MemStats current = stats;
+    current.totalAllocs = atomic_load(&totalAllocs);
+    current.liveAllocs = atomic_load(&liveAllocs);
+    current.liveBytes = atomic_load(&liveBytes);
+    return current;
+}
@@ -0,0 +1,415 @@
+#include "netplay.h"
+#include <string.h> // For memcpy(), memset()
+#include <limits.h> // For INT_MAX
+
+#if !defined(_WIN32) && !defined(PLATFORM_WEB)
+    #define NETPLAY_SUPPORTED
+    #include <sys/socket.h>
+    #include <netinet/in.h>
+    #include <arpa/inet.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+//----------------------------------------------------------------------------------
+// Defines
+//----------------------------------------------------------------------------------
+#define PACKET_MAGIC            0x4E564E49 // "INVN"
+#define PACKET_MAX_SIZE         128
+#define PACKET_MAX_INPUTS       32      // Unacknowledged inputs repeated per packet
+#define HELLO_INTERVAL          0.2     // Seconds between connection attempts
+#define DELAY_QUEUE_SIZE        256     // Packets held back by the latency simulation
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef enum PacketType { PACKET_HELLO = 1, PACKET_WELCOME, PACKET_INPUT } PacketType;
+
+typedef struct DelayedPacket {
+    double sendTime;
+    int size;
+    unsigned char data[PACKET_MAX_SIZE];
+} DelayedPacket;
+
+//------------------------------------------------------------------------------------
+// Global Variables Declaration
+//------------------------------------------------------------------------------------
+static NetplayConfig config = { 0 };
+static NetplayStatus status = NETPLAY_OFF;
+static NetplayStats stats = { 0 };
+static uint64_t matchSeed = 0;
+static double lastHelloTime = -1.0;
+
+static int localTick = 0;                           // Ticks simulated so far, the next one to simulate
+static int remoteReceived = -1;                     // Newest tick with all remote inputs up to it received
+static int peerAck = -1;                            // Newest tick the peer has all our inputs up to
+static int rollbackFrom = INT_MAX;                  // Oldest tick simulated with a wrong prediction
+
+static Versus history[NETPLAY_HISTORY];             // State before tick t, at t%NETPLAY_HISTORY
+static uint64_t historyHash[NETPLAY_HISTORY];
+static uint8_t localInputs[NETPLAY_INPUT_RING];
+static uint8_t remoteInputs[NETPLAY_INPUT_RING];
+static int remoteInputTick[NETPLAY_INPUT_RING];     // Tick each remoteInputs slot holds, -1 when empty
+static uint8_t usedRemoteInputs[NETPLAY_INPUT_RING]; // Remote input (real or predicted) each tick last ran with
+
+static uint64_t peerHashes[NETPLAY_HISTORY];        // Confirmed state hashes reported by the peer
+static int peerHashTick[NETPLAY_HISTORY];           // Tick each peerHashes slot holds
+static int checkedHashTick = 0;                     // Newest tick compared against the peer
+
+static DelayedPacket delayQueue[DELAY_QUEUE_SIZE];
+static int delayHead = 0;
+static int delayCount = 0;
+static uint64_t lossState = 0x9E3779B97F4A7C15ULL;  // Loss simulation only, never touches the game PRNG
+
+#if defined(NETPLAY_SUPPORTED)
+static int sock = -1;
+static struct sockaddr_in peerAddress;
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition - Packets
+//----------------------------------------------------------------------------------
+static void PutU32(unsigned char *dst, uint32_t value)
+{
+    for (int i = 0; i < 4; i++) dst[i] = (unsigned char)(value >> (8*i));
+}
+
+static void PutU64(unsigned char *dst, uint64_t value)
+{
+    PutU32(dst, (uint32_t)value);
+    PutU32(dst + 4, (uint32_t)(value >> 32));
+}
+
+static uint32_t GetU32(const unsigned char *src)
+{
+    return src[0] | ((uint32_t)src[1] << 8) | ((uint32_t)src[2] << 16) | ((uint32_t)src[3] << 24);
+}
+
+static uint64_t GetU64(const unsigned char *src)
+{
+    return GetU32(src) | ((uint64_t)GetU32(src + 4) << 32);
+}
+
+#if defined(NETPLAY_SUPPORTED)
+static void SendNow(const unsigned char *data, int size)
+{
+    sendto(sock, data, size, 0, (const struct sockaddr *)&peerAddress, sizeof(peerAddress));
+}
+#else
+static void SendNow(const unsigned char *data, int size) { (void)data; (void)size; }
+#endif
+
+// Every outgoing packet goes through the loss and latency simulation
+static void SendPacket(const unsigned char *data, int size, double now)
+{
+    stats.packetsSent++;
+
+    lossState ^= lossState << 13;
+    lossState ^= lossState >> 7;
+    lossState ^= lossState << 17;
+    if ((int)(lossState%100) < config.lossPercent) {
+        stats.packetsDropped++;
+        return;
+    }
+
+    if (config.delayMs <= 0) { SendNow(data, size); return; }
+
+    if (delayCount == DELAY_QUEUE_SIZE) {
+        stats.packetsDropped++;
+        return;
+    }
+
+    DelayedPacket *packet = &delayQueue[(delayHead + delayCount)%DELAY_QUEUE_SIZE];
+    packet->sendTime = now + config.delayMs/1000.0;
+    packet->size = size;
+    memcpy(packet->data, data, size);
+    delayCount++;
+}
+
+// Constant delay keeps the queue in send order, so only the head needs checking
+static void FlushDelayedPackets(double now)
+{
+    while ((delayCount > 0) && (delayQueue[delayHead].sendTime <= now)) {
+        SendNow(delayQueue[delayHead].data, delayQueue[delayHead].size);
+        delayHead = (delayHead + 1)%DELAY_QUEUE_SIZE;
+        delayCount--;
+    }
+}
+
+static void SendControl(PacketType type, double now)
+{
+    unsigned char packet[13];
+    PutU32(packet, PACKET_MAGIC);
+    packet[4] = (unsigned char)type;
+    PutU64(packet + 5, matchSeed);
+    SendPacket(packet, (type == PACKET_WELCOME) ? 13 : 5, now);
+}
+
+// Layout: u32 magic, u8 type, u32 ack, u32 first tick, u8 count, count x u8 input,
+//         u32 hash tick, u64 hash of the state before that tick
+static void SendInputs(double now)
+{
+    unsigned char packet[PACKET_MAX_SIZE];
+    int first = peerAck + 1;
+    int count = localTick - first;
+    if (count > PACKET_MAX_INPUTS) count = PACKET_MAX_INPUTS;
+    if (count < 0) count = 0;
+
+    PutU32(packet, PACKET_MAGIC);
+    packet[4] = PACKET_INPUT;
+    PutU32(packet + 5, (uint32_t)remoteReceived);
+    PutU32(packet + 9, (uint32_t)first);
+    packet[13] = (unsigned char)count;
+    int size = 14;
+    for (int i = 0; i < count; i++) packet[size++] = localInputs[(first + i)%NETPLAY_INPUT_RING];
+
+    // Newest state both sides have simulated with real inputs only
+    int hashTick = remoteReceived + 1;
+    if (hashTick > localTick - 1) hashTick = localTick - 1;
+    if (hashTick < localTick - NETPLAY_HISTORY + 1) hashTick = 0;
+    PutU32(packet + size, (uint32_t)((hashTick > 0) ? hashTick : 0));
+    PutU64(packet + size + 4, (hashTick > 0) ? historyHash[hashTick%NETPLAY_HISTORY] : 0);
+    size += 12;
+
+    SendPacket(packet, size, now);
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition - Simulation
+//----------------------------------------------------------------------------------
+static void BeginMatch(Versus *versus)
+{
+    InitVersus(versus, matchSeed);
+    localTick = 0;
+    remoteReceived = -1;
+    peerAck = -1;
+    rollbackFrom = INT_MAX;
+    checkedHashTick = 0;
+    for (int i = 0; i < NETPLAY_HISTORY; i++) peerHashTick[i] = 0;
+    for (int i = 0; i < NETPLAY_INPUT_RING; i++) remoteInputTick[i] = -1;
+    status = NETPLAY_RUNNING;
+}
+
+// Repeat the last known direction, never predict a shot
+static uint8_t PredictRemoteInput(void)
+{
+    if (remoteReceived < 0) return 0;
+    return remoteInputs[remoteReceived%NETPLAY_INPUT_RING] & ~PackGameInput((GameInput){ false, false, true });
+}
+
+static void SimulateTick(Versus *versus, int tick)
+{
+    int slot = tick%NETPLAY_INPUT_RING;
+    history[tick%NETPLAY_HISTORY] = *versus;
+    historyHash[tick%NETPLAY_HISTORY] = HashVersus(versus);
+
+    uint8_t remote = (remoteInputTick[slot] == tick) ? remoteInputs[slot] : PredictRemoteInput();
+    usedRemoteInputs[slot] = remote;
+
+    int local = GetNetplayLocalPlayer();
+    GameInput inputs[VERSUS_PLAYERS];
+    inputs[local] = UnpackGameInput(localInputs[slot]);
+    inputs[1 - local] = UnpackGameInput(remote);
+    UpdateVersus(versus, inputs);
+}
+
+static void ReceiveInputs(const unsigned char *packet, int size)
+{
+    if (size < 14) return;
+
+    int ack = (int)GetU32(packet + 5);
+    int first = (int)GetU32(packet + 9);
+    int count = packet[13];
+    if (size < 14 + count + 12) return;
+
+    if ((ack > peerAck) && (ack < localTick)) peerAck = ack;
+
+    for (int i = 0; i < count; i++) {
+        int tick = first + i;
+        if ((tick <= remoteReceived) || (tick >= remoteReceived + NETPLAY_INPUT_RING)) continue;
+
+        int slot = tick%NETPLAY_INPUT_RING;
+        remoteInputs[slot] = packet[14 + i];
+        remoteInputTick[slot] = tick;
+
+        // Already simulated with a guess: roll back if the guess was wrong
+        if ((tick < localTick) && (usedRemoteInputs[slot] != remoteInputs[slot]) && (tick < rollbackFrom)) rollbackFrom = tick;
+    }
+
+    while (remoteInputTick[(remoteReceived + 1)%NETPLAY_INPUT_RING] == remoteReceived + 1) remoteReceived++;
+
+    int hashTick = (int)GetU32(packet + 14 + count);
+    if (hashTick > checkedHashTick) {
+        peerHashTick[hashTick%NETPLAY_HISTORY] = hashTick;
+        peerHashes[hashTick%NETPLAY_HISTORY] = GetU64(packet + 14 + count + 4);
+    }
+}
+
+#if defined(NETPLAY_SUPPORTED)
+static void ReceivePackets(Versus *versus, double now)
+{
+    unsigned char packet[PACKET_MAX_SIZE];
+    struct sockaddr_in from;
+    socklen_t fromSize = sizeof(from);
+    int size;
+
+    while ((size = (int)recvfrom(sock, packet, sizeof(packet), 0, (struct sockaddr *)&from, &fromSize)) > 0) {
+        fromSize = sizeof(from);
+        if ((size < 5) || (GetU32(packet) != PACKET_MAGIC)) continue;
+
+        // The host adopts whoever says hello first, after that only the peer is listened to
+        bool fromPeer = (from.sin_addr.s_addr == peerAddress.sin_addr.s_addr) && (from.sin_port == peerAddress.sin_port);
+        if (config.host && (status == NETPLAY_CONNECTING) && (packet[4] == PACKET_HELLO)) {
+            peerAddress = from;
+            fromPeer = true;
+        }
+        if (!fromPeer) continue;
+        stats.packetsReceived++;
+
+        switch (packet[4]) {
+            case PACKET_HELLO:
+            {
+                if (!config.host) break;
+                if (status == NETPLAY_CONNECTING) BeginMatch(versus);
+                SendControl(PACKET_WELCOME, now); // Repeated until the joiner stops saying hello
+            } break;
+            case PACKET_WELCOME:
+            {
+                if (config.host || (status != NETPLAY_CONNECTING) || (size < 13)) break;
+                matchSeed = GetU64(packet + 5);
+                BeginMatch(versus);
+            } break;
+            case PACKET_INPUT:
+            {
+                if (status != NETPLAY_CONNECTING) ReceiveInputs(packet, size);
+            } break;
+            default: break;
+        }
+    }
+}
+#else
+static void ReceivePackets(Versus *versus, double now) { (void)versus; (void)now; }
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition - Session
+//----------------------------------------------------------------------------------
+bool NetplayStart(const NetplayConfig *settings, uint64_t seed)
+{
+#if defined(NETPLAY_SUPPORTED)
+    NetplayStop();
+    config = *settings;
+    matchSeed = seed;
+    stats = (NetplayStats){ 0 };
+    lastHelloTime = -1.0;
+    delayHead = delayCount = 0;
+
+    sock = (int)socket(AF_INET, SOCK_DGRAM, 0);
+    if (sock < 0) return false;
+    fcntl(sock, F_SETFL, fcntl(sock, F_GETFL, 0) | O_NONBLOCK);
+
+    struct sockaddr_in local = { 0 };
+    local.sin_family = AF_INET;
+    local.sin_addr.s_addr = htonl(INADDR_ANY);
+    local.sin_port = htons(config.host ? (uint16_t)config.port : 0);
+    memset(&peerAddress, 0, sizeof(peerAddress));
+    peerAddress.sin_family = AF_INET;
+    peerAddress.sin_port = htons((uint16_t)config.port);
+
+    bool ok = bind(sock, (struct sockaddr *)&local, sizeof(local)) == 0;
+    if (ok && !config.host) ok = inet_pton(AF_INET, config.address, &peerAddress.sin_addr) == 1;
+    if (!ok) {
+        NetplayStop();
+        return false;
+    }
+
+    status = NETPLAY_CONNECTING;
+    return true;
+#else
+    (void)settings;
+    (void)seed;
+    return false; // Needs POSIX sockets
+#endif
+}
+
+void NetplayStop(void)
+{
+#if defined(NETPLAY_SUPPORTED)
+    if (sock >= 0) close(sock);
+    sock = -1;
+#endif
+    status = NETPLAY_OFF;
+}
+
+NetplayStatus GetNetplayStatus(void)
+{
+    return status;
+}
+
+int GetNetplayLocalPlayer(void)
+{
+    return config.host ? 0 : 1;
+}
+
+bool NetplayAdvance(Versus *versus, GameInput localInput, double now)
+{
+    if (status == NETPLAY_OFF) return false;
+
+    ReceivePackets(versus, now);
+    FlushDelayedPackets(now);
+
+    if (status == NETPLAY_CONNECTING) {
+        if (!config.host && ((lastHelloTime < 0.0) || (now - lastHelloTime >= HELLO_INTERVAL))) {
+            SendControl(PACKET_HELLO, now);
+            lastHelloTime = now;
+        }
+        return false;
+    }
+
+    // Correct mispredictions: back to the state before the first wrong tick, then forward again
+    if (rollbackFrom < localTick) {
+        int depth = localTick - rollbackFrom;
+        *versus = history[rollbackFrom%NETPLAY_HISTORY];
+        for (int tick = rollbackFrom; tick < localTick; tick++) SimulateTick(versus, tick);
+        for (int p = 0; p < VERSUS_PLAYERS; p++) InvalidateShields(&versus->games[p]);
+
+        stats.rollbacks++;
+        stats.resimulatedTicks += depth;
+        if (depth > stats.maxRollback) stats.maxRollback = depth;
+    }
+    rollbackFrom = INT_MAX;
+
+    // States up to the confirmed tick are final on both sides, compare the ones the peer reported
+    int confirmed = (remoteReceived + 1 < localTick - 1) ? remoteReceived + 1 : localTick - 1;
+    if (checkedHashTick < localTick - NETPLAY_HISTORY) checkedHashTick = localTick - NETPLAY_HISTORY;
+    for (int tick = checkedHashTick + 1; tick <= confirmed; tick++) {
+        int slot = tick%NETPLAY_HISTORY;
+        if (peerHashTick[slot] != tick) continue;
+
+        checkedHashTick = tick;
+        if (historyHash[slot] == peerHashes[slot]) stats.hashChecks++;
+        else if (stats.desyncTick == 0) {
+            stats.desyncTick = (uint32_t)tick;
+            status = NETPLAY_DESYNCED;
+        }
+    }
+
+    stats.remoteLag = localTick - (remoteReceived + 1);
+    bool advanced = false;
+
+    if (stats.remoteLag < NETPLAY_MAX_ROLLBACK) {
+        localInputs[localTick%NETPLAY_INPUT_RING] = PackGameInput(localInput);
+        SimulateTick(versus, localTick);
+        localTick++;
+        advanced = true;
+    }
+    else stats.stalls++;
+
+    SendInputs(now);
+    return advanced;
+}
+
+NetplayStats GetNetplayStats(void)
+{
+    return stats;
+}
@@ -0,0 +1,56 @@
+#ifndef NETPLAY_H
+#define NETPLAY_H
+
+#include "versus.h"
+
+//----------------------------------------------------------------------------------
+// Defines
+//----------------------------------------------------------------------------------
+#define NETPLAY_MAX_ROLLBACK    8   // Ticks the local side may run ahead of confirmed remote input
+#define NETPLAY_HISTORY         16  // Snapshots kept for rollback, must exceed NETPLAY_MAX_ROLLBACK
+#define NETPLAY_INPUT_RING      64  // Remote/local input history, must exceed the inputs sent per packet
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef struct NetplayConfig {
+    bool host;                  // Host picks the seed and plays P1, the joining side plays P2
+    const char *address;        // Host address to join (IPv4), ignored when hosting
+    int port;
+    int delayMs;                // Simulated one-way latency added to every outgoing packet
+    int lossPercent;            // Simulated outgoing packet loss
+} NetplayConfig;
+
+typedef enum NetplayStatus { NETPLAY_OFF = 0, NETPLAY_CONNECTING, NETPLAY_RUNNING, NETPLAY_DESYNCED } NetplayStatus;
+
+typedef struct NetplayStats {
+    int rollbacks;              // Mispredictions corrected since start
+    int resimulatedTicks;       // Ticks simulated again because of those
+    int maxRollback;            // Deepest rollback seen, in ticks
+    int stalls;                 // Ticks skipped waiting for the remote side
+    int packetsSent;
+    int packetsDropped;         // Dropped by the loss simulation
+    int packetsReceived;
+    int remoteLag;              // Local tick minus newest confirmed remote tick
+    int hashChecks;             // Confirmed ticks whose state hash matched the peer's
+    uint32_t desyncTick;        // First tick whose state hash differed between peers, 0 if none
+} NetplayStats;
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+// Inputs are exchanged over UDP, every packet repeating all inputs the peer has not
+// acknowledged, so a lost packet costs latency but never data. The remote input is
+// predicted (last known direction, no fire); when the real one arrives and differs, the
+// snapshot before that tick is restored and the ticks up to now are simulated again.
+bool NetplayStart(const NetplayConfig *config, uint64_t seed); // Seed is only used when hosting
+void NetplayStop(void);
+NetplayStatus GetNetplayStatus(void);
+int GetNetplayLocalPlayer(void);                // 0 or 1, index into Versus.games
+
+// Call once per fixed tick. Returns true when the match advanced a tick (events of that tick
+// are in the games), false while connecting or stalled on the remote side.
+bool NetplayAdvance(Versus *versus, GameInput localInput, double now);
+NetplayStats GetNetplayStats(void);
+
+#endif // NETPLAY_H
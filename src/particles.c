@@ -0,0 +1,229 @@
+#include "raylib.h"
+#include "rlgl.h"
+#include "particles.h"
+#include "memory.h"
+#include <math.h>   // For cosf(), sinf()
+
+//----------------------------------------------------------------------------------
+// Defines
+//----------------------------------------------------------------------------------
+#define PARTICLE_SIZE           3.0f    // Side of the square, pixels
+#define PARTICLE_PI             3.14159265358979f
+#define MAX_TICK_GAP            8       // Larger jumps (loads, new games, rewinds) resync without bursts
+#define PARTICLE_LANES          8       // Integration runs in groups of this many, MAX_PARTICLES is a multiple
+#define DRAW_CHUNK              1024    // Quads reserved in the batch at a time, well under its size
+
+//------------------------------------------------------------------------------------
+// Global Variables Declaration
+//------------------------------------------------------------------------------------
+// Structure of arrays, live particles are packed at the front
+static float *posX = NULL;
+static float *posY = NULL;
+static float *velX = NULL;
+static float *velY = NULL;
+static float *life = NULL;              // Seconds left
+static float *fade = NULL;              // 1/lifetime, alpha is life*fade
+static Color *color = NULL;
+static int count = 0;
+static ParticleStats stats = { 0 };
+static uint32_t noise = 0x2545f491u;    // Own generator, the game's random state is never touched
+
+// Last board seen by WatchBoardParticles()
+static bool watchValid = false;
+static uint32_t watchTick = 0;
+static bool watchAliens[NUM_ALIENS] = { 0 };
+static bool watchUfoExploding = false;
+static bool watchPlayerExploding = false;
+static bool watchExplosions[MAX_EXPLOSIONS] = { 0 };
+static int watchExplosionTicks[MAX_EXPLOSIONS] = { 0 };
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+// xorshift32, mapped to 0..1
+static float NextRandom(void)
+{
+    noise ^= noise << 13;
+    noise ^= noise >> 17;
+    noise ^= noise << 5;
+    return (float)(noise >> 8)/(float)(1 << 24);
+}
+
+bool InitParticles(void)
+{
+    posX = (float *)GameCalloc(MAX_PARTICLES, sizeof(float));
+    posY = (float *)GameCalloc(MAX_PARTICLES, sizeof(float));
+    velX = (float *)GameCalloc(MAX_PARTICLES, sizeof(float));
+    velY = (float *)GameCalloc(MAX_PARTICLES, sizeof(float));
+    life = (float *)GameCalloc(MAX_PARTICLES, sizeof(float));
+    fade = (float *)GameCalloc(MAX_PARTICLES, sizeof(float));
+    color = (Color *)GameCalloc(MAX_PARTICLES, sizeof(Color));
+    count = 0;
+    watchValid = false;
+
+    if ((posX == NULL) || (posY == NULL) || (velX == NULL) || (velY == NULL) || (life == NULL) || (fade == NULL) || (color == NULL)) {
+        FreeParticles();
+        return false;
+    }
+    return true;
+}
+
+void FreeParticles(void)
+{
+    GameFree(posX); GameFree(posY);
+    GameFree(velX); GameFree(velY);
+    GameFree(life); GameFree(fade);
+    GameFree(color);
+    posX = posY = velX = velY = life = fade = NULL;
+    color = NULL;
+    count = 0;
+}
+
+void ClearParticles(void)
+{
+    count = 0;
+    watchValid = false;
+}
+
+// Random spots inside center +- extent/2, thrown outwards in all directions at up to speed
+void SpawnParticleBurst(Vector2 center, Vector2 extent, int amount, float speed, float lifetime, Color tint)
+{
+    if (posX == NULL) return;
+    if (count + amount > MAX_PARTICLES) {
+        stats.dropped += count + amount - MAX_PARTICLES;
+        amount = MAX_PARTICLES - count;
+    }
+
+    for (int i = count; i < count + amount; i++) {
+        float angle = 2.0f*PARTICLE_PI*NextRandom();
+        float push = speed*(0.3f + 0.7f*NextRandom());
+        float span = lifetime*(0.5f + 0.5f*NextRandom());
+        posX[i] = center.x + extent.x*(NextRandom() - 0.5f);
+        posY[i] = center.y + extent.y*(NextRandom() - 0.5f);
+        velX[i] = cosf(angle)*push;
+        velY[i] = sinf(angle)*push;
+        life[i] = span;
+        fade[i] = 1.0f/span;
+        color[i] = tint;
+    }
+    count += amount;
+    stats.spawned += amount;
+}
+
+void WatchBoardParticles(const Game *board, bool spawn)
+{
+    spawn = spawn && watchValid && (board->tick > watchTick) && (board->tick - watchTick <= MAX_TICK_GAP);
+
+    if (spawn) {
+        for (int i = 0; i < NUM_ALIENS; i++) {
+            const Alien *alien = &board->aliens[i];
+            if (watchAliens[i] && !alien->active) {
+                Vector2 center = { alien->position.x + alien->size.x/2, alien->position.y + alien->size.y/2 };
+                SpawnParticleBurst(center, alien->size, 48, 160.0f, 0.8f, RAYWHITE);
+            }
+        }
+
+        const UFO *ufo = &board->ufo;
+        if (ufo->exploding && !watchUfoExploding) {
+            Vector2 center = { ufo->position.x + ufo->size.x/2, ufo->position.y + ufo->size.y/2 };
+            SpawnParticleBurst(center, ufo->size, 160, 220.0f, 1.2f, RED);
+            SpawnParticleBurst(center, ufo->size, 60, 120.0f, 0.8f, ORANGE);
+        }
+
+        const Player *player = &board->player;
+        if (player->exploding && !watchPlayerExploding) {
+            Vector2 center = { player->position.x + player->size.x/2, player->position.y + player->size.y/2 };
+            SpawnParticleBurst(center, player->size, 120, 180.0f, 1.0f, LIME);
+        }
+
+        // Shot explosions: a new slot, or a slot reused since its timer went up
+        for (int i = 0; i < MAX_EXPLOSIONS; i++) {
+            const Explosion *explosion = &board->explosions[i];
+            if (!explosion->active || (explosion->type != EXPLOSION_SHOT)) continue;
+            if (watchExplosions[i] && (GetGameTimerTicks(board, TIMER_EXPLOSION + i) <= watchExplosionTicks[i])) continue;
+
+            Vector2 center = { explosion->position.x + explosion->size.x/2, explosion->position.y + explosion->size.y/2 };
+            Color tint = RAYWHITE;
+            for (int s = 0; s < NUM_SHIELDS; s++) {
+                Rectangle bounds = board->shields[s].bounds;
+                if (board->shields[s].active && (center.x >= bounds.x) && (center.x < bounds.x + bounds.width) &&
+                    (center.y >= bounds.y) && (center.y < bounds.y + bounds.height)) tint = GREEN; // Shield fragments
+            }
+            SpawnParticleBurst(center, explosion->size, 16, 90.0f, 0.5f, tint);
+        }
+    }
+
+    watchValid = true;
+    watchTick = board->tick;
+    for (int i = 0; i < NUM_ALIENS; i++) watchAliens[i] = board->aliens[i].active;
+    watchUfoExploding = board->ufo.exploding;
+    watchPlayerExploding = board->player.exploding;
+    for (int i = 0; i < MAX_EXPLOSIONS; i++) {
+        watchExplosions[i] = board->explosions[i].active;
+        watchExplosionTicks[i] = GetGameTimerTicks(board, TIMER_EXPLOSION + i);
+    }
+}
+
+// No branches, no aliasing and a multiple of PARTICLE_LANES long: vectorized with no scalar tail,
+// which the cheap vectorizer cost model of -O2 also accepts
+static void IntegrateParticles(float *restrict x, float *restrict y, float *restrict vx, float *restrict vy, float *restrict t, int groups, float delta)
+{
+    for (int g = 0; g < groups; g++) {
+        for (int j = 0; j < PARTICLE_LANES; j++) {
+            int i = g*PARTICLE_LANES + j;
+            x[i] += vx[i]*delta;
+            y[i] += vy[i]*delta;
+            vy[i] += PARTICLE_GRAVITY*delta;
+            t[i] -= delta;
+        }
+    }
+}
+
+void UpdateParticles(float delta)
+{
+    // Up to PARTICLE_LANES - 1 dead slots past the end come along, they stay dead
+    IntegrateParticles(posX, posY, velX, velY, life, (count + PARTICLE_LANES - 1)/PARTICLE_LANES, delta);
+
+    // Compaction, the last live particle takes the place of a dead one
+    float *x = posX, *y = posY, *vx = velX, *vy = velY, *t = life;
+    int live = count;
+    for (int i = 0; i < live; ) {
+        if (t[i] > 0.0f) { i++; continue; }
+        live--;
+        x[i] = x[live]; y[i] = y[live];
+        vx[i] = vx[live]; vy[i] = vy[live];
+        t[i] = t[live]; fade[i] = fade[live];
+        color[i] = color[live];
+    }
+    count = live;
+    stats.live = live;
+}
+
+void DrawParticles(void)
+{
+    if (count == 0) return;
+
+    // Quads with the default (white) texture, all in the same draw call unless the batch fills up
+    rlSetTexture(rlGetTextureIdDefault());
+    for (int start = 0; start < count; start += DRAW_CHUNK) {
+        int end = (start + DRAW_CHUNK < count) ? start + DRAW_CHUNK : count;
+        rlCheckRenderBatchLimit(4*(end - start)); // Flushes first if the chunk would not fit
+        rlBegin(RL_QUADS);
+            for (int i = start; i < end; i++) {
+                float alpha = life[i]*fade[i];
+                rlColor4ub(color[i].r, color[i].g, color[i].b, (unsigned char)(color[i].a*((alpha < 1.0f) ? alpha : 1.0f)));
+                rlTexCoord2f(0.0f, 0.0f);
+                rlVertex2f(posX[i], posY[i]);
+                rlVertex2f(posX[i], posY[i] + PARTICLE_SIZE);
+                rlVertex2f(posX[i] + PARTICLE_SIZE, posY[i] + PARTICLE_SIZE);
+                rlVertex2f(posX[i] + PARTICLE_SIZE, posY[i]);
+            }
+        rlEnd();
+    }
+    rlSetTexture(0);
+}
+
+ParticleStats GetParticleStats(void)
+{
+    return stats;
+}
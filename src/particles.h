@@ -0,0 +1,44 @@
+#ifndef PARTICLES_H
+#define PARTICLES_H
+
+// Debris for the board on screen: alien deaths, UFO and player explosions, shots chipping shields.
+// Pure decoration, kept out of Game so the simulation, its hashes, snapshots and replays never see
+// it. Bursts are found by comparing the shown board with the last one (aliens gone, UFO or player
+// starting to explode, fresh explosion slots), so this works the same whichever thread ticks.
+//  - structure of arrays, one array per component: the update is a straight loop over floats that
+//    the compiler vectorizes, dead particles are then swapped out with the last live one
+//  - drawn as one immediate-mode quad list with the default texture, a single batch for all
+//  - fixed capacity, bursts beyond it are cut short and counted
+
+#include "raylib.h"
+#include "game.h"
+
+//----------------------------------------------------------------------------------
+// Defines
+//----------------------------------------------------------------------------------
+#define MAX_PARTICLES           32768
+#define PARTICLE_GRAVITY        240.0f  // Pixels per second squared, debris falls
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef struct ParticleStats {
+    int live;
+    int spawned;                // Since startup
+    int dropped;                // Spawns that found no free slot
+} ParticleStats;
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+bool InitParticles(void);                   // Allocates the arrays for MAX_PARTICLES
+void FreeParticles(void);
+void ClearParticles(void);
+
+void SpawnParticleBurst(Vector2 center, Vector2 extent, int amount, float speed, float lifetime, Color tint);
+void WatchBoardParticles(const Game *board, bool spawn);   // Bursts for what changed since the last call; spawn false only resyncs
+void UpdateParticles(float delta);
+void DrawParticles(void);                   // World coordinates, under whatever camera is active
+ParticleStats GetParticleStats(void);
+
+#endif // PARTICLES_H
@@ -0,0 +1,673 @@
+#include "raster.h"
+#include "memory.h"
+#include <math.h>   // For ceilf()
+#include <stdio.h>  // For snprintf(), FILE
+#include <string.h> // For memset(), strlen()
+
+//----------------------------------------------------------------------------------
+// Defines
+//----------------------------------------------------------------------------------
+#define FONT_GLYPH_WIDTH        5
+#define FONT_GLYPH_HEIGHT       7
+#define FONT_BASE_SIZE          10      // Like raylib's default font: size 20 draws every glyph pixel 2x2
+
+#define DEFLATE_WINDOW          32768
+#define DEFLATE_HASH_BITS       15
+#define DEFLATE_MAX_MATCH       258
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef struct Sprite {
+    int width;
+    int height;
+    const unsigned char *alpha;         // Coverage, the sprites are white
+} Sprite;
+
+typedef struct Glyph {
+    char character;
+    unsigned char rows[FONT_GLYPH_HEIGHT]; // 5 bits per row, MSB is the leftmost pixel
+} Glyph;
+
+typedef struct Rgb {
+    unsigned char r, g, b;
+} Rgb;
+
+typedef struct BitWriter {
+    unsigned char *data;
+    int size;
+    uint32_t bits;
+    int count;
+} BitWriter;
+
+//----------------------------------------------------------------------------------
+// Sprite and font data (alpha of the resources/*.png files, all of them are white)
+//----------------------------------------------------------------------------------
+static const unsigned char spriteAlien1A[8*16] = { // inv11.png
+      0,   0,   0,   0,   0,   4, 229, 255, 255, 229,   4,   0,   0,   0,   0,   0,
+      0,   0,   1, 166, 202, 204, 251, 255, 255, 251, 204, 202, 166,   1,   0,   0,
+      0,   0, 172, 254, 255, 252, 245, 254, 254, 245, 252, 255, 254, 172,   0,   0,
+      0,   0, 210, 255, 254,  69,  50, 243, 243,  50,  69, 254, 255, 210,   0,   0,
+      0,   0, 182, 228, 224, 234, 239, 224, 224, 239, 234, 224, 228, 182,   0,   0,
+      0,   0,   1,   2,  51, 238, 218,  65,  65, 218, 238,  51,   2,   1,   0,   0,
+      0,   0,  42,  53, 178, 197,  31, 183, 183,  31, 197, 178,  53,  42,   0,   0,
+      0,   0, 207, 255,  35,   0,   0,   0,   0,   0,   0,  35, 255, 207,   0,   0
+};
+static const unsigned char spriteAlien1B[8*16] = { // inv12.png
+      0,   0,   0,   0,   0,   4, 229, 255, 255, 229,   4,   0,   0,   0,   0,   0,
+      0,   0,   1, 166, 202, 204, 251, 255, 255, 251, 204, 202, 166,   1,   0,   0,
+      0,   0, 172, 254, 255, 252, 245, 254, 254, 245, 252, 255, 254, 172,   0,   0,
+      0,   0, 210, 255, 251,  68,  50, 243, 243,  50,  68, 251, 255, 210,   0,   0,
+      0,   0, 182, 224, 250, 242, 239, 224, 224, 239, 242, 250, 224, 182,   0,   0,
+      0,   0,   7,  47, 225, 217, 209,  66,  66, 209, 217, 225,  47,   7,   0,   0,
+      0,   0,   0, 165, 247,  78,  13, 185, 185,  13,  78, 247, 165,   0,   0,   0,
+      0,   0,   0,   0, 217, 255,  26,   0,   0,  26, 255, 217,   0,   0,   0,   0
+};
+static const unsigned char spriteAlien2A[8*16] = { // inv21.png
+      0,   0,   0,   0,   5, 218,  27,   0,   0,   0,  34, 215,   1,   0,   0,   0,
+      0,   0,   0, 165,  34,  50, 179,  20,   1,  25, 179,  45,  40, 162,   0,   0,
+      0,   0,   0, 214,  56, 180, 245, 219, 216, 220, 245, 174,  60, 209,   0,   0,
+      0,   0,   0, 213, 234, 247,  76, 240, 255, 235,  77, 250, 234, 206,   0,   0,
+      0,   0,   0, 188, 255, 255, 242, 255, 255, 255, 242, 255, 255, 182,   0,   0,
+      0,   0,   0,   8, 180, 254, 223, 216, 216, 216, 224, 253, 174,   7,   0,   0,
+      0,   0,   0,   0,  50, 178,  25,   1,   1,   1,  30, 177,  46,   0,   0,   0,
+      0,   0,   0,   2, 215,  34,   0,   0,   0,   0,   0,  41, 212,   0,   0,   0
+};
+static const unsigned char spriteAlien2B[8*16] = { // inv22.png
+      0,   0,   0,   0,   6, 218,  27,   0,   0,   0,  34, 215,   2,   0,   0,   0,
+      0,   0,   0,   0,   0,  54, 179,  20,   1,  25, 179,  50,   0,   0,   0,   0,
+      0,   0,   0,   0,  11, 186, 245, 219, 216, 220, 245, 180,   7,   0,   0,   0,
+      0,   0,   0,  15, 201, 252,  76, 240, 255, 235,  77, 255, 195,  13,   0,   0,
+      0,   0,   0, 196, 234, 251, 242, 255, 255, 255, 242, 251, 234, 190,   0,   0,
+      0,   0,   0, 215,  57, 223, 217, 210, 215, 210, 218, 217,  61, 211,   0,   0,
+      0,   0,   0, 164,  38, 167,  73,  51,   9,  53,  78, 164,  42, 161,   0,   0,
+      0,   0,   0,   0,   0,   5, 234, 242,  37, 249, 228,   2,   0,   0,   0,   0
+};
+static const unsigned char spriteAlien3A[8*16] = { // inv31.png
+      0,   0,   0,   0,   0,   0,   8, 237, 237,   8,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   7, 185, 251, 251, 185,   7,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,  11, 191, 248, 255, 255, 248, 191,  11,   0,   0,   0,   0,
+      0,   0,   0,   1, 199, 255,  76, 241, 241,  76, 255, 199,   1,   0,   0,   0,
+      0,   0,   0,   1, 197, 225, 237, 225, 225, 237, 225, 197,   1,   0,   0,   0,
+      0,   0,   0,   0,   3,  54, 189,  67,  67, 189,  54,   3,   0,   0,   0,   0,
+      0,   0,   0,   0,  48, 176,  79, 187, 187,  79, 176,  48,   0,   0,   0,   0,
+      0,   0,   0,   2, 214,  45, 215,  18,  18, 215,  45, 214,   2,   0,   0,   0
+};
+static const unsigned char spriteAlien3B[8*16] = { // inv32.png
+      0,   0,   0,   0,   0,   0,   8, 237, 237,   8,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   7, 185, 251, 251, 185,   7,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,  11, 191, 248, 255, 255, 248, 191,  11,   0,   0,   0,   0,
+      0,   0,   0,   1, 199, 252,  78, 238, 238,  78, 252, 199,   1,   0,   0,   0,
+      0,   0,   0,   1, 194, 254, 216, 255, 255, 216, 254, 194,   1,   0,   0,   0,
+      0,   0,   0,   0,  50, 183,  44, 199, 199,  44, 183,  50,   0,   0,   0,   0,
+      0,   0,   0,   2, 167,  75,   5,   1,   1,   5,  75, 167,   2,   0,   0,   0,
+      0,   0,   0,   0,   3, 218,  30,   0,   0,  30, 218,   3,   0,   0,   0,   0
+};
+static const unsigned char spritePlayer[8*16] = { // play.png
+      0,   0,   0,   0,   0,   0,  10, 217,  15,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   5, 184, 247, 189,   8,   0,   0,   0,   0,   0,   0,
+      0,   0,   6,   8,   8,  16, 235, 255, 240,  20,   8,   8,   6,   0,   0,   0,
+      0,  13, 185, 228, 228, 229, 252, 255, 253, 230, 228, 228, 191,  13,   0,   0,
+      0, 183, 254, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 190,   0,   0,
+      0, 198, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 205,   0,   0,
+      0, 196, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 203,   0,   0,
+      0, 196, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 203,   0,   0
+};
+static const unsigned char spritePlayerShot[8*1] = { // player_shot.png
+      0,
+      0,
+      0,
+     17,
+    238,
+    255,
+    255,
+    255
+};
+static const unsigned char spriteUfo[8*24] = { // saucer.png
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   1,   8, 181, 202, 202, 202, 202, 181,   8,   1,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,  10, 190, 217, 255, 255, 255, 255, 255, 255, 217, 190,  10,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,  15, 197, 239, 255, 255, 238, 253, 253, 238, 255, 255, 239, 197,  15,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,  26, 210, 255,  77, 228, 252,  78, 240, 240,  78, 252, 228,  77, 255, 210,  26,   0,   0,   0,   0,
+      0,   0,   0,   0, 169, 217, 255, 247, 255, 220, 208, 255, 255, 208, 220, 255, 247, 255, 217, 169,   0,   0,   0,   0,
+      0,   0,   0,   0,   2,   3, 173, 248, 203,  20,  10, 189, 189,  10,  20, 203, 248, 173,   3,   2,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   1, 214,  30,   0,   0,   0,   0,   0,   0,  30, 214,   1,   0,   0,   0,   0,   0,   0
+};
+static const unsigned char spriteRolling1[8*3] = { // rolling1.png
+     10, 188,  10,
+     10, 188,  10,
+     10, 188,  10,
+     10, 188,  10,
+     10, 188,  10,
+     10, 193,  10,
+      8, 149,   8,
+      0,   0,   0
+};
+static const unsigned char spriteRolling2[8*3] = { // rolling2.png
+      9, 188,  10,
+     13, 188,   9,
+    209, 216,  16,
+     33, 219, 213,
+     37, 194,  24,
+    209, 225,  48,
+      6, 175, 200,
+      0,   0,   0
+};
+static const unsigned char spriteRolling3[8*3] = { // rolling3.png
+     10, 188,  10,
+     10, 188,  10,
+     10, 188,  10,
+     10, 188,  10,
+     10, 188,  10,
+     10, 193,  10,
+      8, 149,   8,
+      0,   0,   0
+};
+static const unsigned char spriteRolling4[8*3] = { // rolling4.png
+      1, 221, 255,
+    201, 221,  56,
+     52, 194,  13,
+     20, 217, 213,
+    213, 218,  25,
+     20, 194,   8,
+      7, 148,   8,
+      0,   0,   0
+};
+static const unsigned char spriteAlienExplosion[8*16] = { // alien_exploding.png
+      0,   0,   0,   0,   6, 218,  27,   0,  21, 220,  10,   0,   0,   0,   0,   0,
+      0,   0, 161,  42,   1,  53, 175,  34, 174,  56,   1,  37, 164,   0,   0,   0,
+      0,   0,  35, 179,  44,   0,  38,   8,  38,   0,  39, 180,  37,   0,   0,   0,
+      0,  16,  16,  30, 178,  30,   0,   0,   0,  24, 180,  33,  16,  16,   0,   0,
+      0, 163, 212,  31,  42,   7,   0,   0,   0,   6,  43,  26, 212, 169,   0,   0,
+      0,   8,   5,  40, 178,  25,  38,   8,  38,  20, 179,  43,   6,   8,   0,   0,
+      0,   0,  42, 175,  36,  49, 175,  34, 174,  54,  31, 175,  44,   0,   0,   0,
+      0,   0, 208,  49,   0, 218,  27,   0,  21, 220,   4,  41, 212,   0,   0,   0
+};
+static const unsigned char spriteShotExplosion[8*8] = { // player_shot_exploding.png
+    255,  53,   0,  19, 215,   3,  50, 255,
+     52,  14, 164,  31,  46,  38, 169,  52,
+      2, 172, 253, 221, 210, 224, 207,   2,
+    232, 254, 255, 255, 255, 255, 250, 232,
+    232, 254, 255, 255, 255, 255, 254, 232,
+      2, 172, 253, 215, 220, 253, 172,   2,
+     52,  14, 165,  68,  27, 164,  14,  52,
+    255,  52,   1, 215,  19,   0,  53, 255
+};
+static const unsigned char spriteUfoExplosion[8*24] = { // saucer_exploding.png
+      0,   0,   0, 209,  51,   0, 217,  46, 216,  30,   0,   0,   0,   0,  27, 216,  47, 217,   0,  51, 209,   0,   0,   0,
+      0,   2,   1,  45, 176,  38,  44,  11,  46,   8,   1,   0,  14, 193, 190,  52,   8,  44,  38, 175,  42,   0,   0,   0,
+      0, 163,  49, 157,  79,   7,   4, 187, 212, 215, 207,  24,  13,  60, 244, 191,  12,   1,   7,  38,   3,   0,   0,   0,
+      0,  25,   7,  22,   2,  18, 201, 255, 243, 255, 241, 228, 199,  23,  47, 232, 229, 200,  16,  40, 176,  16,   0,   0,
+      0,   0,   0,  23,   6, 177, 229, 250,  77, 224,  78, 227,  55, 180,   4,  66, 254, 229, 176,   0,  64, 168,   0,   0,
+      0,  36,  12, 162,  42,   9,  12, 183, 245, 221, 245, 199,  12,  13,  66, 243, 185,  12,  17,  37,   1,   8,   0,   0,
+      0, 157,  50,  45,  12,   0,   0,  52, 178,  34, 175,  65,   4,  16, 195, 188,  51,   0,  37, 164,   0,   0,   0,   0,
+      0,   0,   0, 209,  54,   0,   5, 218,  31,   0,  13, 223,  19,   0,   0,  31, 218,   5,   0,   0,   0,   0,   0,   0
+};
+
+static const Sprite alienSprites[3][2] = {
+    { { 16, 8, spriteAlien1A }, { 16, 8, spriteAlien1B } },
+    { { 16, 8, spriteAlien2A }, { 16, 8, spriteAlien2B } },
+    { { 16, 8, spriteAlien3A }, { 16, 8, spriteAlien3B } },
+};
+static const Sprite alienShotSprites[4] = {
+    { 3, 8, spriteRolling1 }, { 3, 8, spriteRolling2 }, { 3, 8, spriteRolling3 }, { 3, 8, spriteRolling4 }
+};
+static const Sprite playerSprite = { 16, 8, spritePlayer };
+static const Sprite playerShotSprite = { 1, 8, spritePlayerShot };
+static const Sprite ufoSprite = { 24, 8, spriteUfo };
+static const Sprite alienExplosionSprite = { 16, 8, spriteAlienExplosion };
+static const Sprite shotExplosionSprite = { 8, 8, spriteShotExplosion };
+static const Sprite ufoExplosionSprite = { 24, 8, spriteUfoExplosion };
+
+static const Glyph font[] = {
+    { '-', { 0x00, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x00 } },
+    { '.', { 0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x0C } },
+    { '0', { 0x0E, 0x11, 0x13, 0x15, 0x19, 0x11, 0x0E } },
+    { '1', { 0x04, 0x0C, 0x04, 0x04, 0x04, 0x04, 0x0E } },
+    { '2', { 0x0E, 0x11, 0x01, 0x02, 0x04, 0x08, 0x1F } },
+    { '3', { 0x1F, 0x02, 0x04, 0x02, 0x01, 0x11, 0x0E } },
+    { '4', { 0x02, 0x06, 0x0A, 0x12, 0x1F, 0x02, 0x02 } },
+    { '5', { 0x1F, 0x10, 0x1E, 0x01, 0x01, 0x11, 0x0E } },
+    { '6', { 0x06, 0x08, 0x10, 0x1E, 0x11, 0x11, 0x0E } },
+    { '7', { 0x1F, 0x01, 0x02, 0x04, 0x08, 0x08, 0x08 } },
+    { '8', { 0x0E, 0x11, 0x11, 0x0E, 0x11, 0x11, 0x0E } },
+    { '9', { 0x0E, 0x11, 0x11, 0x0F, 0x01, 0x02, 0x0C } },
+    { ':', { 0x00, 0x0C, 0x0C, 0x00, 0x0C, 0x0C, 0x00 } },
+    { '<', { 0x02, 0x04, 0x08, 0x10, 0x08, 0x04, 0x02 } },
+    { 'A', { 0x0E, 0x11, 0x11, 0x1F, 0x11, 0x11, 0x11 } },
+    { 'B', { 0x1E, 0x11, 0x11, 0x1E, 0x11, 0x11, 0x1E } },
+    { 'C', { 0x0E, 0x11, 0x10, 0x10, 0x10, 0x11, 0x0E } },
+    { 'D', { 0x1C, 0x12, 0x11, 0x11, 0x11, 0x12, 0x1C } },
+    { 'E', { 0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x1F } },
+    { 'F', { 0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x10 } },
+    { 'G', { 0x0E, 0x11, 0x10, 0x17, 0x11, 0x11, 0x0F } },
+    { 'H', { 0x11, 0x11, 0x11, 0x1F, 0x11, 0x11, 0x11 } },
+    { 'I', { 0x0E, 0x04, 0x04, 0x04, 0x04, 0x04, 0x0E } },
+    { 'J', { 0x07, 0x02, 0x02, 0x02, 0x02, 0x12, 0x0C } },
+    { 'K', { 0x11, 0x12, 0x14, 0x18, 0x14, 0x12, 0x11 } },
+    { 'L', { 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x1F } },
+    { 'M', { 0x11, 0x1B, 0x15, 0x15, 0x11, 0x11, 0x11 } },
+    { 'N', { 0x11, 0x11, 0x19, 0x15, 0x13, 0x11, 0x11 } },
+    { 'O', { 0x0E, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E } },
+    { 'P', { 0x1E, 0x11, 0x11, 0x1E, 0x10, 0x10, 0x10 } },
+    { 'Q', { 0x0E, 0x11, 0x11, 0x11, 0x15, 0x12, 0x0D } },
+    { 'R', { 0x1E, 0x11, 0x11, 0x1E, 0x14, 0x12, 0x11 } },
+    { 'S', { 0x0F, 0x10, 0x10, 0x0E, 0x01, 0x01, 0x1E } },
+    { 'T', { 0x1F, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04 } },
+    { 'U', { 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E } },
+    { 'V', { 0x11, 0x11, 0x11, 0x11, 0x11, 0x0A, 0x04 } },
+    { 'W', { 0x11, 0x11, 0x11, 0x15, 0x15, 0x15, 0x0A } },
+    { 'X', { 0x11, 0x11, 0x0A, 0x04, 0x0A, 0x11, 0x11 } },
+    { 'Y', { 0x11, 0x11, 0x0A, 0x04, 0x04, 0x04, 0x04 } },
+    { 'Z', { 0x1F, 0x01, 0x02, 0x04, 0x08, 0x10, 0x1F } },
+    { '[', { 0x0E, 0x08, 0x08, 0x08, 0x08, 0x08, 0x0E } },
+    { ']', { 0x0E, 0x02, 0x02, 0x02, 0x02, 0x02, 0x0E } },
+};
+
+// Same values as raylib's color defines
+static const Rgb colorWhite = { 255, 255, 255 };
+static const Rgb colorRayWhite = { 245, 245, 245 };
+static const Rgb colorLightGray = { 200, 200, 200 };
+static const Rgb colorRed = { 230, 41, 55 };
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition - Drawing
+//----------------------------------------------------------------------------------
+// Pixels whose center falls inside [start, start + length) in world units
+static void GetPixelSpan(float start, float length, float scale, int limit, int *first, int *last)
+{
+    *first = (int)ceilf(start*scale - 0.5f);
+    *last = (int)ceilf((start + length)*scale - 0.5f);
+    if (*first < 0) *first = 0;
+    if (*last > limit) *last = limit;
+}
+
+static void BlendPixel(unsigned char *pixel, Rgb color, int alpha)
+{
+    if (alpha >= 255) {
+        pixel[0] = color.r;
+        pixel[1] = color.g;
+        pixel[2] = color.b;
+        return;
+    }
+    pixel[0] = (unsigned char)((color.r*alpha + pixel[0]*(255 - alpha) + 127)/255);
+    pixel[1] = (unsigned char)((color.g*alpha + pixel[1]*(255 - alpha) + 127)/255);
+    pixel[2] = (unsigned char)((color.b*alpha + pixel[2]*(255 - alpha) + 127)/255);
+}
+
+// Nearest texel sampling like the GPU path (textures use point filtering)
+static void DrawSprite(Framebuffer *target, const unsigned char *alpha, int width, int height, Rectangle dest, Rgb tint)
+{
+    if ((dest.width <= 0) || (dest.height <= 0)) return;
+
+    float scaleX = (float)target->width/SCREEN_WIDTH, scaleY = (float)target->height/SCREEN_HEIGHT;
+    int x0, x1, y0, y1;
+    GetPixelSpan(dest.x, dest.width, scaleX, target->width, &x0, &x1);
+    GetPixelSpan(dest.y, dest.height, scaleY, target->height, &y0, &y1);
+
+    // Texel coordinate of the first pixel center and its step per pixel
+    float u0 = ((x0 + 0.5f)/scaleX - dest.x)*width/dest.width, stepU = width/(dest.width*scaleX);
+    float v0 = ((y0 + 0.5f)/scaleY - dest.y)*height/dest.height, stepV = height/(dest.height*scaleY);
+
+    for (int py = y0; py < y1; py++) {
+        int v = (int)(v0 + (py - y0)*stepV);
+        if (v > height - 1) v = height - 1;
+        const unsigned char *row = alpha + v*width;
+        unsigned char *pixel = target->pixels + ((size_t)py*target->width + x0)*4;
+
+        for (int px = x0; px < x1; px++, pixel += 4) {
+            int u = (int)(u0 + (px - x0)*stepU);
+            if (u > width - 1) u = width - 1;
+            if (row[u] != 0) BlendPixel(pixel, tint, row[u]);
+        }
+    }
+}
+
+static void DrawSpriteRec(Framebuffer *target, const Sprite *sprite, Rectangle dest, Rgb tint)
+{
+    DrawSprite(target, sprite->alpha, sprite->width, sprite->height, dest, tint);
+}
+
+static const Glyph *FindGlyph(char c)
+{
+    if ((c >= 'a') && (c <= 'z')) c = (char)(c - 'a' + 'A'); // Uppercase only
+
+    // The font table is sorted by character
+    int low = 0, high = (int)(sizeof(font)/sizeof(font[0])) - 1;
+    while (low <= high) {
+        int middle = (low + high)/2;
+        if (font[middle].character == c) return &font[middle];
+        if (font[middle].character < c) low = middle + 1;
+        else high = middle - 1;
+    }
+    return NULL; // Space and anything unknown draw nothing
+}
+
+static int MeasureTextWidth(const char *text, int size)
+{
+    int length = (int)strlen(text);
+    int pixel = size/FONT_BASE_SIZE;
+    return (length > 0) ? (length*(FONT_GLYPH_WIDTH + 1) - 1)*pixel : 0;
+}
+
+static void DrawString(Framebuffer *target, const char *text, int x, int y, int size, Rgb color)
+{
+    int pixel = size/FONT_BASE_SIZE;
+    float scaleX = (float)target->width/SCREEN_WIDTH, scaleY = (float)target->height/SCREEN_HEIGHT;
+
+    // Glyph rows land on the same target rows for the whole string
+    int rowFirst[FONT_GLYPH_HEIGHT], rowLast[FONT_GLYPH_HEIGHT];
+    for (int gy = 0; gy < FONT_GLYPH_HEIGHT; gy++) {
+        GetPixelSpan((float)(y + (gy + 1)*pixel), (float)pixel, scaleY, target->height, &rowFirst[gy], &rowLast[gy]);
+    }
+
+    for (; *text != '\0'; text++, x += (FONT_GLYPH_WIDTH + 1)*pixel) {
+        const Glyph *glyph = FindGlyph(*text);
+        if (glyph == NULL) continue;
+
+        int columnFirst[FONT_GLYPH_WIDTH], columnLast[FONT_GLYPH_WIDTH];
+        for (int gx = 0; gx < FONT_GLYPH_WIDTH; gx++) {
+            GetPixelSpan((float)(x + gx*pixel), (float)pixel, scaleX, target->width, &columnFirst[gx], &columnLast[gx]);
+        }
+
+        for (int gy = 0; gy < FONT_GLYPH_HEIGHT; gy++) {
+            for (int gx = 0; gx < FONT_GLYPH_WIDTH; gx++) {
+                if (((glyph->rows[gy] >> (FONT_GLYPH_WIDTH - 1 - gx)) & 1) == 0) continue;
+                for (int py = rowFirst[gy]; py < rowLast[gy]; py++) {
+                    unsigned char *out = target->pixels + ((size_t)py*target->width + columnFirst[gx])*4;
+                    for (int px = columnFirst[gx]; px < columnLast[gx]; px++, out += 4) BlendPixel(out, color, 255);
+                }
+            }
+        }
+    }
+}
+
+static void DrawStringCentered(Framebuffer *target, const char *text, int y, int size, Rgb color)
+{
+    DrawString(target, text, SCREEN_WIDTH/2 - MeasureTextWidth(text, size)/2, y, size, color);
+}
+
+// Same layout and draw order as DrawBoard() in invaders.c
+static void RasterBoard(const Game *game, Framebuffer *target)
+{
+    for (int i = 0; i < NUM_SHIELDS; i++) {
+        const Shield *shield = &game->shields[i];
+        if (shield->active) DrawSprite(target, &shield->alpha[0][0], SHIELD_TEX_WIDTH, SHIELD_TEX_HEIGHT, shield->bounds, colorWhite);
+    }
+
+    for (int i = 0; i < NUM_ALIENS; i++) {
+        const Alien *alien = &game->aliens[i];
+        if (alien->active) DrawSpriteRec(target, &alienSprites[alien->type][alien->currentFrame ? 1 : 0],
+                                         (Rectangle){ alien->position.x, alien->position.y, alien->size.x, alien->size.y }, colorWhite);
+    }
+
+    const Player *player = &game->player;
+    if (player->exploding) {
+        const Sprite *sprite = &alienExplosionSprite;
+        DrawSpriteRec(target, sprite, (Rectangle){ player->position.x + player->size.x/2 - sprite->width,
+                                                   player->position.y + player->size.y/2 - sprite->height,
+                                                   sprite->width*2.0f, sprite->height*2.0f }, colorWhite);
+    } else if (player->lives > 0) {
+        DrawSpriteRec(target, &playerSprite, (Rectangle){ player->position.x, player->position.y, player->size.x, player->size.y }, colorWhite);
+    }
+
+    if (player->shotActive) {
+        DrawSpriteRec(target, &playerShotSprite, (Rectangle){ player->shotPosition.x, player->shotPosition.y, player->shotSize.x, player->shotSize.y }, colorWhite);
+    }
+
+    // 10 animation frames per second of game time
+    const Sprite *shotSprite = &alienShotSprites[(game->tick*10/GAME_TICK_RATE)%4];
+    for (int i = 0; i < MAX_ALIEN_BULLETS; i++) {
+        const Bullet *bullet = &game->alienBullets[i];
+        if (bullet->active) DrawSpriteRec(target, shotSprite, (Rectangle){ bullet->position.x, bullet->position.y, bullet->size.x, bullet->size.y }, colorWhite);
+    }
+
+    const UFO *ufo = &game->ufo;
+    if (ufo->active) {
+        if (ufo->exploding) {
+            const Sprite *sprite = &ufoExplosionSprite;
+            DrawSpriteRec(target, sprite, (Rectangle){ ufo->position.x + ufo->size.x/2 - sprite->width*1.5f/2,
+                                                       ufo->position.y + ufo->size.y/2 - sprite->height*1.5f/2,
+                                                       sprite->width*1.5f, sprite->height*1.5f }, colorWhite);
+        } else {
+            DrawSpriteRec(target, &ufoSprite, (Rectangle){ ufo->position.x, ufo->position.y, ufo->size.x, ufo->size.y }, colorRed);
+        }
+    }
+
+    for (int i = 0; i < MAX_EXPLOSIONS; i++) {
+        const Explosion *explosion = &game->explosions[i];
+        if (explosion->active) DrawSpriteRec(target, (explosion->type == EXPLOSION_ALIEN) ? &alienExplosionSprite : &shotExplosionSprite,
+                                             (Rectangle){ explosion->position.x, explosion->position.y, explosion->size.x, explosion->size.y }, colorWhite);
+    }
+}
+
+void RasterGame(const Game *game, int hiScore, Framebuffer *target)
+{
+    char text[64];
+
+    // Opaque black: first row pixel by pixel, then row copies
+    size_t rowSize = (size_t)target->width*4;
+    static const unsigned char black[4] = { 0, 0, 0, 255 };
+    for (int x = 0; x < target->width; x++) memcpy(target->pixels + x*4, black, 4);
+    for (int y = 1; y < target->height; y++) memcpy(target->pixels + y*rowSize, target->pixels, rowSize);
+
+    if (game->gameOver) {
+        DrawStringCentered(target, "GAME OVER", SCREEN_HEIGHT/2 - 40, 40, colorRed);
+        snprintf(text, sizeof(text), "FINAL SCORE: %d", game->score);
+        DrawStringCentered(target, text, SCREEN_HEIGHT/2 + 10, 20, colorRayWhite);
+        DrawStringCentered(target, "PRESS [ENTER] or TAP TO RESTART", SCREEN_HEIGHT/2 + 40, 20, colorLightGray);
+        return;
+    }
+
+    RasterBoard(game, target);
+
+    snprintf(text, sizeof(text), "SCORE: %04d", game->score);
+    DrawString(target, text, 10, 10, 20, colorRayWhite);
+    snprintf(text, sizeof(text), "HI-SCORE: %04d", hiScore);
+    DrawString(target, text, SCREEN_WIDTH/2 - MeasureTextWidth("HI-SCORE: 0000", 20)/2, 10, 20, colorRayWhite);
+    snprintf(text, sizeof(text), "WAVE: %d", game->currentWave);
+    DrawString(target, text, SCREEN_WIDTH - 100, SCREEN_HEIGHT - 30, 20, colorLightGray);
+
+    for (int i = 0; i < game->player.lives; i++) {
+        DrawSpriteRec(target, &playerSprite, (Rectangle){ SCREEN_WIDTH - 110 + i*(playerSprite.width*0.7f + 5), 10.0f,
+                                                          playerSprite.width*0.7f, playerSprite.height*0.7f }, colorWhite);
+    }
+    if (game->player.lives > 0) DrawString(target, "LIVES:", SCREEN_WIDTH - 110 - MeasureTextWidth("LIVES: ", 20), 10, 20, colorRayWhite);
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition - PNG export
+//----------------------------------------------------------------------------------
+static const int lengthBase[29] = { 3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+static const int lengthExtra[29] = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+static const int distanceBase[30] = { 1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577 };
+static const int distanceExtra[30] = { 0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+
+static void PutBits(BitWriter *w, uint32_t value, int count)
+{
+    w->bits |= value << w->count;
+    w->count += count;
+    while (w->count >= 8) {
+        w->data[w->size++] = (unsigned char)(w->bits & 0xFF);
+        w->bits >>= 8;
+        w->count -= 8;
+    }
+}
+
+// Huffman codes go out most significant bit first
+static void PutCode(BitWriter *w, unsigned int code, int length)
+{
+    unsigned int reversed = 0;
+    for (int i = 0; i < length; i++) reversed |= ((code >> i) & 1) << (length - 1 - i);
+    PutBits(w, reversed, length);
+}
+
+// Fixed literal/length code of RFC 1951, section 3.2.6
+static void PutSymbol(BitWriter *w, int symbol)
+{
+    if (symbol < 144) PutCode(w, 0x30 + symbol, 8);
+    else if (symbol < 256) PutCode(w, 0x190 + symbol - 144, 9);
+    else if (symbol < 280) PutCode(w, symbol - 256, 7);
+    else PutCode(w, 0xC0 + symbol - 280, 8);
+}
+
+static void PutMatch(BitWriter *w, int length, int distance)
+{
+    int code = 0;
+    while ((code < 28) && (lengthBase[code + 1] <= length)) code++;
+    PutSymbol(w, 257 + code);
+    PutBits(w, length - lengthBase[code], lengthExtra[code]);
+
+    code = 0;
+    while ((code < 29) && (distanceBase[code + 1] <= distance)) code++;
+    PutCode(w, code, 5);
+    PutBits(w, distance - distanceBase[code], distanceExtra[code]);
+}
+
+static unsigned int HashTriple(const unsigned char *data)
+{
+    return ((data[0] << 16 | data[1] << 8 | data[2])*2654435761u) >> (32 - DEFLATE_HASH_BITS);
+}
+
+// zlib stream with one fixed-Huffman block, greedy matching on the newest 3-byte hash hit
+static int Deflate(const unsigned char *data, int size, unsigned char *out, int *head)
+{
+    BitWriter w = { out, 0, 0, 0 };
+    out[w.size++] = 0x78;
+    out[w.size++] = 0x01;
+    PutBits(&w, 1, 1); // Final block
+    PutBits(&w, 1, 2); // Fixed Huffman codes
+
+    for (int i = 0; i < (1 << DEFLATE_HASH_BITS); i++) head[i] = -1;
+
+    int pos = 0;
+    while (pos < size) {
+        int length = 0, distance = 0;
+        if (pos + 2 < size) {
+            unsigned int hash = HashTriple(data + pos);
+            int candidate = head[hash];
+            head[hash] = pos;
+            if ((candidate >= 0) && (pos - candidate <= DEFLATE_WINDOW)) {
+                int limit = (size - pos < DEFLATE_MAX_MATCH) ? size - pos : DEFLATE_MAX_MATCH;
+                while ((length < limit) && (data[candidate + length] == data[pos + length])) length++;
+                distance = pos - candidate;
+            }
+        }
+
+        if (length >= 3) {
+            PutMatch(&w, length, distance);
+            for (int k = 1; k < length; k++) {
+                if (pos + k + 2 < size) head[HashTriple(data + pos + k)] = pos + k;
+            }
+            pos += length;
+        } else {
+            PutSymbol(&w, data[pos]);
+            pos++;
+        }
+    }
+    PutSymbol(&w, 256);
+    if (w.count > 0) PutBits(&w, 0, 8 - w.count);
+
+    uint32_t a = 1, b = 0;
+    for (int i = 0; i < size; i++) {
+        a = (a + data[i])%65521;
+        b = (b + a)%65521;
+    }
+    uint32_t adler = (b << 16) | a;
+    for (int i = 3; i >= 0; i--) out[w.size++] = (unsigned char)(adler >> (8*i));
+
+    return w.size;
+}
+
+static uint32_t Crc32(uint32_t crc, const unsigned char *data, int size)
+{
+    static uint32_t table[256];
+    static bool tableReady = false;
+    if (!tableReady) {
+        for (uint32_t n = 0; n < 256; n++) {
+            uint32_t c = n;
+            for (int k = 0; k < 8; k++) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            table[n] = c;
+        }
+        tableReady = true;
+    }
+
+    crc = ~crc;
+    for (int i = 0; i < size; i++) crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    return ~crc;
+}
+
+static void PutU32BE(unsigned char *dst, uint32_t value)
+{
+    for (int i = 0; i < 4; i++) dst[i] = (unsigned char)(value >> (24 - 8*i));
+}
+
+// Chunk data must already be at out + 8, returns the chunk size
+static int FinishChunk(unsigned char *out, const char *type, int length)
+{
+    PutU32BE(out, (uint32_t)length);
+    memcpy(out + 4, type, 4);
+    PutU32BE(out + 8 + length, Crc32(0, out + 4, length + 4));
+    return length + 12;
+}
+
+unsigned char *EncodePNG(const Framebuffer *image, int *size)
+{
+    int stride = image->width*4 + 1;
+    int rawSize = stride*image->height;
+    int capacity = 8 + 25 + 12 + (rawSize + rawSize/8 + 64) + 12;
+
+    unsigned char *raw = (unsigned char *)GameMalloc(rawSize);
+    int *head = (int *)GameMalloc(sizeof(int)*(1 << DEFLATE_HASH_BITS));
+    unsigned char *out = (unsigned char *)GameMalloc(capacity);
+    if ((raw == NULL) || (head == NULL) || (out == NULL)) {
+        GameFree(raw);
+        GameFree(head);
+        GameFree(out);
+        return NULL;
+    }
+
+    // Filter type 0 on every row keeps the encoding trivially reproducible
+    for (int y = 0; y < image->height; y++) {
+        raw[y*stride] = 0;
+        memcpy(raw + y*stride + 1, image->pixels + (size_t)y*image->width*4, image->width*4);
+    }
+
+    static const unsigned char signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+    int written = 0;
+    memcpy(out, signature, 8);
+    written += 8;
+
+    unsigned char *ihdr = out + written + 8;
+    PutU32BE(ihdr, (uint32_t)image->width);
+    PutU32BE(ihdr + 4, (uint32_t)image->height);
+    ihdr[8] = 8;    // Bit depth
+    ihdr[9] = 6;    // RGBA
+    ihdr[10] = 0;   // Deflate
+    ihdr[11] = 0;   // Adaptive filtering
+    ihdr[12] = 0;   // Not interlaced
+    written += FinishChunk(out + written, "IHDR", 13);
+
+    int compressed = Deflate(raw, rawSize, out + written + 8, head);
+    written += FinishChunk(out + written, "IDAT", compressed);
+    written += FinishChunk(out + written, "IEND", 0);
+
+    GameFree(raw);
+    GameFree(head);
+    *size = written;
+    return out;
+}
+
+bool ExportFramebufferPNG(const Framebuffer *image, const char *fileName)
+{
+    int size = 0;
+    unsigned char *png = EncodePNG(image, &size);
+    if (png == NULL) return false;
+
+    FILE *file = fopen(fileName, "wb");
+    bool ok = (file != NULL) && (fwrite(png, 1, size, file) == (size_t)size);
+    if (file != NULL) ok = (fclose(file) == 0) && ok;
+
+    GameFree(png);
+    return ok;
+}
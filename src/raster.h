@@ -0,0 +1,30 @@
+#ifndef RASTER_H
+#define RASTER_H
+
+// CPU renderer for machines without a GPU: draws the scene DrawGame() shows (shields, aliens,
+// player, shots, UFO, explosions, HUD text) into a caller-owned RGBA8 buffer of any size, from
+// sprite data compiled in from resources/. The output depends only on the game state (the alien
+// shot animation follows the tick, not the clock), so snapshots compare byte for byte.
+
+#include "game.h"
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef struct Framebuffer {
+    int width;
+    int height;
+    unsigned char *pixels;      // width*height*4 bytes, RGBA8, top row first
+} Framebuffer;
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+void RasterGame(const Game *game, int hiScore, Framebuffer *target);    // Whole screen, scaled to the target
+
+// PNG with a fixed-Huffman deflate stream, the same image always gives the same bytes.
+// EncodePNG returns a GameMalloc() block the caller frees with GameFree(), NULL on failure.
+unsigned char *EncodePNG(const Framebuffer *image, int *size);
+bool ExportFramebufferPNG(const Framebuffer *image, const char *fileName);
+
+#endif // RASTER_H
@@ -0,0 +1,174 @@
+#include "replay.h"
+#include "memory.h"
+#include <stdio.h>  // For fopen(), fread(), fwrite(), fseek()
+#include <stdint.h> // For SIZE_MAX
+#include <string.h> // For memset()
+
+//----------------------------------------------------------------------------------
+// Defines
+//----------------------------------------------------------------------------------
+#define REPLAY_MAGIC            0x52564E49 // "INVR"
+#define REPLAY_HEADER_SIZE      20
+#define REPLAY_TICK_SIZE        (1 + 8 + 4*SUBSYSTEM_COUNT)
+#define REPLAY_MIN_CAPACITY     (GAME_TICK_RATE*60) // One minute, grown by doubling
+#define REPLAY_MAX_TICKS        (GAME_TICK_RATE*60*60*24) // A day of play, far beyond any real game
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition - Internal
+//----------------------------------------------------------------------------------
+static void PutU16(unsigned char *dst, uint32_t value) { dst[0] = value & 0xFF; dst[1] = (value >> 8) & 0xFF; }
+static void PutU32(unsigned char *dst, uint32_t value) { PutU16(dst, value & 0xFFFF); PutU16(dst + 2, value >> 16); }
+static void PutU64(unsigned char *dst, uint64_t value) { PutU32(dst, (uint32_t)value); PutU32(dst + 4, (uint32_t)(value >> 32)); }
+static uint32_t GetU16(const unsigned char *src) { return src[0] | ((uint32_t)src[1] << 8); }
+static uint32_t GetU32(const unsigned char *src) { return GetU16(src) | (GetU16(src + 2) << 16); }
+static uint64_t GetU64(const unsigned char *src) { return GetU32(src) | ((uint64_t)GetU32(src + 4) << 32); }
+
+static bool ReplayReserve(Replay *replay, int tickCount)
+{
+    if (tickCount <= replay->capacity) return true;
+    if ((tickCount < 0) || (tickCount > REPLAY_MAX_TICKS)) return false;
+
+    size_t capacity = (replay->capacity > 0) ? (size_t)replay->capacity : REPLAY_MIN_CAPACITY;
+    while (capacity < (size_t)tickCount) capacity *= 2;
+    if (capacity > REPLAY_MAX_TICKS) capacity = REPLAY_MAX_TICKS;
+    if (capacity > SIZE_MAX/sizeof(ReplayTick)) return false;
+
+    ReplayTick *ticks = (ReplayTick *)GameRealloc(replay->ticks, capacity*sizeof(ReplayTick));
+    if (ticks == NULL) return false;
+
+    replay->ticks = ticks;
+    replay->capacity = (int)capacity;
+    return true;
+}
+
+static ReplayTick MakeReplayTick(GameInput input, const Game *game)
+{
+    GameHash hash = HashGameState(game);
+    ReplayTick tick = { PackGameInput(input), hash.total, { 0 } };
+    for (int i = 0; i < SUBSYSTEM_COUNT; i++) tick.subsystem[i] = (uint32_t)hash.subsystem[i];
+    return tick;
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition - Recording
+//----------------------------------------------------------------------------------
+void ReplayBegin(Replay *replay, uint64_t seed)
+{
+    replay->seed = seed;
+    replay->tickCount = 0;
+}
+
+void ReplayRecord(Replay *replay, GameInput input, const Game *game)
+{
+    if (!ReplayReserve(replay, replay->tickCount + 1)) return;
+    replay->ticks[replay->tickCount++] = MakeReplayTick(input, game);
+}
+
+void ReplayTruncate(Replay *replay, int tickCount)
+{
+    if ((tickCount >= 0) && (tickCount < replay->tickCount)) replay->tickCount = tickCount;
+}
+
+void ReplayFree(Replay *replay)
+{
+    GameFree(replay->ticks);
+    memset(replay, 0, sizeof(Replay));
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition - Files
+//----------------------------------------------------------------------------------
+// File layout (all little-endian):
+//   header: u32 magic "INVR", u16 replay version, u16 game state version, u32 tick count, u64 seed
+//   ticks:  u8 input, u64 hash, u32 subsystem hashes[SUBSYSTEM_COUNT]
+bool SaveReplay(const Replay *replay, const char *fileName)
+{
+    FILE *file = fopen(fileName, "wb");
+    if (file == NULL) return false;
+
+    unsigned char buffer[REPLAY_HEADER_SIZE];
+    PutU32(buffer, REPLAY_MAGIC);
+    PutU16(buffer + 4, REPLAY_VERSION);
+    PutU16(buffer + 6, GAME_STATE_VERSION);
+    PutU32(buffer + 8, (uint32_t)replay->tickCount);
+    PutU64(buffer + 12, replay->seed);
+    bool ok = fwrite(buffer, REPLAY_HEADER_SIZE, 1, file) == 1;
+
+    for (int i = 0; ok && (i < replay->tickCount); i++) {
+        const ReplayTick *tick = &replay->ticks[i];
+        unsigned char record[REPLAY_TICK_SIZE];
+        record[0] = tick->input;
+        PutU64(record + 1, tick->hash);
+        for (int s = 0; s < SUBSYSTEM_COUNT; s++) PutU32(record + 9 + 4*s, tick->subsystem[s]);
+        ok = fwrite(record, REPLAY_TICK_SIZE, 1, file) == 1;
+    }
+
+    if (fclose(file) != 0) ok = false;
+    return ok;
+}
+
+bool LoadReplay(Replay *replay, const char *fileName)
+{
+    FILE *file = fopen(fileName, "rb");
+    if (file == NULL) return false;
+
+    unsigned char buffer[REPLAY_HEADER_SIZE];
+    bool ok = (fread(buffer, REPLAY_HEADER_SIZE, 1, file) == 1) &&
+              (GetU32(buffer) == REPLAY_MAGIC) &&
+              (GetU16(buffer + 4) == REPLAY_VERSION) &&
+              (GetU16(buffer + 6) == GAME_STATE_VERSION);
+
+    // The count comes from the file: it has to fit the body that follows before anything is reserved
+    uint32_t tickCount = ok ? GetU32(buffer + 8) : 0;
+    long fileSize = (ok && (fseek(file, 0, SEEK_END) == 0)) ? ftell(file) : -1;
+    if (ok && ((fileSize < REPLAY_HEADER_SIZE) || (fseek(file, REPLAY_HEADER_SIZE, SEEK_SET) != 0))) ok = false;
+    if (ok && ((tickCount > (uint32_t)((fileSize - REPLAY_HEADER_SIZE)/REPLAY_TICK_SIZE)) ||
+               (tickCount > REPLAY_MAX_TICKS) || !ReplayReserve(replay, (int)tickCount))) ok = false;
+
+    if (ok) {
+        replay->seed = GetU64(buffer + 12);
+        replay->tickCount = 0;
+    }
+
+    for (uint32_t i = 0; ok && (i < tickCount); i++) {
+        unsigned char record[REPLAY_TICK_SIZE];
+        if (fread(record, REPLAY_TICK_SIZE, 1, file) != 1) { ok = false; break; }
+
+        ReplayTick *tick = &replay->ticks[replay->tickCount++];
+        tick->input = record[0];
+        tick->hash = GetU64(record + 1);
+        for (int s = 0; s < SUBSYSTEM_COUNT; s++) tick->subsystem[s] = GetU32(record + 9 + 4*s);
+    }
+
+    fclose(file);
+    return ok;
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition - Verification
+//----------------------------------------------------------------------------------
+ReplayCheck VerifyReplay(const Replay *replay)
+{
+    Game game;
+    ReplayCheck check = { true, 0, 0 };
+
+    InitGameState(&game, replay->seed);
+
+    for (int i = 0; i < replay->tickCount; i++) {
+        const ReplayTick *recorded = &replay->ticks[i];
+        GameInput input = UnpackGameInput(recorded->input);
+        UpdateGameState(&game, input);
+
+        ReplayTick actual = MakeReplayTick(input, &game);
+        if (actual.hash != recorded->hash) {
+            check.ok = false;
+            check.divergentTick = i + 1;
+            for (int s = 0; s < SUBSYSTEM_COUNT; s++) {
+                if (actual.subsystem[s] != recorded->subsystem[s]) check.subsystemMask |= 1u << s;
+            }
+            break;
+        }
+    }
+
+    return check;
+}
@@ -0,0 +1,48 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include "game.h"
+
+//----------------------------------------------------------------------------------
+// Defines
+//----------------------------------------------------------------------------------
+#define REPLAY_VERSION          3 // 2: shield rows top first, 3: timers in whole ticks; both change the hashes
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef struct ReplayTick {
+    uint8_t input;                          // PackGameInput() of the input applied this tick
+    uint64_t hash;                          // HashGameState().total after the tick
+    uint32_t subsystem[SUBSYSTEM_COUNT];    // Low half of each subsystem hash, to name what diverged
+} ReplayTick;
+
+// A game is fully described by its seed plus one input per fixed tick (GAME_TICK_TIME)
+typedef struct Replay {
+    uint64_t seed;
+    int tickCount;
+    int capacity;
+    ReplayTick *ticks;
+} Replay;
+
+typedef struct ReplayCheck {
+    bool ok;
+    int divergentTick;                      // First tick (1-based, like Game.tick) whose hash differs, 0 when ok
+    unsigned int subsystemMask;             // Bit per GameSubsystem that differed at that tick
+} ReplayCheck;
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+void ReplayBegin(Replay *replay, uint64_t seed);                        // Game was started with InitGameState(seed)
+void ReplayRecord(Replay *replay, GameInput input, const Game *game);   // Call after each UpdateGameState()
+void ReplayTruncate(Replay *replay, int tickCount);                     // Drop ticks after tickCount (rewind)
+void ReplayFree(Replay *replay);
+
+bool SaveReplay(const Replay *replay, const char *fileName);
+bool LoadReplay(Replay *replay, const char *fileName);
+
+// Re-simulate from the seed and compare every tick hash with the recorded one
+ReplayCheck VerifyReplay(const Replay *replay);
+
+#endif // REPLAY_H
@@ -0,0 +1,162 @@
+#include "rewind.h"
+#include <string.h> // For memcpy()
+
+//----------------------------------------------------------------------------------
+// Defines
+//----------------------------------------------------------------------------------
+#define RUN_HEADER_SIZE         4   // u16 skipped bytes + u16 changed bytes
+#define RUN_MERGE_GAP           RUN_HEADER_SIZE // Unchanged gaps shorter than a header are stored inline
+
+// Worst case: every run costs its header plus its bytes, and runs are separated by gaps of at least RUN_MERGE_GAP
+#define MAX_DELTA_SIZE          (2*sizeof(Game) + RUN_HEADER_SIZE)
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef struct DeltaRecord {
+    int offset;             // Start in deltaBuffer
+    int size;
+} DeltaRecord;
+
+//------------------------------------------------------------------------------------
+// Global Variables Declaration
+//------------------------------------------------------------------------------------
+static unsigned char deltaBuffer[REWIND_BUFFER_SIZE];
+static unsigned char scratch[MAX_DELTA_SIZE];
+static DeltaRecord records[REWIND_MAX_TICKS] = { 0 };
+static int oldest = 0;              // Index of the oldest record in the ring
+static int count = 0;
+static int writeOffset = 0;         // Where the next delta goes in deltaBuffer
+static int bytesUsed = 0;
+static int lastDeltaBytes = 0;
+static Game current = { 0 };        // State the newest delta leads to
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition - Internal
+//----------------------------------------------------------------------------------
+static void WriteU16(unsigned char *dst, int value)
+{
+    dst[0] = (unsigned char)(value & 0xFF);
+    dst[1] = (unsigned char)(value >> 8);
+}
+
+static int ReadU16(const unsigned char *src)
+{
+    return src[0] | (src[1] << 8);
+}
+
+// XOR of the two states as (skip, length, bytes) runs, returns the encoded size
+static int EncodeDelta(const unsigned char *from, const unsigned char *to, int size, unsigned char *out)
+{
+    int written = 0;
+    int pos = 0;
+
+    while (pos < size) {
+        int start = pos;
+        while ((start < size) && (from[start] == to[start])) start++;
+        if (start == size) break;
+
+        // Extend the run until RUN_MERGE_GAP unchanged bytes in a row are found
+        int end = start + 1;
+        int gap = 0;
+        while ((end < size) && (gap < RUN_MERGE_GAP)) {
+            gap = (from[end] == to[end]) ? gap + 1 : 0;
+            end++;
+        }
+        end -= gap;
+
+        WriteU16(out + written, start - pos);
+        WriteU16(out + written + 2, end - start);
+        written += RUN_HEADER_SIZE;
+        for (int i = start; i < end; i++) out[written++] = from[i] ^ to[i];
+
+        pos = end;
+    }
+
+    return written;
+}
+
+static void ApplyDelta(unsigned char *state, const unsigned char *delta, int size)
+{
+    int pos = 0;
+
+    for (int i = 0; i < size; ) {
+        pos += ReadU16(delta + i);
+        int length = ReadU16(delta + i + 2);
+        i += RUN_HEADER_SIZE;
+        for (int k = 0; k < length; k++) state[pos++] ^= delta[i++];
+    }
+}
+
+static void DropOldest(void)
+{
+    bytesUsed -= records[oldest].size;
+    oldest = (oldest + 1)%REWIND_MAX_TICKS;
+    count--;
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+void RewindReset(const Game *game)
+{
+    memcpy(&current, game, GAME_STATE_BYTES);
+    oldest = 0;
+    count = 0;
+    writeOffset = 0;
+    bytesUsed = 0;
+    lastDeltaBytes = 0;
+}
+
+void RewindRecord(const Game *game)
+{
+    int size = EncodeDelta((const unsigned char *)&current, (const unsigned char *)game, (int)GAME_STATE_BYTES, scratch);
+    memcpy(&current, game, GAME_STATE_BYTES);
+    lastDeltaBytes = size;
+
+    if (size > REWIND_BUFFER_SIZE) {
+        // Cannot be stored at all, history restarts from this state
+        while (count > 0) DropOldest();
+        writeOffset = 0;
+        return;
+    }
+
+    // Records are kept contiguous, wrap to the start when the tail cannot hold this one.
+    // Whatever still lives past the writer is the oldest history, it goes with the wrap.
+    if (writeOffset + size > REWIND_BUFFER_SIZE) {
+        while ((count > 0) && (records[oldest].offset >= writeOffset)) DropOldest();
+        writeOffset = 0;
+    }
+
+    if (count == REWIND_MAX_TICKS) DropOldest();
+    while ((count > 0) && (records[oldest].offset < writeOffset + size) &&
+           (writeOffset < records[oldest].offset + records[oldest].size)) DropOldest();
+
+    int index = (oldest + count)%REWIND_MAX_TICKS;
+    records[index] = (DeltaRecord){ writeOffset, size };
+    memcpy(deltaBuffer + writeOffset, scratch, size);
+    writeOffset += size;
+    bytesUsed += size;
+    count++;
+}
+
+bool RewindStep(Game *game)
+{
+    if (count == 0) return false;
+
+    const DeltaRecord *record = &records[(oldest + count - 1)%REWIND_MAX_TICKS];
+    ApplyDelta((unsigned char *)&current, deltaBuffer + record->offset, record->size);
+    writeOffset = record->offset;
+    bytesUsed -= record->size;
+    count--;
+
+    memcpy(game, &current, GAME_STATE_BYTES);
+    game->eventCount = 0;
+    InvalidateShields(game);
+    return true;
+}
+
+RewindStats GetRewindStats(void)
+{
+    return (RewindStats){ count, bytesUsed, lastDeltaBytes };
+}
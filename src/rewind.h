@@ -0,0 +1,32 @@
+#ifndef REWIND_H
+#define REWIND_H
+
+#include "game.h"
+
+//----------------------------------------------------------------------------------
+// Defines
+//----------------------------------------------------------------------------------
+#define REWIND_MAX_TICKS        (60*30)         // History length, 30 seconds at 60 ticks per second
+#define REWIND_BUFFER_SIZE      (2*1024*1024)   // Preallocated delta storage, oldest ticks are dropped when full
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef struct RewindStats {
+    int ticks;              // Ticks that can currently be undone
+    int bytesUsed;          // Delta bytes held for those ticks
+    int lastDeltaBytes;     // Size of the most recent recorded delta
+} RewindStats;
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+// Every tick is stored as the XOR of the state against the previous tick, zero runs
+// skipped. XOR deltas are their own inverse, so stepping back only needs the newest
+// state and the deltas; no keyframes. All storage is static, nothing is allocated.
+void RewindReset(const Game *game);     // Drop the history, the next record deltas against this state
+void RewindRecord(const Game *game);    // Call after every UpdateGameState()
+bool RewindStep(Game *game);            // Undo one tick, returns false when the history is exhausted
+RewindStats GetRewindStats(void);
+
+#endif // REWIND_H
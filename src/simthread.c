@@ -0,0 +1,214 @@
+#include "simthread.h"
+#include "memory.h"
+
+#if !defined(_WIN32) && !defined(PLATFORM_WEB)
+    #define SIMTHREAD_SUPPORTED
+    #include <stdatomic.h>
+    #include <pthread.h>
+    #include <time.h>   // For clock_gettime(), nanosleep()
+#endif
+
+//----------------------------------------------------------------------------------
+// Defines
+//----------------------------------------------------------------------------------
+#define SNAPSHOT_FRESH          4       // Set in the middle slot index while the reader has not taken it
+
+//------------------------------------------------------------------------------------
+// Global Variables Declaration
+//------------------------------------------------------------------------------------
+#if defined(SIMTHREAD_SUPPORTED)
+static pthread_t simThread;
+static atomic_bool simRunning = false;
+static void (*tickCallback)(void) = NULL;
+
+static atomic_int statTicks = 0;
+static atomic_int statDroppedTicks = 0;
+static atomic_int statLastTickUs = 0;
+
+// Triple buffer: the writer owns one slot, the reader another, and the third is swapped between
+// them through middle. Publishing hands over the filled slot and takes back whatever is in the
+// middle; acquiring takes the middle only if it holds something the reader has not seen.
+static unsigned char *snapshots = NULL;
+static int snapshotBytes = 0;
+static int backSlot = 0;                // Sim thread only
+static int frontSlot = 2;               // Render thread only
+static bool frontValid = false;         // Render thread only
+static atomic_int middleSlot = 1;
+
+// Single producer single consumer ring, positions only grow
+static SimCommand commands[SIM_COMMAND_QUEUE_SIZE];
+static atomic_size_t commandHead = 0;   // Written by the render thread
+static atomic_size_t commandTail = 0;   // Written by the sim thread
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition - Thread
+//----------------------------------------------------------------------------------
+#if defined(SIMTHREAD_SUPPORTED)
+static double GetSeconds(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec/1e9;
+}
+
+// Fixed rate with its own clock: the ticks keep their schedule whatever the render thread does
+static void *SimThreadMain(void *arg)
+{
+    (void)arg;
+    double next = GetSeconds();
+
+    while (atomic_load(&simRunning)) {
+        double now = GetSeconds();
+        if (now < next) {
+            double wait = next - now;
+            struct timespec sleep = { (time_t)wait, (long)((wait - (time_t)wait)*1e9) };
+            nanosleep(&sleep, NULL);
+            continue;
+        }
+
+        for (int ticks = 0; (now >= next) && (ticks < SIM_MAX_CATCHUP_TICKS); ticks++) {
+            double start = GetSeconds();
+            tickCallback();
+            atomic_store(&statLastTickUs, (int)((GetSeconds() - start)*1e6));
+            atomic_fetch_add(&statTicks, 1);
+            next += GAME_TICK_TIME;
+        }
+        if (now >= next) {
+            atomic_fetch_add(&statDroppedTicks, (int)((now - next)/GAME_TICK_TIME) + 1);
+            next = now + GAME_TICK_TIME;
+        }
+    }
+
+    return NULL;
+}
+#endif
+
+bool SimThreadStart(int snapshotSize, void (*tick)(void))
+{
+#if defined(SIMTHREAD_SUPPORTED)
+    if (atomic_load(&simRunning) || (snapshotSize <= 0) || (tick == NULL)) return false;
+
+    snapshots = (unsigned char *)GameCalloc(3, snapshotSize);
+    if (snapshots == NULL) return false;
+    snapshotBytes = snapshotSize;
+    backSlot = 0;
+    frontSlot = 2;
+    frontValid = false;
+    atomic_store(&middleSlot, 1);
+    atomic_store(&commandHead, 0);
+    atomic_store(&commandTail, 0);
+    tickCallback = tick;
+
+    atomic_store(&simRunning, true);
+    if (pthread_create(&simThread, NULL, SimThreadMain, NULL) != 0) {
+        atomic_store(&simRunning, false);
+        GameFree(snapshots);
+        snapshots = NULL;
+        return false;
+    }
+    return true;
+#else
+    (void)snapshotSize; (void)tick;
+    return false;
+#endif
+}
+
+void SimThreadStop(void)
+{
+#if defined(SIMTHREAD_SUPPORTED)
+    if (!atomic_load(&simRunning)) return;
+
+    atomic_store(&simRunning, false);
+    pthread_join(simThread, NULL);
+    GameFree(snapshots);
+    snapshots = NULL;
+#endif
+}
+
+bool IsSimThreadRunning(void)
+{
+#if defined(SIMTHREAD_SUPPORTED)
+    return atomic_load(&simRunning);
+#else
+    return false;
+#endif
+}
+
+SimThreadStats GetSimThreadStats(void)
+{
+    SimThreadStats stats = { 0 };
+#if defined(SIMTHREAD_SUPPORTED)
+    stats.ticks = atomic_load(&statTicks);
+    stats.droppedTicks = atomic_load(&statDroppedTicks);
+    stats.lastTickMs = atomic_load(&statLastTickUs)/1000.0f;
+#endif
+    return stats;
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition - Render thread side
+//----------------------------------------------------------------------------------
+bool SimPushCommand(SimCommand command)
+{
+#if defined(SIMTHREAD_SUPPORTED)
+    size_t head = atomic_load_explicit(&commandHead, memory_order_relaxed);
+    if (head - atomic_load_explicit(&commandTail, memory_order_acquire) == SIM_COMMAND_QUEUE_SIZE) return false;
+
+    commands[head & (SIM_COMMAND_QUEUE_SIZE - 1)] = command;
+    atomic_store_explicit(&commandHead, head + 1, memory_order_release);
+    return true;
+#else
+    (void)command;
+    return false;
+#endif
+}
+
+const void *SimAcquireSnapshot(void)
+{
+#if defined(SIMTHREAD_SUPPORTED)
+    if (snapshots == NULL) return NULL;
+
+    if (atomic_load(&middleSlot) & SNAPSHOT_FRESH) {
+        frontSlot = atomic_exchange(&middleSlot, frontSlot) & ~SNAPSHOT_FRESH;
+        frontValid = true;
+    }
+    return frontValid ? snapshots + (size_t)frontSlot*snapshotBytes : NULL;
+#else
+    return NULL;
+#endif
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition - Simulation thread side
+//----------------------------------------------------------------------------------
+bool SimPopCommand(SimCommand *command)
+{
+#if defined(SIMTHREAD_SUPPORTED)
+    size_t tail = atomic_load_explicit(&commandTail, memory_order_relaxed);
+    if (tail == atomic_load_explicit(&commandHead, memory_order_acquire)) return false;
+
+    *command = commands[tail & (SIM_COMMAND_QUEUE_SIZE - 1)];
+    atomic_store_explicit(&commandTail, tail + 1, memory_order_release);
+    return true;
+#else
+    (void)command;
+    return false;
+#endif
+}
+
+void *SimGetBackBuffer(void)
+{
+#if defined(SIMTHREAD_SUPPORTED)
+    return snapshots + (size_t)backSlot*snapshotBytes;
+#else
+    return NULL;
+#endif
+}
+
+void SimPublish(void)
+{
+#if defined(SIMTHREAD_SUPPORTED)
+    backSlot = atomic_exchange(&middleSlot, backSlot | SNAPSHOT_FRESH) & ~SNAPSHOT_FRESH;
+#endif
+}
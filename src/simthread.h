@@ -0,0 +1,63 @@
+#ifndef SIMTHREAD_H
+#define SIMTHREAD_H
+
+// Runs the simulation on its own thread at GAME_TICK_RATE, so a slow frame or a vsync wait in
+// EndDrawing() delays neither input nor the ticks. Two lock-free channels join the threads:
+//  - commands, render -> sim: input changes and requests (pause, rewind, ...), SPSC ring
+//  - snapshots, sim -> render: triple buffer, the sim always has a free slot to fill and the
+//    renderer always gets the newest complete one; neither side ever waits for the other
+// Sounds take the audio queue (see audio.h), so none is lost when a frame is late.
+// The snapshot layout is the caller's, this module only moves bytes.
+// POSIX only: SimThreadStart() returns false on Windows and web, the caller keeps ticking in its frame.
+
+#include "game.h"
+
+//----------------------------------------------------------------------------------
+// Defines
+//----------------------------------------------------------------------------------
+#define SIM_COMMAND_QUEUE_SIZE  256     // Power of two
+#define SIM_MAX_CATCHUP_TICKS   5       // Ticks run back to back after a stall, the rest is dropped
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef enum SimCommandType {
+    SIM_COMMAND_INPUT = 0,      // Held keys changed or fire was pressed
+    SIM_COMMAND_START,          // New game with seed param, ticks run from now on
+    SIM_COMMAND_HALT,           // Stop ticking (title screen)
+    SIM_COMMAND_PAUSE,          // Toggle pause
+    SIM_COMMAND_REWIND,         // param 1 while rewinding is held, 0 on release
+    SIM_COMMAND_QUICKSAVE,
+    SIM_COMMAND_QUICKLOAD
+} SimCommandType;
+
+typedef struct SimCommand {
+    SimCommandType type;
+    GameInput input;            // SIM_COMMAND_INPUT: held keys, fire set on a press
+    uint32_t param;
+} SimCommand;
+
+typedef struct SimThreadStats {
+    int ticks;                  // Ticks run since start
+    int droppedTicks;           // Ticks skipped after stalls longer than SIM_MAX_CATCHUP_TICKS
+    float lastTickMs;           // Time the last tick callback took
+} SimThreadStats;
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+bool SimThreadStart(int snapshotSize, void (*tick)(void));  // tick() runs on the new thread every GAME_TICK_TIME
+void SimThreadStop(void);                                   // Joins the thread, tick() is not called anymore
+bool IsSimThreadRunning(void);
+SimThreadStats GetSimThreadStats(void);
+
+// Render thread side
+bool SimPushCommand(SimCommand command);    // false when the queue is full
+const void *SimAcquireSnapshot(void);       // Newest published snapshot, valid until the next call; NULL before the first
+
+// Simulation thread side, from tick()
+bool SimPopCommand(SimCommand *command);
+void *SimGetBackBuffer(void);               // Slot to fill completely, then SimPublish()
+void SimPublish(void);
+
+#endif // SIMTHREAD_H
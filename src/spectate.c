@@ -0,0 +1,715 @@
+#include "spectate.h"
+#include <string.h> // For memcpy(), memmove(), strchr()
+#include <stdlib.h> // For atoi()
+
+#if !defined(_WIN32) && !defined(PLATFORM_WEB)
+    #define SPECTATE_SUPPORTED
+    #include <stdatomic.h>
+    #include <pthread.h>
+    #include <sys/socket.h>
+    #include <sys/un.h>
+    #include <sys/time.h>
+    #include <netinet/in.h>
+    #include <netinet/tcp.h>
+    #include <arpa/inet.h>
+    #include <poll.h>
+    #include <fcntl.h>
+    #include <errno.h>
+    #include <unistd.h>
+#endif
+
+//----------------------------------------------------------------------------------
+// Defines
+//----------------------------------------------------------------------------------
+#define MESSAGE_HEADER_SIZE     7       // u16 payload size, u8 type, u32 tick
+#define SENDER_IDLE_MS          1       // Sender thread poll interval when the queue is empty
+
+#if !defined(MSG_NOSIGNAL)
+    #define MSG_NOSIGNAL        0       // macOS: SO_NOSIGPIPE is set on the socket instead
+#endif
+
+// Sections of a delta message, present when their bit is set, in this order
+#define DELTA_STATUS            0x01    // i32 score, u8 lives, u8 wave, u8 game over
+#define DELTA_ALIVE             0x02    // u64 alien alive bits that flipped
+#define DELTA_FORMATION         0x04    // vec2 formation offset, u8 animation frame
+#define DELTA_PLAYER            0x08    // f32 x, u8 flags (1 exploding, 2 shot), [vec2 shot]
+#define DELTA_BULLETS           0x10    // u16 active mask, vec2 per active bullet
+#define DELTA_UFO               0x20    // u8 flags (1 active, 2 exploding), vec2 position
+#define DELTA_EXPLOSIONS        0x40    // u16 active mask, per active: u8 type, vec2 position, vec2 size
+#define DELTA_CRATERS           0x80    // u8 count, per shield: u8 index, u8 x0 y0 x1 y1, bits of cleared texels
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef enum MessageType { MESSAGE_KEYFRAME = 1, MESSAGE_DELTA } MessageType;
+
+typedef struct Writer {
+    unsigned char *data;
+    int size;
+} Writer;
+
+typedef struct Reader {
+    const unsigned char *data;
+    int size;
+    int offset;
+    bool overflow;
+} Reader;
+
+//------------------------------------------------------------------------------------
+// Global Variables Declaration
+//------------------------------------------------------------------------------------
+static SpectateStats stats = { 0 };
+static bool viewSynced = false;
+
+#if defined(SPECTATE_SUPPORTED)
+static Game published = { 0 };             // State the viewers have after the last queued message
+static bool havePublished = false;
+static bool publishing = false;
+static pthread_t senderThread;
+static atomic_bool senderRunning = false;
+static atomic_bool keyframeRequested = false;   // Set by the sender when a viewer joins
+static atomic_int viewerCount = 0;
+static atomic_int bytesSent = 0;
+
+// Single producer (game thread), single consumer (sender thread) byte ring.
+// Positions only grow; the producer publishes a whole message by releasing queueHead.
+static unsigned char queue[SPECTATE_QUEUE_SIZE];
+static atomic_size_t queueHead = 0;
+static atomic_size_t queueTail = 0;
+
+static int listenSock = -1;
+static int viewers[SPECTATE_MAX_VIEWERS];
+static bool viewerSynced[SPECTATE_MAX_VIEWERS];  // Got a keyframe, deltas can follow
+static char unixPath[108] = { 0 };
+
+static int viewSock = -1;
+static int recvSize = 0;
+static unsigned char recvBuffer[2*SPECTATE_MESSAGE_MAX];
+#endif
+
+#if defined(SPECTATE_SUPPORTED)
+//----------------------------------------------------------------------------------
+// Module Functions Definition - Encoding
+//----------------------------------------------------------------------------------
+static void PutU8(Writer *w, unsigned int value) { w->data[w->size++] = (unsigned char)value; }
+static void PutU16(Writer *w, unsigned int value) { PutU8(w, value & 0xFF); PutU8(w, (value >> 8) & 0xFF); }
+static void PutU32(Writer *w, uint32_t value) { PutU16(w, value & 0xFFFF); PutU16(w, value >> 16); }
+static void PutU64(Writer *w, uint64_t value) { PutU32(w, (uint32_t)value); PutU32(w, (uint32_t)(value >> 32)); }
+static void PutF32(Writer *w, float value) { uint32_t bits; memcpy(&bits, &value, 4); PutU32(w, bits); }
+static void PutVec2(Writer *w, Vector2 v) { PutF32(w, v.x); PutF32(w, v.y); }
+
+static unsigned int GetU8(Reader *r)
+{
+    if (r->offset + 1 > r->size) { r->overflow = true; return 0; }
+    return r->data[r->offset++];
+}
+static unsigned int GetU16(Reader *r) { unsigned int lo = GetU8(r); return lo | (GetU8(r) << 8); }
+static uint32_t GetU32(Reader *r) { uint32_t lo = GetU16(r); return lo | ((uint32_t)GetU16(r) << 16); }
+static uint64_t GetU64(Reader *r) { uint64_t lo = GetU32(r); return lo | ((uint64_t)GetU32(r) << 32); }
+static float GetF32(Reader *r) { uint32_t bits = GetU32(r); float value; memcpy(&value, &bits, 4); return value; }
+static Vector2 GetVec2(Reader *r) { Vector2 v; v.x = GetF32(r); v.y = GetF32(r); return v; }
+
+static bool SameVec2(Vector2 a, Vector2 b) { return (a.x == b.x) && (a.y == b.y); }
+
+// Live aliens all share one offset from their grid slot, dead ones keep wherever they died
+static bool GetFormation(const Game *game, Vector2 *offset, bool *frame)
+{
+    for (int i = 0; i < NUM_ALIENS; i++) {
+        const Alien *alien = &game->aliens[i];
+        if (!alien->active) continue;
+        *offset = (Vector2){ alien->position.x - alien->basePosition.x, alien->position.y - alien->basePosition.y };
+        *frame = alien->currentFrame;
+        return true;
+    }
+    return false;
+}
+
+static uint64_t GetAliveBits(const Game *game)
+{
+    uint64_t bits = 0;
+    for (int i = 0; i < NUM_ALIENS; i++) if (game->aliens[i].active) bits |= 1ULL << i;
+    return bits;
+}
+
+// Shields only ever lose texels between keyframes. Returns false when a change is not a crater.
+static bool EncodeCraters(const Game *from, const Game *to, Writer *w)
+{
+    int countOffset = w->size;
+    int count = 0;
+    PutU8(w, 0);
+
+    for (int s = 0; s < NUM_SHIELDS; s++) {
+        if (from->shields[s].active != to->shields[s].active) return false;
+
+        int x0 = SHIELD_TEX_WIDTH, y0 = SHIELD_TEX_HEIGHT, x1 = -1, y1 = -1;
+        for (int y = 0; y < SHIELD_TEX_HEIGHT; y++) {
+            for (int x = 0; x < SHIELD_TEX_WIDTH; x++) {
+                unsigned char before = from->shields[s].alpha[y][x], after = to->shields[s].alpha[y][x];
+                if (before == after) continue;
+                if (after != 0) return false;
+                if (x < x0) x0 = x;
+                if (y < y0) y0 = y;
+                if (x > x1) x1 = x;
+                if (y > y1) y1 = y;
+            }
+        }
+        if (x1 < 0) continue;
+
+        PutU8(w, s);
+        PutU8(w, x0); PutU8(w, y0); PutU8(w, x1); PutU8(w, y1);
+        int bit = 0;
+        unsigned int packed = 0;
+        for (int y = y0; y <= y1; y++) {
+            for (int x = x0; x <= x1; x++) {
+                if (from->shields[s].alpha[y][x] != to->shields[s].alpha[y][x]) packed |= 1u << bit;
+                if (++bit == 8) { PutU8(w, packed); bit = 0; packed = 0; }
+            }
+        }
+        if (bit > 0) PutU8(w, packed);
+        count++;
+    }
+
+    w->data[countOffset] = (unsigned char)count;
+    if (count == 0) w->size = countOffset;
+    return true;
+}
+
+// Payload of a delta message, or -1 when the change needs a keyframe
+static int EncodeDelta(const Game *from, const Game *to, unsigned char *out)
+{
+    Writer w = { out, 1 };
+    unsigned int flags = 0;
+
+    if ((from->score != to->score) || (from->player.lives != to->player.lives) ||
+        (from->currentWave != to->currentWave) || (from->gameOver != to->gameOver)) {
+        flags |= DELTA_STATUS;
+        PutU32(&w, (uint32_t)to->score);
+        PutU8(&w, to->player.lives);
+        PutU8(&w, to->currentWave);
+        PutU8(&w, to->gameOver);
+    }
+
+    uint64_t flipped = GetAliveBits(from) ^ GetAliveBits(to);
+    if (flipped != 0) {
+        flags |= DELTA_ALIVE;
+        PutU64(&w, flipped);
+    }
+
+    Vector2 offsetFrom = { 0 }, offsetTo = { 0 };
+    bool frameFrom = false, frameTo = false;
+    bool formationFrom = GetFormation(from, &offsetFrom, &frameFrom);
+    if (GetFormation(to, &offsetTo, &frameTo) &&
+        (!formationFrom || !SameVec2(offsetFrom, offsetTo) || (frameFrom != frameTo))) {
+        flags |= DELTA_FORMATION;
+        PutVec2(&w, offsetTo);
+        PutU8(&w, frameTo);
+    }
+
+    const Player *pa = &from->player, *pb = &to->player;
+    if ((pa->position.x != pb->position.x) || (pa->exploding != pb->exploding) ||
+        (pa->shotActive != pb->shotActive) || (pb->shotActive && !SameVec2(pa->shotPosition, pb->shotPosition))) {
+        flags |= DELTA_PLAYER;
+        PutF32(&w, pb->position.x);
+        PutU8(&w, (pb->exploding ? 1 : 0) | (pb->shotActive ? 2 : 0));
+        if (pb->shotActive) PutVec2(&w, pb->shotPosition);
+    }
+
+    bool bulletsChanged = false;
+    unsigned int bulletMask = 0;
+    for (int i = 0; i < MAX_ALIEN_BULLETS; i++) {
+        const Bullet *a = &from->alienBullets[i], *b = &to->alienBullets[i];
+        if (b->active) bulletMask |= 1u << i;
+        if ((a->active != b->active) || (b->active && !SameVec2(a->position, b->position))) bulletsChanged = true;
+    }
+    if (bulletsChanged) {
+        flags |= DELTA_BULLETS;
+        PutU16(&w, bulletMask);
+        for (int i = 0; i < MAX_ALIEN_BULLETS; i++) if (to->alienBullets[i].active) PutVec2(&w, to->alienBullets[i].position);
+    }
+
+    const UFO *ua = &from->ufo, *ub = &to->ufo;
+    if ((ua->active != ub->active) || (ua->exploding != ub->exploding) || (ub->active && !SameVec2(ua->position, ub->position))) {
+        flags |= DELTA_UFO;
+        PutU8(&w, (ub->active ? 1 : 0) | (ub->exploding ? 2 : 0));
+        PutVec2(&w, ub->position);
+    }
+
+    bool explosionsChanged = false;
+    unsigned int explosionMask = 0;
+    for (int i = 0; i < MAX_EXPLOSIONS; i++) {
+        const Explosion *a = &from->explosions[i], *b = &to->explosions[i];
+        if (b->active) explosionMask |= 1u << i;
+        if ((a->active != b->active) || (b->active && ((a->type != b->type) || !SameVec2(a->position, b->position)))) explosionsChanged = true;
+    }
+    if (explosionsChanged) {
+        flags |= DELTA_EXPLOSIONS;
+        PutU16(&w, explosionMask);
+        for (int i = 0; i < MAX_EXPLOSIONS; i++) {
+            const Explosion *explosion = &to->explosions[i];
+            if (!explosion->active) continue;
+            PutU8(&w, explosion->type);
+            PutVec2(&w, explosion->position);
+            PutVec2(&w, explosion->size);
+        }
+    }
+
+    int cratersOffset = w.size;
+    if (!EncodeCraters(from, to, &w)) return -1;
+    if (w.size > cratersOffset) flags |= DELTA_CRATERS;
+
+    out[0] = (unsigned char)flags;
+    return w.size;
+}
+
+static void MarkShieldDirty(Game *game, int shieldIndex, int x0, int y0, int x1, int y1)
+{
+    ShieldDirty *dirty = &game->shieldDirty[shieldIndex];
+    if (x0 < dirty->x0) dirty->x0 = x0;
+    if (y0 < dirty->y0) dirty->y0 = y0;
+    if (x1 > dirty->x1) dirty->x1 = x1;
+    if (y1 > dirty->y1) dirty->y1 = y1;
+}
+
+static void ApplyFormation(Game *game, Vector2 offset, bool frame)
+{
+    for (int i = 0; i < NUM_ALIENS; i++) {
+        Alien *alien = &game->aliens[i];
+        alien->position = (Vector2){ alien->basePosition.x + offset.x, alien->basePosition.y + offset.y };
+        alien->currentFrame = frame;
+    }
+}
+
+static bool ApplyDelta(Game *game, const unsigned char *data, int size)
+{
+    Reader r = { data, size, 0, false };
+    unsigned int flags = GetU8(&r);
+
+    if (flags & DELTA_STATUS) {
+        game->score = (int)GetU32(&r);
+        game->player.lives = (int)GetU8(&r);
+        game->currentWave = (int)GetU8(&r);
+        game->gameOver = GetU8(&r) != 0;
+    }
+
+    if (flags & DELTA_ALIVE) {
+        uint64_t flipped = GetU64(&r);
+        for (int i = 0; i < NUM_ALIENS; i++) {
+            if ((flipped >> i) & 1) game->aliens[i].active = !game->aliens[i].active;
+        }
+    }
+
+    if (flags & DELTA_FORMATION) {
+        Vector2 offset = GetVec2(&r);
+        ApplyFormation(game, offset, GetU8(&r) != 0);
+    }
+
+    if (flags & DELTA_PLAYER) {
+        game->player.position.x = GetF32(&r);
+        unsigned int bits = GetU8(&r);
+        game->player.exploding = (bits & 1) != 0;
+        game->player.shotActive = (bits & 2) != 0;
+        if (game->player.shotActive) game->player.shotPosition = GetVec2(&r);
+    }
+
+    if (flags & DELTA_BULLETS) {
+        unsigned int mask = GetU16(&r);
+        for (int i = 0; i < MAX_ALIEN_BULLETS; i++) {
+            game->alienBullets[i].active = (mask >> i) & 1;
+            if (game->alienBullets[i].active) game->alienBullets[i].position = GetVec2(&r);
+        }
+    }
+
+    if (flags & DELTA_UFO) {
+        unsigned int bits = GetU8(&r);
+        game->ufo.active = (bits & 1) != 0;
+        game->ufo.exploding = (bits & 2) != 0;
+        game->ufo.position = GetVec2(&r);
+    }
+
+    if (flags & DELTA_EXPLOSIONS) {
+        unsigned int mask = GetU16(&r);
+        for (int i = 0; i < MAX_EXPLOSIONS; i++) {
+            Explosion *explosion = &game->explosions[i];
+            explosion->active = (mask >> i) & 1;
+            if (!explosion->active) continue;
+            explosion->type = (ExplosionType)GetU8(&r);
+            explosion->position = GetVec2(&r);
+            explosion->size = GetVec2(&r);
+        }
+    }
+
+    if (flags & DELTA_CRATERS) {
+        int count = (int)GetU8(&r);
+        for (int c = 0; (c < count) && !r.overflow; c++) {
+            int s = (int)GetU8(&r);
+            int x0 = (int)GetU8(&r), y0 = (int)GetU8(&r), x1 = (int)GetU8(&r), y1 = (int)GetU8(&r);
+            if ((s >= NUM_SHIELDS) || (x0 > x1) || (y0 > y1) || (x1 >= SHIELD_TEX_WIDTH) || (y1 >= SHIELD_TEX_HEIGHT)) return false;
+
+            int bit = 8;
+            unsigned int packed = 0;
+            for (int y = y0; y <= y1; y++) {
+                for (int x = x0; x <= x1; x++) {
+                    if (bit == 8) { packed = GetU8(&r); bit = 0; }
+                    if ((packed >> bit++) & 1) game->shields[s].alpha[y][x] = 0;
+                }
+            }
+            MarkShieldDirty(game, s, x0, y0, x1, y1);
+        }
+    }
+
+    return !r.overflow && (r.offset == r.size);
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition - Publisher
+//----------------------------------------------------------------------------------
+static bool QueuePush(const unsigned char *data, int size)
+{
+    size_t head = atomic_load_explicit(&queueHead, memory_order_relaxed);
+    size_t tail = atomic_load_explicit(&queueTail, memory_order_acquire);
+    if (SPECTATE_QUEUE_SIZE - (head - tail) < (size_t)size) return false;
+
+    size_t start = head%SPECTATE_QUEUE_SIZE;
+    size_t first = ((size_t)size < SPECTATE_QUEUE_SIZE - start) ? (size_t)size : SPECTATE_QUEUE_SIZE - start;
+    memcpy(queue + start, data, first);
+    memcpy(queue, data + first, size - first);
+    atomic_store_explicit(&queueHead, head + size, memory_order_release);
+    return true;
+}
+
+static void QueueRead(size_t position, unsigned char *out, size_t size)
+{
+    size_t start = position%SPECTATE_QUEUE_SIZE;
+    size_t first = (size < SPECTATE_QUEUE_SIZE - start) ? size : SPECTATE_QUEUE_SIZE - start;
+    memcpy(out, queue + start, first);
+    memcpy(out + first, queue, size - first);
+}
+
+// Next whole message, returns its size or 0 when the queue is empty
+static int QueuePop(unsigned char *out)
+{
+    size_t tail = atomic_load_explicit(&queueTail, memory_order_relaxed);
+    size_t head = atomic_load_explicit(&queueHead, memory_order_acquire);
+    if (head == tail) return 0;
+
+    unsigned char header[2];
+    QueueRead(tail, header, 2);
+    int size = MESSAGE_HEADER_SIZE + (header[0] | (header[1] << 8));
+    QueueRead(tail, out, size);
+    atomic_store_explicit(&queueTail, tail + size, memory_order_release);
+    return size;
+}
+
+static void DropViewer(int index)
+{
+    close(viewers[index]);
+    viewers[index] = -1;
+    atomic_fetch_sub(&viewerCount, 1);
+}
+
+static void AcceptViewers(void)
+{
+    int client;
+    while ((client = accept(listenSock, NULL, NULL)) >= 0) {
+        int slot = -1;
+        for (int i = 0; (i < SPECTATE_MAX_VIEWERS) && (slot < 0); i++) if (viewers[i] < 0) slot = i;
+        if (slot < 0) {
+            close(client);
+            continue;
+        }
+
+        // Blocking writes with a timeout: a stuck viewer costs the sender thread, never the game
+        int flags = fcntl(client, F_GETFL, 0);
+        fcntl(client, F_SETFL, flags & ~O_NONBLOCK);
+        struct timeval timeout = { 0, 200000 };
+        setsockopt(client, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+        int one = 1;
+        setsockopt(client, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one)); // Fails harmlessly on Unix sockets
+#if defined(SO_NOSIGPIPE)
+        setsockopt(client, SOL_SOCKET, SO_NOSIGPIPE, &one, sizeof(one));
+#endif
+        viewers[slot] = client;
+        viewerSynced[slot] = false;
+        atomic_fetch_add(&viewerCount, 1);
+        atomic_store(&keyframeRequested, true);
+    }
+}
+
+static bool SendAll(int fd, const unsigned char *data, int size)
+{
+    while (size > 0) {
+        ssize_t sent = send(fd, data, size, MSG_NOSIGNAL);
+        if (sent <= 0) {
+            if ((sent < 0) && (errno == EINTR)) continue;
+            return false;
+        }
+        data += sent;
+        size -= (int)sent;
+    }
+    return true;
+}
+
+static void *SenderMain(void *arg)
+{
+    (void)arg;
+    static unsigned char message[SPECTATE_MESSAGE_MAX];
+
+    while (atomic_load(&senderRunning)) {
+        AcceptViewers();
+
+        int size = QueuePop(message);
+        if (size == 0) {
+            struct pollfd pending = { listenSock, POLLIN, 0 };
+            poll(&pending, 1, SENDER_IDLE_MS);
+            continue;
+        }
+
+        for (int i = 0; i < SPECTATE_MAX_VIEWERS; i++) {
+            if (viewers[i] < 0) continue;
+            if (message[2] == MESSAGE_KEYFRAME) viewerSynced[i] = true;
+            if (!viewerSynced[i]) continue;
+            if (SendAll(viewers[i], message, size)) atomic_fetch_add(&bytesSent, size);
+            else DropViewer(i);
+        }
+    }
+
+    return NULL;
+}
+
+static int OpenListenSocket(const char *endpoint)
+{
+    int sock = -1;
+
+    if (strchr(endpoint, '/') != NULL) {
+        struct sockaddr_un address = { 0 };
+        if (strlen(endpoint) >= sizeof(address.sun_path)) return -1;
+        address.sun_family = AF_UNIX;
+        strcpy(address.sun_path, endpoint);
+        unlink(endpoint); // Left behind by a previous run
+        sock = (int)socket(AF_UNIX, SOCK_STREAM, 0);
+        if ((sock >= 0) && (bind(sock, (struct sockaddr *)&address, sizeof(address)) != 0)) {
+            close(sock);
+            return -1;
+        }
+        strcpy(unixPath, endpoint);
+    } else {
+        struct sockaddr_in address = { 0 };
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_ANY);
+        address.sin_port = htons((uint16_t)atoi(endpoint));
+        sock = (int)socket(AF_INET, SOCK_STREAM, 0);
+        int one = 1;
+        if (sock >= 0) setsockopt(sock, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+        if ((sock >= 0) && (bind(sock, (struct sockaddr *)&address, sizeof(address)) != 0)) {
+            close(sock);
+            return -1;
+        }
+    }
+
+    if ((sock < 0) || (listen(sock, SPECTATE_MAX_VIEWERS) != 0)) {
+        if (sock >= 0) close(sock);
+        return -1;
+    }
+    fcntl(sock, F_SETFL, fcntl(sock, F_GETFL, 0) | O_NONBLOCK);
+    return sock;
+}
+#endif
+
+bool SpectatePublishStart(const char *endpoint)
+{
+#if defined(SPECTATE_SUPPORTED)
+    SpectatePublishStop();
+    listenSock = OpenListenSocket(endpoint);
+    if (listenSock < 0) return false;
+
+    for (int i = 0; i < SPECTATE_MAX_VIEWERS; i++) viewers[i] = -1;
+    atomic_store(&queueHead, 0);
+    atomic_store(&queueTail, 0);
+    atomic_store(&viewerCount, 0);
+    atomic_store(&bytesSent, 0);
+    atomic_store(&keyframeRequested, false);
+    stats = (SpectateStats){ 0 };
+    havePublished = false;
+
+    atomic_store(&senderRunning, true);
+    if (pthread_create(&senderThread, NULL, SenderMain, NULL) != 0) {
+        atomic_store(&senderRunning, false);
+        close(listenSock);
+        listenSock = -1;
+        return false;
+    }
+
+    publishing = true;
+    return true;
+#else
+    (void)endpoint;
+    return false; // Needs POSIX sockets and threads
+#endif
+}
+
+void SpectatePublishStop(void)
+{
+#if defined(SPECTATE_SUPPORTED)
+    if (!publishing) return;
+
+    atomic_store(&senderRunning, false);
+    pthread_join(senderThread, NULL);
+    for (int i = 0; i < SPECTATE_MAX_VIEWERS; i++) if (viewers[i] >= 0) DropViewer(i);
+    close(listenSock);
+    listenSock = -1;
+    if (unixPath[0] != '\0') unlink(unixPath);
+    unixPath[0] = '\0';
+    publishing = false;
+#endif
+}
+
+void SpectatePublish(const Game *game)
+{
+#if defined(SPECTATE_SUPPORTED)
+    if (!publishing) return;
+
+    static unsigned char message[SPECTATE_MESSAGE_MAX];
+    unsigned char *payload = message + MESSAGE_HEADER_SIZE;
+
+    // Keyframes when a viewer joins, and when the layout changes or time jumps (new wave, restart, rewind)
+    bool requested = atomic_exchange(&keyframeRequested, false);
+    bool keyframe = requested || !havePublished || (game->currentWave != published.currentWave) || (game->tick != published.tick + 1);
+
+    int size = keyframe ? -1 : EncodeDelta(&published, game, payload);
+    if (size < 0) {
+        keyframe = true;
+        size = SaveState(game, payload, SPECTATE_MESSAGE_MAX - MESSAGE_HEADER_SIZE);
+    }
+
+    message[0] = (unsigned char)(size & 0xFF);
+    message[1] = (unsigned char)(size >> 8);
+    message[2] = keyframe ? MESSAGE_KEYFRAME : MESSAGE_DELTA;
+    for (int i = 0; i < 4; i++) message[3 + i] = (unsigned char)(game->tick >> (8*i));
+
+    if (!QueuePush(message, MESSAGE_HEADER_SIZE + size)) {
+        stats.dropped++;
+        havePublished = false; // Viewers missed this one, resynchronize with the next message
+        return;
+    }
+
+    if (keyframe) stats.keyframes++;
+    else stats.deltas++;
+    stats.lastMessageBytes = MESSAGE_HEADER_SIZE + size;
+    memcpy(&published, game, GAME_STATE_BYTES);
+    havePublished = true;
+#else
+    (void)game;
+#endif
+}
+
+SpectateStats GetSpectateStats(void)
+{
+    SpectateStats result = stats;
+#if defined(SPECTATE_SUPPORTED)
+    result.viewers = atomic_load(&viewerCount);
+    result.bytesSent = atomic_load(&bytesSent);
+#endif
+    return result;
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition - Viewer
+//----------------------------------------------------------------------------------
+bool SpectateViewStart(const char *endpoint)
+{
+#if defined(SPECTATE_SUPPORTED)
+    SpectateViewStop();
+
+    if (strchr(endpoint, '/') != NULL) {
+        struct sockaddr_un address = { 0 };
+        if (strlen(endpoint) >= sizeof(address.sun_path)) return false;
+        address.sun_family = AF_UNIX;
+        strcpy(address.sun_path, endpoint);
+        viewSock = (int)socket(AF_UNIX, SOCK_STREAM, 0);
+        if ((viewSock >= 0) && (connect(viewSock, (struct sockaddr *)&address, sizeof(address)) != 0)) SpectateViewStop();
+    } else {
+        // host:port
+        char host[64] = { 0 };
+        const char *colon = strchr(endpoint, ':');
+        if ((colon == NULL) || (colon - endpoint >= (int)sizeof(host))) return false;
+        memcpy(host, endpoint, colon - endpoint);
+
+        struct sockaddr_in address = { 0 };
+        address.sin_family = AF_INET;
+        address.sin_port = htons((uint16_t)atoi(colon + 1));
+        if (inet_pton(AF_INET, host, &address.sin_addr) != 1) return false;
+        viewSock = (int)socket(AF_INET, SOCK_STREAM, 0);
+        if ((viewSock >= 0) && (connect(viewSock, (struct sockaddr *)&address, sizeof(address)) != 0)) SpectateViewStop();
+    }
+
+    if (viewSock < 0) return false;
+    fcntl(viewSock, F_SETFL, fcntl(viewSock, F_GETFL, 0) | O_NONBLOCK);
+    recvSize = 0;
+    viewSynced = false;
+    return true;
+#else
+    (void)endpoint;
+    return false;
+#endif
+}
+
+void SpectateViewStop(void)
+{
+#if defined(SPECTATE_SUPPORTED)
+    if (viewSock >= 0) close(viewSock);
+    viewSock = -1;
+#endif
+}
+
+bool SpectateReceive(Game *mirror)
+{
+#if defined(SPECTATE_SUPPORTED)
+    if (viewSock < 0) return false;
+
+    bool open = true;
+    while (true) {
+        ssize_t received = recv(viewSock, recvBuffer + recvSize, sizeof(recvBuffer) - recvSize, 0);
+        if (received > 0) recvSize += (int)received;
+        else {
+            if ((received == 0) || ((errno != EAGAIN) && (errno != EWOULDBLOCK) && (errno != EINTR))) open = false;
+            if ((received == 0) || (errno != EINTR)) break;
+        }
+
+        // Consume every complete message, keep the partial tail for the next call
+        int offset = 0;
+        while (recvSize - offset >= MESSAGE_HEADER_SIZE) {
+            const unsigned char *message = recvBuffer + offset;
+            int size = message[0] | (message[1] << 8);
+            if (recvSize - offset < MESSAGE_HEADER_SIZE + size) break;
+
+            uint32_t tick = message[3] | ((uint32_t)message[4] << 8) | ((uint32_t)message[5] << 16) | ((uint32_t)message[6] << 24);
+            const unsigned char *payload = message + MESSAGE_HEADER_SIZE;
+            if (message[2] == MESSAGE_KEYFRAME) {
+                viewSynced = LoadState(mirror, payload, size);
+                // Dead aliens come back at their grid slot, keep them moving with the formation
+                Vector2 formation = { 0 };
+                bool frame = false;
+                if (viewSynced && GetFormation(mirror, &formation, &frame)) ApplyFormation(mirror, formation, frame);
+            } else if (viewSynced) {
+                viewSynced = ApplyDelta(mirror, payload, size);
+            }
+            mirror->tick = tick;
+            mirror->eventCount = 0;
+            offset += MESSAGE_HEADER_SIZE + size;
+        }
+        memmove(recvBuffer, recvBuffer + offset, recvSize - offset);
+        recvSize -= offset;
+    }
+
+    if (!open) SpectateViewStop();
+    return open;
+#else
+    (void)mirror;
+    return false;
+#endif
+}
+
+bool IsSpectateSynced(void)
+{
+    return viewSynced;
+}
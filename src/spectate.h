@@ -0,0 +1,45 @@
+#ifndef SPECTATE_H
+#define SPECTATE_H
+
+#include "game.h"
+
+//----------------------------------------------------------------------------------
+// Defines
+//----------------------------------------------------------------------------------
+#define SPECTATE_QUEUE_SIZE     (64*1024)   // Bytes of messages waiting for the sender thread
+#define SPECTATE_MAX_VIEWERS    8
+#define SPECTATE_MESSAGE_MAX    (GAME_STATE_MAX_SIZE + 8) // Largest message: header plus a keyframe
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef struct SpectateStats {
+    int viewers;                // Connected viewers
+    int keyframes;              // Full snapshots queued (viewer joined, new wave, restart, rewind)
+    int deltas;                 // Per-tick deltas queued
+    int dropped;                // Messages dropped on a full queue, the stream resumes with a keyframe
+    int lastMessageBytes;
+    int bytesSent;              // Written to sockets by the sender thread
+} SpectateStats;
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+// Publisher side. The game thread encodes what changed since the previous tick (alien alive
+// bits, formation offset, bullets, shield craters, score...) into a lock-free queue; a
+// background thread accepts viewers and writes the stream, so slow viewers never stall a frame.
+// Endpoint is a TCP port number, or a Unix socket path when it contains a '/'.
+bool SpectatePublishStart(const char *endpoint);
+void SpectatePublishStop(void);
+void SpectatePublish(const Game *game);         // After every tick, never blocks
+SpectateStats GetSpectateStats(void);
+
+// Viewer side, endpoint is "host:port" (IPv4) or a Unix socket path.
+// SpectateReceive() applies every complete message to the mirror game without blocking,
+// marking changed shields dirty; returns false once the publisher is gone.
+bool SpectateViewStart(const char *endpoint);
+void SpectateViewStop(void);
+bool SpectateReceive(Game *mirror);
+bool IsSpectateSynced(void);                    // A keyframe has been received
+
+#endif // SPECTATE_H
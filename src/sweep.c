@@ -0,0 +1,178 @@
+// Difficulty sweep: plays every parameter set of a tuning grid (see tuning.h) with the autopilot
+// on all cores and writes one CSV row per set with the distributions of survival time, score and
+// wave reached. Every set plays the same seeds, so differences between rows come from the rules.
+// The bot sees the aliens and their bullets as they were reaction ticks ago (its own ship as it
+// is now), like a human would; with perfect perception it dodges everything and survival would
+// not depend on the rules. Links only the simulation core.
+//
+//   invaders_sweep grid.txt out.csv [games per set] [max minutes per game] [reaction ticks] [threads]
+
+#include "game.h"
+#include "autopilot.h"
+#include "tuning.h"
+#include "memory.h"
+#include <pthread.h> // For pthread_create(), pthread_mutex_lock()
+#include <stdio.h>  // For printf(), fopen(), fprintf()
+#include <limits.h> // For INT_MAX
+#include <stdlib.h> // For strtol(), qsort()
+#include <time.h>   // For clock_gettime()
+#include <unistd.h> // For sysconf()
+
+//----------------------------------------------------------------------------------
+// Defines
+//----------------------------------------------------------------------------------
+#define SWEEP_MAX_THREADS       256
+#define SWEEP_REACTION_TICKS    12      // 200 ms, about a human's reaction time
+#define SWEEP_MAX_REACTION      120
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef struct SweepResult {
+    int ticks;                  // Survival, capped at the time limit
+    int score;
+    int wave;
+} SweepResult;
+
+//----------------------------------------------------------------------------------
+// Global Variables Definition
+//----------------------------------------------------------------------------------
+static TuningGrid grid;
+static int gamesPerSet = 0;
+static int maxTicks = 0;
+static int reactionTicks = 0;
+static SweepResult *results = NULL;     // gamesPerSet per set, in set order
+static int jobCount = 0;
+static int nextJob = 0;                 // Guarded by jobLock
+static pthread_mutex_t jobLock = PTHREAD_MUTEX_INITIALIZER;
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+static void *SweepWorker(void *history)
+{
+    Game *seen = (Game *)history;       // Ring of reactionTicks + 1 past states
+    Game game;
+
+    for (;;) {
+        pthread_mutex_lock(&jobLock);
+        int job = nextJob++;
+        pthread_mutex_unlock(&jobLock);
+        if (job >= jobCount) break;
+
+        GameTuning tuning = GetTuningGridSet(&grid, job/gamesPerSet);
+        InitGameStateTuned(&game, (uint64_t)(job%gamesPerSet) + 1, &tuning);
+        while (!game.gameOver && ((int)game.tick < maxTicks)) {
+            seen[game.tick%(reactionTicks + 1)] = game;
+            Game *perceived = &seen[((int)game.tick - reactionTicks < 0) ? 0 : (game.tick - reactionTicks)%(reactionTicks + 1)];
+            perceived->player = game.player;
+            UpdateGameState(&game, GetAutopilotInput(perceived));
+        }
+
+        results[job] = (SweepResult){ (int)game.tick, game.score, game.currentWave };
+    }
+
+    return NULL;
+}
+
+static int CompareInts(const void *a, const void *b)
+{
+    return (*(const int *)a > *(const int *)b) - (*(const int *)a < *(const int *)b);
+}
+
+// Mean, 10th, 50th and 90th percentile (nearest rank) of the sorted values
+static void WriteDistribution(FILE *file, int *values, int count, float scale)
+{
+    qsort(values, count, sizeof(int), CompareInts);
+
+    double sum = 0.0;
+    for (int i = 0; i < count; i++) sum += values[i];
+    fprintf(file, ",%.3f,%.3f,%.3f,%.3f", sum/count*scale, values[(count - 1)/10]*scale,
+            values[(count - 1)/2]*scale, values[(count - 1)*9/10]*scale);
+}
+
+static double GetSeconds(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec/1e9;
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc < 3) {
+        printf("usage: %s grid.txt out.csv [games per set] [max minutes per game] [reaction ticks] [threads]\n", argv[0]);
+        return 2;
+    }
+
+    gamesPerSet = (argc >= 4) ? (int)strtol(argv[3], NULL, 10) : 32;
+    maxTicks = (argc >= 5) ? (int)(strtol(argv[4], NULL, 10)*60*GAME_TICK_RATE) : 20*60*GAME_TICK_RATE;
+    reactionTicks = (argc >= 6) ? (int)strtol(argv[5], NULL, 10) : SWEEP_REACTION_TICKS;
+    int threadCount = (argc >= 7) ? (int)strtol(argv[6], NULL, 10) : (int)sysconf(_SC_NPROCESSORS_ONLN);
+    if (threadCount < 1) threadCount = 1;
+    if (threadCount > SWEEP_MAX_THREADS) threadCount = SWEEP_MAX_THREADS;
+    if ((gamesPerSet <= 0) || (maxTicks <= 0) || (reactionTicks < 0) || (reactionTicks > SWEEP_MAX_REACTION)) return 2;
+
+    if (!LoadTuningGrid(argv[1], GetDefaultGameTuning(), &grid)) return 1;
+    int setCount = GetTuningGridSize(&grid);
+    if (setCount > INT_MAX/gamesPerSet) {
+        printf("sweep: %d parameter sets x %d games is too many games\n", setCount, gamesPerSet);
+        return 1;
+    }
+    jobCount = setCount*gamesPerSet;
+    results = (SweepResult *)GameCalloc(jobCount, sizeof(SweepResult));
+    int *values = (int *)GameMalloc(gamesPerSet*sizeof(int));
+    Game *histories = (Game *)GameMalloc((size_t)threadCount*(reactionTicks + 1)*sizeof(Game));
+    FILE *file = fopen(argv[2], "w");
+    if ((results == NULL) || (values == NULL) || (histories == NULL) || (file == NULL)) {
+        printf("sweep: cannot allocate %d results or open %s\n", jobCount, argv[2]);
+        return 1;
+    }
+
+    printf("sweep: %d parameter sets x %d games, up to %d minutes each, reaction %d ticks, %d threads\n",
+           setCount, gamesPerSet, maxTicks/(60*GAME_TICK_RATE), reactionTicks, threadCount);
+    double start = GetSeconds();
+
+    pthread_t threads[SWEEP_MAX_THREADS];
+    int started = 0;
+    for (int i = 0; i < threadCount; i++) {
+        if (pthread_create(&threads[started], NULL, SweepWorker, histories + (size_t)started*(reactionTicks + 1)) == 0) started++;
+    }
+    if (started == 0) SweepWorker(histories);
+    for (int i = 0; i < started; i++) pthread_join(threads[i], NULL);
+
+    // One row per set: its parameters, then each distribution
+    fprintf(file, "set");
+    for (int f = 0; f < TUNING_FIELD_COUNT; f++) fprintf(file, ",%s", GetTuningFieldName(f));
+    fprintf(file, ",games,survivedFraction");
+    const char *metrics[3] = { "survivalSeconds", "score", "wave" };
+    for (int m = 0; m < 3; m++) fprintf(file, ",%sMean,%sP10,%sP50,%sP90", metrics[m], metrics[m], metrics[m], metrics[m]);
+    fprintf(file, "\n");
+
+    for (int s = 0; s < setCount; s++) {
+        const SweepResult *set = &results[s*gamesPerSet];
+        GameTuning tuning = GetTuningGridSet(&grid, s);
+
+        fprintf(file, "%d", s);
+        for (int f = 0; f < TUNING_FIELD_COUNT; f++) fprintf(file, ",%g", GetTuningField(&tuning, f));
+
+        int survived = 0;
+        for (int g = 0; g < gamesPerSet; g++) survived += (set[g].ticks >= maxTicks);
+        fprintf(file, ",%d,%.3f", gamesPerSet, (float)survived/gamesPerSet);
+
+        for (int g = 0; g < gamesPerSet; g++) values[g] = set[g].ticks;
+        WriteDistribution(file, values, gamesPerSet, GAME_TICK_TIME);
+        for (int g = 0; g < gamesPerSet; g++) values[g] = set[g].score;
+        WriteDistribution(file, values, gamesPerSet, 1.0f);
+        for (int g = 0; g < gamesPerSet; g++) values[g] = set[g].wave;
+        WriteDistribution(file, values, gamesPerSet, 1.0f);
+        fprintf(file, "\n");
+    }
+
+    fclose(file);
+    printf("sweep: %d games in %.1f s, written to %s\n", jobCount, GetSeconds() - start, argv[2]);
+    GameFree(histories);
+    GameFree(values);
+    GameFree(results);
+    return 0;
+}
@@ -0,0 +1,87 @@
+#include "synth.h"
+#include <math.h>   // For sinf(), fabsf()
+#include <string.h> // For memset()
+
+//----------------------------------------------------------------------------------
+// Defines
+//----------------------------------------------------------------------------------
+#define SYNTH_PI                3.14159265358979f
+#define SYNTH_NOISE_SEED        0x9e3779b9u
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+// xorshift32, mapped to -1..1
+static float NextNoise(uint32_t *state)
+{
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return (float)(x >> 8)/(float)(1 << 23) - 1.0f;
+}
+
+int GetSynthFrames(const SynthPatch *patch)
+{
+    return (patch->duration > 0.0f) ? (int)(patch->duration*SYNTH_SAMPLE_RATE) : 0;
+}
+
+void RenderSynthPatch(const SynthPatch *patch, int16_t *samples)
+{
+    SynthVoice voice;
+    int frames = GetSynthFrames(patch);
+
+    memset(samples, 0, frames*sizeof(int16_t));
+    StartSynthVoice(&voice, *patch);
+    MixSynthVoice(&voice, 1.0f, samples, frames);
+}
+
+void StartSynthVoice(SynthVoice *voice, SynthPatch patch)
+{
+    *voice = (SynthVoice){ patch, true, 0.0f, 0.0f, 0.0f, SYNTH_NOISE_SEED };
+    if (patch.waveform == SYNTH_NOISE) voice->hold = NextNoise(&voice->noise);
+}
+
+void MixSynthVoice(SynthVoice *voice, float pitchScale, int16_t *samples, int frames)
+{
+    const SynthPatch *patch = &voice->patch;
+    const float dt = 1.0f/SYNTH_SAMPLE_RATE;
+
+    for (int i = 0; (i < frames) && voice->active; i++) {
+        float t = voice->time;
+        if ((patch->duration > 0.0f) && (t >= patch->duration)) {
+            voice->active = false;
+            break;
+        }
+
+        float hz = patch->startHz;
+        if (patch->duration > 0.0f) hz += (patch->endHz - patch->startHz)*t/patch->duration;
+        if (patch->vibratoDepth > 0.0f) hz *= 1.0f + patch->vibratoDepth*sinf(2.0f*SYNTH_PI*patch->vibratoHz*t);
+        hz *= pitchScale;
+
+        float envelope = 1.0f;
+        if ((patch->attack > 0.0f) && (t < patch->attack)) envelope = t/patch->attack;
+        if ((patch->duration > 0.0f) && (patch->release > 0.0f) && (t > patch->duration - patch->release)) {
+            envelope *= (patch->duration - t)/patch->release;
+        }
+
+        float value = 0.0f;
+        switch (patch->waveform) {
+            case SYNTH_SQUARE: value = (voice->phase < 0.5f) ? 1.0f : -1.0f; break;
+            case SYNTH_TRIANGLE: value = 4.0f*fabsf(voice->phase - 0.5f) - 1.0f; break;
+            case SYNTH_SAW: value = 2.0f*voice->phase - 1.0f; break;
+            case SYNTH_NOISE: value = voice->hold; break;
+        }
+
+        voice->phase += hz*dt;
+        if (voice->phase >= 1.0f) {
+            voice->phase -= (float)(int)voice->phase;
+            if (patch->waveform == SYNTH_NOISE) voice->hold = NextNoise(&voice->noise);
+        }
+        voice->time = t + dt;
+
+        int mixed = samples[i] + (int)(value*envelope*patch->volume*32767.0f);
+        samples[i] = (int16_t)((mixed > 32767) ? 32767 : ((mixed < -32768) ? -32768 : mixed));
+    }
+}
@@ -0,0 +1,53 @@
+#ifndef SYNTH_H
+#define SYNTH_H
+
+// Tiny synthesizer for the arcade sounds: one oscillator (square, triangle, saw or sample and
+// hold noise) with a linear pitch sweep, vibrato and a linear attack/release envelope. Patches
+// are rendered once into PCM buffers, or played by a voice that is mixed block by block from an
+// audio callback, with a pitch scale that can change between blocks. Mono, signed 16-bit.
+// No raylib and no allocation: the caller owns every buffer.
+
+#include <stdbool.h>
+#include <stdint.h>
+
+//----------------------------------------------------------------------------------
+// Defines
+//----------------------------------------------------------------------------------
+#define SYNTH_SAMPLE_RATE       22050
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef enum SynthWaveform { SYNTH_SQUARE = 0, SYNTH_TRIANGLE, SYNTH_SAW, SYNTH_NOISE } SynthWaveform;
+
+typedef struct SynthPatch {
+    SynthWaveform waveform;
+    float startHz;              // Pitch at the start; noise: rate of new random values
+    float endHz;                // Pitch at the end of the duration, swept linearly
+    float duration;             // Seconds, 0 sustains until the voice is stopped
+    float attack;               // Seconds of linear fade in
+    float release;              // Seconds of linear fade out before the end of the duration
+    float vibratoHz;            // Pitch wobble rate
+    float vibratoDepth;         // Pitch wobble, fraction of the pitch
+    float volume;               // 0..1
+} SynthPatch;
+
+typedef struct SynthVoice {
+    SynthPatch patch;
+    bool active;
+    float time;                 // Seconds since the start
+    float phase;                // Oscillator cycle position, 0..1
+    float hold;                 // Noise: value held until the next cycle
+    uint32_t noise;             // Noise generator state
+} SynthVoice;
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+int GetSynthFrames(const SynthPatch *patch);                        // Length of a rendered patch
+void RenderSynthPatch(const SynthPatch *patch, int16_t *samples);   // Writes GetSynthFrames() samples
+
+void StartSynthVoice(SynthVoice *voice, SynthPatch patch);
+void MixSynthVoice(SynthVoice *voice, float pitchScale, int16_t *samples, int frames);  // Adds, saturating; inactive voices add nothing
+
+#endif // SYNTH_H
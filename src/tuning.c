@@ -0,0 +1,197 @@
+#include "tuning.h"
+#include <stdio.h>  // For fopen(), fgets(), sscanf(), fprintf()
+#include <stdlib.h> // For strtof()
+#include <string.h> // For strchr(), strcmp(), strspn(), strtok()
+#include <limits.h> // For INT_MAX
+#include <math.h>   // For isfinite()
+
+//----------------------------------------------------------------------------------
+// Defines
+//----------------------------------------------------------------------------------
+#define TUNING_MAX_SECONDS      60.0f   // Step time and shot intervals; CheckGameState() holds the step time to it
+#define TUNING_MAX_WAVE_SPEEDUP 10.0f
+
+//----------------------------------------------------------------------------------
+// Global Variables Definition
+//----------------------------------------------------------------------------------
+static const char *fieldNames[TUNING_FIELD_COUNT] = {
+    "alienStepTimeStart", "waveSpeedup", "alienSpeedupFactor",
+    "alienShootIntervalMin", "alienShootIntervalMax", "alienBulletSpeed"
+};
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition - Fields
+//----------------------------------------------------------------------------------
+static float *GetFieldPointer(GameTuning *tuning, int field)
+{
+    switch (field) {
+        case 0: return &tuning->alienStepTimeStart;
+        case 1: return &tuning->waveSpeedup;
+        case 2: return &tuning->alienSpeedupFactor;
+        case 3: return &tuning->alienShootIntervalMin;
+        case 4: return &tuning->alienShootIntervalMax;
+        case 5: return &tuning->alienBulletSpeed;
+        default: return NULL;
+    }
+}
+
+const char *GetTuningFieldName(int field)
+{
+    return ((field >= 0) && (field < TUNING_FIELD_COUNT)) ? fieldNames[field] : NULL;
+}
+
+float GetTuningField(const GameTuning *tuning, int field)
+{
+    const float *value = GetFieldPointer((GameTuning *)tuning, field);
+    return (value != NULL) ? *value : 0.0f;
+}
+
+// NULL when the game keeps its invariants with this value, otherwise the range it has to be in
+static const char *CheckFieldValue(int field, float value)
+{
+    if (!isfinite(value)) return "a finite number";
+    switch (field) {
+        case 0: return ((value > 0.0f) && (value <= TUNING_MAX_SECONDS)) ? NULL : "above 0 and at most 60 seconds";
+        case 1: return ((value >= 0.0f) && (value <= TUNING_MAX_WAVE_SPEEDUP)) ? NULL : "from 0 to 10";
+        case 2: return ((value > 0.0f) && (value <= 1.0f)) ? NULL : "above 0 and at most 1";
+        case 3:
+        case 4: return ((value >= 0.0f) && (value <= TUNING_MAX_SECONDS)) ? NULL : "from 0 to 60 seconds";
+        case 5: return (value > 0.0f) ? NULL : "above 0";
+        default: return NULL;
+    }
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition - Parsing
+//----------------------------------------------------------------------------------
+// Values after the '=': a list, or first:last:step expanded with integer steps so no value drifts
+static int ParseValues(char *text, float *values)
+{
+    int count = 0;
+    char *token = strtok(text, " \t,\r\n");
+
+    while (token != NULL) {
+        char *end = NULL;
+        float first = strtof(token, &end);
+        if (end == token) return -1;
+
+        if (*end == ':') {
+            char *next = end + 1;
+            float last = strtof(next, &end);
+            if ((end == next) || (*end != ':')) return -1;
+            next = end + 1;
+            float step = strtof(next, &end);
+            if ((end == next) || (*end != '\0') || (step <= 0.0f) || (last < first)) return -1;
+
+            for (int i = 0; first + i*step <= last + step*0.001f; i++) {
+                if (count == TUNING_MAX_VALUES) return -1;
+                values[count++] = first + i*step;
+            }
+        } else {
+            if ((*end != '\0') || (count == TUNING_MAX_VALUES)) return -1;
+            values[count++] = first;
+        }
+        token = strtok(NULL, " \t,\r\n");
+    }
+
+    return count;
+}
+
+bool LoadTuningGrid(const char *fileName, GameTuning base, TuningGrid *grid)
+{
+    for (int f = 0; f < TUNING_FIELD_COUNT; f++) {
+        grid->valueCount[f] = 1;
+        grid->values[f][0] = GetTuningField(&base, f);
+    }
+
+    FILE *file = fopen(fileName, "r");
+    if (file == NULL) {
+        fprintf(stderr, "TUNING: Cannot open %s\n", fileName);
+        return false;
+    }
+
+    char line[1024];
+    int lines[TUNING_FIELD_COUNT] = { 0 };  // Where each field was set, for the messages below
+    bool ok = true;
+    for (int number = 1; ok && (fgets(line, sizeof(line), file) != NULL); number++) {
+        char *comment = strchr(line, '#');
+        if (comment != NULL) *comment = '\0';
+        if (line[strspn(line, " \t\r\n")] == '\0') continue;
+
+        char *equals = strchr(line, '=');
+        char name[64] = { 0 };
+        int field = -1;
+        if ((equals != NULL) && (sscanf(line, " %63[A-Za-z0-9_]", name) == 1)) {
+            for (int f = 0; f < TUNING_FIELD_COUNT; f++) {
+                if (strcmp(name, fieldNames[f]) == 0) field = f;
+            }
+        }
+
+        int count = (field >= 0) ? ParseValues(equals + 1, grid->values[field]) : -1;
+        if (count <= 0) {
+            fprintf(stderr, "TUNING: %s:%d: expected \"name = value\" with a known name, got \"%s\"\n", fileName, number, name);
+            ok = false;
+            continue;
+        }
+        grid->valueCount[field] = count;
+        lines[field] = number;
+
+        for (int i = 0; ok && (i < count); i++) {
+            const char *range = CheckFieldValue(field, grid->values[field][i]);
+            if (range != NULL) {
+                fprintf(stderr, "TUNING: %s:%d: %s = %g, must be %s\n", fileName, number, name, grid->values[field][i], range);
+                ok = false;
+            }
+        }
+    }
+    fclose(file);
+
+    // Every set of the grid draws its shot intervals between min and max
+    float largestMin = grid->values[3][0], smallestMax = grid->values[4][0];
+    for (int i = 1; i < grid->valueCount[3]; i++) if (grid->values[3][i] > largestMin) largestMin = grid->values[3][i];
+    for (int i = 1; i < grid->valueCount[4]; i++) if (grid->values[4][i] < smallestMax) smallestMax = grid->values[4][i];
+    if (ok && (largestMin > smallestMax)) {
+        fprintf(stderr, "TUNING: %s:%d: %s %g is below %s %g\n", fileName, (lines[4] > 0) ? lines[4] : lines[3],
+                fieldNames[4], smallestMax, fieldNames[3], largestMin);
+        ok = false;
+    }
+
+    long long size = 1;
+    for (int f = 0; f < TUNING_FIELD_COUNT; f++) size *= grid->valueCount[f]; // At most 64^6, fits
+    if (ok && (size > INT_MAX)) {
+        fprintf(stderr, "TUNING: %s: %lld parameter sets, more than a sweep can index\n", fileName, size);
+        ok = false;
+    }
+
+    return ok;
+}
+
+bool LoadGameTuning(const char *fileName, GameTuning *tuning)
+{
+    TuningGrid grid;
+    if (!LoadTuningGrid(fileName, *tuning, &grid)) return false;
+
+    if (GetTuningGridSize(&grid) != 1) {
+        fprintf(stderr, "TUNING: %s lists several values for a field, that is a sweep grid\n", fileName);
+        return false;
+    }
+    *tuning = GetTuningGridSet(&grid, 0);
+    return true;
+}
+
+int GetTuningGridSize(const TuningGrid *grid)
+{
+    int size = 1;
+    for (int f = 0; f < TUNING_FIELD_COUNT; f++) size *= grid->valueCount[f];
+    return size;
+}
+
+GameTuning GetTuningGridSet(const TuningGrid *grid, int index)
+{
+    GameTuning tuning = { 0 };
+    for (int f = TUNING_FIELD_COUNT - 1; f >= 0; f--) {
+        *GetFieldPointer(&tuning, f) = grid->values[f][index%grid->valueCount[f]];
+        index /= grid->valueCount[f];
+    }
+    return tuning;
+}
@@ -0,0 +1,44 @@
+#ifndef TUNING_H
+#define TUNING_H
+
+// GameTuning as text, one "name = value" line per field, '#' starts a comment and fields not
+// listed keep their base value:
+//
+//   alienSpeedupFactor = 0.97
+//   alienShootIntervalMin = 0.5
+//
+// A sweep grid is the same file with several values on a line (separated by spaces or commas),
+// or a range "first:last:step"; every combination of the listed values is one parameter set.
+
+#include "game.h"
+
+//----------------------------------------------------------------------------------
+// Defines
+//----------------------------------------------------------------------------------
+#define TUNING_FIELD_COUNT      6   // Floats in GameTuning
+#define TUNING_MAX_VALUES       64  // Per field in a grid
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef struct TuningGrid {
+    int valueCount[TUNING_FIELD_COUNT];
+    float values[TUNING_FIELD_COUNT][TUNING_MAX_VALUES];
+} TuningGrid;
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+// Both log the offending line and return false on an unknown name, a value out of the field's
+// range (step time above 0, speedup factor in (0, 1], 0 <= shot interval min <= max, bullet speed
+// above 0) or a grid of more than INT_MAX sets
+bool LoadTuningGrid(const char *fileName, GameTuning base, TuningGrid *grid);
+bool LoadGameTuning(const char *fileName, GameTuning *tuning);     // Exactly one value per listed field
+
+int GetTuningGridSize(const TuningGrid *grid);                      // Parameter sets, product of the value counts
+GameTuning GetTuningGridSet(const TuningGrid *grid, int index);     // First field varies slowest
+
+const char *GetTuningFieldName(int field);
+float GetTuningField(const GameTuning *tuning, int field);
+
+#endif // TUNING_H
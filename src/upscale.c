@@ -0,0 +1,104 @@
+#include "raylib.h"
+#include "upscale.h"
+#include "game.h"
+#include "ledger.h"
+
+//----------------------------------------------------------------------------------
+// Defines
+//----------------------------------------------------------------------------------
+#if defined(PLATFORM_WEB)
+    #define CRT_SHADER_HEADER   "#version 100\nprecision mediump float;\n#define IN varying\n#define TEXTURE texture2D\n#define OUTPUT gl_FragColor\n"
+#else
+    #define CRT_SHADER_HEADER   "#version 330\n#define IN in\n#define TEXTURE texture\nout vec4 finalColor;\n#define OUTPUT finalColor\n"
+#endif
+
+//------------------------------------------------------------------------------------
+// Global Variables Declaration
+//------------------------------------------------------------------------------------
+static RenderTexture2D target = { 0 };
+static int scale = 1;                   // Window pixels per target texel
+static Shader crtShader = { 0 };
+static bool crtLoaded = false;
+
+// One pass over the upscaled board: the source row position darkens the gap between texel rows,
+// the window column picks a red, green or blue slot and the corners fall off
+static const char *crtShaderCode = CRT_SHADER_HEADER
+    "IN vec2 fragTexCoord;\n"
+    "IN vec4 fragColor;\n"
+    "uniform sampler2D texture0;\n"
+    "uniform vec4 colDiffuse;\n"
+    "uniform vec2 sourceSize;\n"
+    "void main()\n"
+    "{\n"
+    "    vec4 texel = TEXTURE(texture0, fragTexCoord)*colDiffuse*fragColor;\n"
+    "    float row = fract(fragTexCoord.y*sourceSize.y);\n"
+    "    float scanline = 0.6 + 0.4*sin(row*3.14159);\n"
+    "    float slot = mod(floor(gl_FragCoord.x), 3.0);\n"
+    "    vec3 mask = vec3(0.8) + 0.3*vec3(slot == 0.0, slot == 1.0, slot == 2.0);\n"
+    "    vec2 edge = fragTexCoord - 0.5;\n"
+    "    float vignette = 1.0 - 0.5*dot(edge, edge);\n"
+    "    OUTPUT = vec4(texel.rgb*scanline*mask*vignette, 1.0);\n"
+    "}\n";
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+bool LoadUpscaler(int divisor, bool crt)
+{
+    if ((divisor < 1) || (SCREEN_WIDTH%divisor != 0) || (SCREEN_HEIGHT%divisor != 0)) {
+        TraceLog(LOG_WARNING, "GAME: Low-res divisor %d does not divide %dx%d", divisor, SCREEN_WIDTH, SCREEN_HEIGHT);
+        return false;
+    }
+
+    target = LoadRenderTextureTracked(SCREEN_WIDTH/divisor, SCREEN_HEIGHT/divisor);
+    if (target.id == 0) return false;
+    SetTextureFilter(target.texture, TEXTURE_FILTER_POINT); // Whole texels, no blur
+    scale = divisor;
+
+    if (crt) {
+        crtShader = LoadShaderFromMemory(NULL, crtShaderCode);
+        crtLoaded = IsShaderReady(crtShader);
+        if (crtLoaded) {
+            Vector2 size = { (float)target.texture.width, (float)target.texture.height };
+            SetShaderValue(crtShader, GetShaderLocation(crtShader, "sourceSize"), &size, SHADER_UNIFORM_VEC2);
+        }
+        else TraceLog(LOG_WARNING, "GAME: CRT shader did not compile, plain upscale");
+    }
+
+    TraceLog(LOG_INFO, "GAME: Board drawn at %dx%d, upscaled %dx%s", target.texture.width, target.texture.height, scale, crtLoaded ? " with CRT" : "");
+    return true;
+}
+
+void UnloadUpscaler(void)
+{
+    if (crtLoaded) UnloadShader(crtShader);
+    if (target.id != 0) UnloadRenderTextureTracked(target);
+    target = (RenderTexture2D){ 0 };
+    crtLoaded = false;
+    scale = 1;
+}
+
+bool IsUpscalerReady(void)
+{
+    return (target.id != 0);
+}
+
+void BeginLowResBoard(void)
+{
+    BeginTextureMode(target);
+    ClearBackground(BLANK);
+    BeginMode2D((Camera2D){ .zoom = 1.0f/scale });
+}
+
+void EndLowResBoard(void)
+{
+    EndMode2D();
+    EndTextureMode();
+
+    // Render textures are stored bottom up, hence the negative source height
+    Rectangle source = { 0, 0, (float)target.texture.width, (float)-target.texture.height };
+    Rectangle dest = { 0, 0, (float)target.texture.width*scale, (float)target.texture.height*scale };
+    if (crtLoaded) BeginShaderMode(crtShader);
+    DrawTexturePro(target.texture, source, dest, (Vector2){ 0, 0 }, 0.0f, WHITE);
+    if (crtLoaded) EndShaderMode();
+}
@@ -0,0 +1,23 @@
+#ifndef UPSCALE_H
+#define UPSCALE_H
+
+// Low resolution playfield: the board is drawn 1:1 into an offscreen target SCREEN_WIDTH/divisor
+// by SCREEN_HEIGHT/divisor pixels (4 gives 200x150, about the arcade's pixel count), then blown
+// up to the window with nearest filtering by the whole divisor, so every texel becomes a crisp
+// square. Far fewer fragments are shaded for the sprites. The blit can run a CRT shader in the
+// same pass (scanlines between source rows, a slot mask and vignetting).
+// Text and overlays are drawn afterwards at full resolution, only the board goes low-res.
+
+#include "raylib.h"
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+bool LoadUpscaler(int divisor, bool crt);   // divisor must divide 200 (gcd of the screen size); false if it fails
+void UnloadUpscaler(void);
+bool IsUpscalerReady(void);
+
+void BeginLowResBoard(void);                // Inside BeginDrawing(): world coordinates now land in the target
+void EndLowResBoard(void);                  // Blits the target over the whole window
+
+#endif // UPSCALE_H
@@ -0,0 +1,237 @@
+// Headless replay verifier: re-simulates replays recorded with `invaders --record <file>`
+// and reports the first tick whose state hash differs. Links only the simulation core.
+//
+//   invaders_verify replay.bin [...]                  verify, exit code 1 on any divergence
+//   invaders_verify --generate out.bin ticks [seed]   record a replay with pseudo-random input
+//   invaders_verify --autopilot out.bin ticks [seed]  same, played by the autopilot (see autopilot.h)
+//   invaders_verify --versus-host port ticks [delayMs lossPercent]
+//   invaders_verify --versus-join ip:port ticks [delayMs lossPercent]
+//                                                     rollback versus match between two processes
+//                                                     with random input, exit code 1 on desync
+//   invaders_verify --snapshot replay.bin tick out.png [width height]
+//                                                     CPU-render the state after that tick
+//   invaders_verify --golden replay.bin tick golden.png [width height]
+//                                                     same, compared byte for byte with a snapshot
+//                                                     written before, exit code 1 when it is missing
+//                                                     or differs, the new image goes to .actual.png
+//
+// A leading "--tuning params.txt" plays every game by those rules (see tuning.h); replays
+// recorded with a tuning file only verify with the same file.
+
+#include "game.h"
+#include "replay.h"
+#include "netplay.h"
+#include "raster.h"
+#include "autopilot.h"
+#include "tuning.h"
+#include "memory.h"
+#include <stdio.h>  // For printf()
+#include <stdlib.h> // For strtol(), strtoull()
+#include <string.h> // For strcmp(), strchr()
+#include <time.h>   // For clock_gettime(), nanosleep()
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+static int GenerateReplay(const char *fileName, int ticks, uint64_t seed, bool autopilot)
+{
+    Game game;
+    Replay replay = { 0 };
+    uint64_t inputState = seed*0x2545F4914F6CDD1DULL | 1;
+
+    InitGameState(&game, seed);
+    ReplayBegin(&replay, seed);
+
+    for (int i = 0; (i < ticks) && !game.gameOver; i++) {
+        inputState ^= inputState << 13;
+        inputState ^= inputState >> 7;
+        inputState ^= inputState << 17;
+
+        GameInput input = autopilot ? GetAutopilotInput(&game) : UnpackGameInput((uint8_t)(inputState >> 32));
+        UpdateGameState(&game, input);
+        ReplayRecord(&replay, input, &game);
+    }
+
+    bool ok = SaveReplay(&replay, fileName);
+    printf("%s: %s %d ticks (seed %llu, wave %d, score %d, lives %d, alien step %.3f s)\n", fileName, ok ? "wrote" : "FAILED to write",
+           replay.tickCount, (unsigned long long)seed, game.currentWave, game.score, game.player.lives, game.alienMoveWaitTime);
+    ReplayFree(&replay);
+    return ok ? 0 : 1;
+}
+
+static int VerifyFile(const char *fileName)
+{
+    Replay replay = { 0 };
+
+    if (!LoadReplay(&replay, fileName)) {
+        printf("%s: unreadable or from another version\n", fileName);
+        ReplayFree(&replay);
+        return 1;
+    }
+
+    ReplayCheck check = VerifyReplay(&replay);
+    if (check.ok) printf("%s: OK, %d ticks\n", fileName, replay.tickCount);
+    else {
+        printf("%s: DIVERGED at tick %d of %d:", fileName, check.divergentTick, replay.tickCount);
+        for (int s = 0; s < SUBSYSTEM_COUNT; s++) {
+            if (check.subsystemMask & (1u << s)) printf(" %s", GetSubsystemName((GameSubsystem)s));
+        }
+        printf("\n");
+    }
+
+    ReplayFree(&replay);
+    return check.ok ? 0 : 1;
+}
+
+static double GetSeconds(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec/1e9;
+}
+
+static int RunVersus(bool host, const char *address, int ticks, int delayMs, int lossPercent)
+{
+    static Versus versus; // Rollback history lives in netplay.c, this is only the live state
+    NetplayConfig config = { host, address, 0, delayMs, lossPercent };
+
+    const char *colon = host ? NULL : strchr(address, ':');
+    static char ip[64];
+    if (host) config.port = (int)strtol(address, NULL, 10);
+    else if ((colon != NULL) && (colon - address < (int)sizeof(ip))) {
+        memcpy(ip, address, colon - address);
+        ip[colon - address] = '\0';
+        config.address = ip;
+        config.port = (int)strtol(colon + 1, NULL, 10);
+    }
+
+    if (!NetplayStart(&config, 0x5EED0000ULL + (uint64_t)time(NULL))) {
+        printf("versus: cannot open UDP socket for %s\n", address);
+        return 1;
+    }
+
+    // Pseudo-random input at 60 Hz, then zero input for a while so the last inputs and hashes get through
+    uint64_t inputState = host ? 0x1234567ULL : 0x7654321ULL;
+    double start = GetSeconds(), nextTick = start;
+    int advanced = 0, idle = 0;
+    while ((advanced < ticks + GAME_TICK_RATE) && (GetSeconds() - start < 120.0)) {
+        if (GetSeconds() < nextTick) {
+            nanosleep(&(struct timespec){ 0, 500000 }, NULL);
+            continue;
+        }
+        nextTick += GAME_TICK_TIME;
+
+        inputState ^= inputState << 13;
+        inputState ^= inputState >> 7;
+        inputState ^= inputState << 17;
+        GameInput input = (advanced < ticks) ? UnpackGameInput((uint8_t)(inputState >> 40)) : (GameInput){ 0 };
+
+        if (NetplayAdvance(&versus, input, GetSeconds())) advanced++;
+        else idle++;
+    }
+
+    NetplayStats stats = GetNetplayStats();
+    printf("versus %s: %d ticks, %d stalled, result %d, score %d/%d, sent aliens %d/%d\n", host ? "host" : "join",
+           advanced, idle, versus.result, versus.games[0].score, versus.games[1].score, versus.aliensSent[0], versus.aliensSent[1]);
+    printf("  rollbacks %d (%d ticks re-simulated, deepest %d), packets sent %d dropped %d received %d\n",
+           stats.rollbacks, stats.resimulatedTicks, stats.maxRollback, stats.packetsSent, stats.packetsDropped, stats.packetsReceived);
+    if (stats.desyncTick == 0) printf("  state hashes matched on %d confirmed ticks, no desync\n", stats.hashChecks);
+    else printf("  DESYNC at tick %u after %d matching ticks\n", (unsigned int)stats.desyncTick, stats.hashChecks);
+
+    NetplayStop();
+    return ((stats.desyncTick == 0) && (advanced > 0)) ? 0 : 1;
+}
+
+// Replays the first ticks of a replay and renders that state without a GPU
+static int RenderSnapshot(const char *replayName, int tick, const char *fileName, int width, int height, bool golden)
+{
+    Replay replay = { 0 };
+    if (!LoadReplay(&replay, replayName)) {
+        printf("%s: unreadable or from another version\n", replayName);
+        ReplayFree(&replay);
+        return 1;
+    }
+
+    Game game;
+    InitGameState(&game, replay.seed);
+    if (tick > replay.tickCount) tick = replay.tickCount;
+    for (int i = 0; i < tick; i++) UpdateGameState(&game, UnpackGameInput(replay.ticks[i].input));
+    ReplayFree(&replay);
+
+    Framebuffer frame = { width, height, (unsigned char *)GameMalloc((size_t)width*height*4) };
+    if (frame.pixels == NULL) return 1;
+    RasterGame(&game, game.score, &frame);
+
+    int size = 0;
+    unsigned char *png = EncodePNG(&frame, &size);
+    int result = 1;
+    FILE *existing = golden ? fopen(fileName, "rb") : NULL;
+
+    if (golden && (existing == NULL)) {
+        // A mistyped or deleted golden must not pass; a new one is written with --snapshot
+        printf("%s: MISSING golden image, write it with --snapshot\n", fileName);
+    } else if (existing != NULL) {
+        // Same encoder, same state: any byte difference is a rendering or simulation change
+        unsigned char *expected = (unsigned char *)GameMalloc(size + 1);
+        int expectedSize = (expected != NULL) ? (int)fread(expected, 1, size + 1, existing) : -1;
+        fclose(existing);
+        bool match = (png != NULL) && (expectedSize == size) && (memcmp(expected, png, size) == 0);
+        GameFree(expected);
+
+        if (match) {
+            printf("%s: MATCH at tick %d (%dx%d)\n", fileName, tick, width, height);
+            result = 0;
+        } else {
+            char actualName[512];
+            snprintf(actualName, sizeof(actualName), "%s.actual.png", fileName);
+            ExportFramebufferPNG(&frame, actualName);
+            printf("%s: DIFFERS at tick %d, new render written to %s\n", fileName, tick, actualName);
+        }
+    } else if (ExportFramebufferPNG(&frame, fileName)) {
+        printf("%s: wrote tick %d (%dx%d, %d bytes)\n", fileName, tick, width, height, size);
+        result = 0;
+    } else printf("%s: FAILED to write\n", fileName);
+
+    GameFree(png);
+    GameFree(frame.pixels);
+    return result;
+}
+
+int main(int argc, char *argv[])
+{
+    if ((argc >= 3) && (strcmp(argv[1], "--tuning") == 0)) {
+        GameTuning tuning = GetDefaultGameTuning();
+        if (!LoadGameTuning(argv[2], &tuning)) return 2;
+        SetGameTuning(&tuning);
+        argv[2] = argv[0];
+        argv += 2;
+        argc -= 2;
+    }
+
+    if ((argc >= 4) && ((strcmp(argv[1], "--generate") == 0) || (strcmp(argv[1], "--autopilot") == 0))) {
+        uint64_t seed = (argc >= 5) ? strtoull(argv[4], NULL, 10) : 1;
+        return GenerateReplay(argv[2], (int)strtol(argv[3], NULL, 10), seed, strcmp(argv[1], "--autopilot") == 0);
+    }
+
+    if ((argc >= 4) && ((strcmp(argv[1], "--versus-host") == 0) || (strcmp(argv[1], "--versus-join") == 0))) {
+        int delayMs = (argc >= 5) ? (int)strtol(argv[4], NULL, 10) : 0;
+        int lossPercent = (argc >= 6) ? (int)strtol(argv[5], NULL, 10) : 0;
+        return RunVersus(strcmp(argv[1], "--versus-host") == 0, argv[2], (int)strtol(argv[3], NULL, 10), delayMs, lossPercent);
+    }
+
+    if ((argc >= 5) && ((strcmp(argv[1], "--snapshot") == 0) || (strcmp(argv[1], "--golden") == 0))) {
+        int width = (argc >= 7) ? (int)strtol(argv[5], NULL, 10) : SCREEN_WIDTH;
+        int height = (argc >= 7) ? (int)strtol(argv[6], NULL, 10) : SCREEN_HEIGHT;
+        if ((width <= 0) || (height <= 0)) return 2;
+        return RenderSnapshot(argv[2], (int)strtol(argv[3], NULL, 10), argv[4], width, height, strcmp(argv[1], "--golden") == 0);
+    }
+
+    if (argc < 2) {
+        printf("usage: %s replay.bin [...]\n       %s --generate|--autopilot out.bin ticks [seed]\n", argv[0], argv[0]);
+        return 2;
+    }
+
+    int failures = 0;
+    for (int i = 1; i < argc; i++) failures += VerifyFile(argv[i]);
+    return (failures > 0) ? 1 : 0;
+}
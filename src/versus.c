@@ -0,0 +1,64 @@
+#include "versus.h"
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+void InitVersus(Versus *versus, uint64_t seed)
+{
+    versus->tick = 0;
+    versus->result = VERSUS_PLAYING;
+
+    for (int p = 0; p < VERSUS_PLAYERS; p++) {
+        InitGameState(&versus->games[p], seed);
+        versus->killCredit[p] = 0;
+        versus->aliensSent[p] = 0;
+    }
+}
+
+void UpdateVersus(Versus *versus, const GameInput inputs[VERSUS_PLAYERS])
+{
+    if (versus->result != VERSUS_PLAYING) {
+        for (int p = 0; p < VERSUS_PLAYERS; p++) versus->games[p].eventCount = 0;
+        return;
+    }
+
+    versus->tick++;
+    for (int p = 0; p < VERSUS_PLAYERS; p++) UpdateGameState(&versus->games[p], inputs[p]);
+
+    // Cleared aliens are sent over after both boards moved, so the order of the players never matters
+    int sends[VERSUS_PLAYERS] = { 0 };
+    for (int p = 0; p < VERSUS_PLAYERS; p++) {
+        const Game *game = &versus->games[p];
+        for (int e = 0; e < game->eventCount; e++) {
+            if (game->events[e].type == EVENT_ALIEN_KILLED) versus->killCredit[p]++;
+        }
+        sends[p] = versus->killCredit[p]/VERSUS_KILLS_PER_SEND;
+        versus->killCredit[p] %= VERSUS_KILLS_PER_SEND;
+    }
+
+    for (int p = 0; p < VERSUS_PLAYERS; p++) {
+        Game *opponent = &versus->games[1 - p];
+        for (int i = 0; i < sends[p]; i++) {
+            if (ReviveAlien(opponent)) versus->aliensSent[p]++;
+        }
+    }
+
+    // Last board standing wins, both falling on the same tick is a draw
+    bool over1 = versus->games[0].gameOver, over2 = versus->games[1].gameOver;
+    if (over1 && over2) versus->result = VERSUS_DRAW;
+    else if (over1) versus->result = VERSUS_WIN_P2;
+    else if (over2) versus->result = VERSUS_WIN_P1;
+}
+
+uint64_t HashVersus(const Versus *versus)
+{
+    uint64_t h = versus->tick ^ ((uint64_t)versus->result << 32);
+
+    for (int p = 0; p < VERSUS_PLAYERS; p++) {
+        h = (h ^ HashGameState(&versus->games[p]).total)*0xBF58476D1CE4E5B9ULL;
+        h = (h ^ (uint64_t)(versus->killCredit[p] + 64*versus->aliensSent[p]))*0x94D049BB133111EBULL;
+        h ^= h >> 31;
+    }
+
+    return h;
+}
@@ -0,0 +1,33 @@
+#ifndef VERSUS_H
+#define VERSUS_H
+
+#include "game.h"
+
+//----------------------------------------------------------------------------------
+// Defines
+//----------------------------------------------------------------------------------
+#define VERSUS_PLAYERS          2
+#define VERSUS_KILLS_PER_SEND   3   // Aliens a player must shoot to send one to the opponent
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef enum VersusResult { VERSUS_PLAYING = 0, VERSUS_WIN_P1, VERSUS_WIN_P2, VERSUS_DRAW } VersusResult;
+
+// Two independent boards stepped in lockstep. Plain data like Game, so rollback can copy it.
+typedef struct Versus {
+    uint32_t tick;
+    Game games[VERSUS_PLAYERS];
+    int killCredit[VERSUS_PLAYERS];     // Kills not yet converted into sent aliens
+    int aliensSent[VERSUS_PLAYERS];
+    VersusResult result;
+} Versus;
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+void InitVersus(Versus *versus, uint64_t seed);     // Both boards start from the same seed
+void UpdateVersus(Versus *versus, const GameInput inputs[VERSUS_PLAYERS]); // One fixed tick (GAME_TICK_TIME)
+uint64_t HashVersus(const Versus *versus);
+
+#endif // VERSUS_H
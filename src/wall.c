@@ -0,0 +1,512 @@
+#include "raylib.h"
+#include "rlgl.h"       // For rlGetTextureIdDefault()
+#include "math.h"
+#include "wall.h"
+#include "replay.h"
+#include "autopilot.h"
+#include "ledger.h"
+#include "memory.h"
+
+#if !defined(_WIN32) && !defined(PLATFORM_WEB)
+    #define WALL_THREADS_SUPPORTED
+    #include <stdatomic.h>
+    #include <pthread.h>
+    #include <unistd.h> // For sysconf()
+#endif
+
+//----------------------------------------------------------------------------------
+// Defines
+//----------------------------------------------------------------------------------
+#define WALL_MAX_TICKS_PER_FRAME    5   // Catch-up limit after a stall, the rest of the backlog is dropped
+#define WALL_TILE_MARGIN            2   // Pixels between tiles
+#define WALL_LABEL_SIZE             10
+#define ATLAS_SPRITE_HEIGHT         8   // Every sprite in resources/ is 8 pixels high
+#define ATLAS_SHIELD_COLUMNS        16  // Shield slots per atlas row
+#define ATLAS_SHIELD_SLOTS          (WALL_MAX_GAMES*NUM_SHIELDS)
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef enum WallInput { WALL_INPUT_BOT = 0, WALL_INPUT_LOCAL, WALL_INPUT_REPLAY } WallInput;
+
+typedef enum AtlasSprite {
+    SPRITE_INV11 = 0, SPRITE_INV12, SPRITE_INV21, SPRITE_INV22, SPRITE_INV31, SPRITE_INV32,
+    SPRITE_PLAYER, SPRITE_PLAYER_SHOT,
+    SPRITE_ROLLING1, SPRITE_ROLLING2, SPRITE_ROLLING3, SPRITE_ROLLING4,
+    SPRITE_UFO, SPRITE_ALIEN_EXPLOSION, SPRITE_SHOT_EXPLOSION, SPRITE_UFO_EXPLOSION,
+    SPRITE_COUNT
+} AtlasSprite;
+
+typedef struct WallTile {
+    Game game;
+    WallInput source;
+    uint64_t seed;
+    Replay replay;              // WALL_INPUT_REPLAY: played from the start again after each game
+    int replayTick;
+    GameInput localInput;       // WALL_INPUT_LOCAL: held keys of this frame, fire until a tick takes it
+    int restartTicks;           // Counts down once the game is over
+    int games;                  // Games finished on this tile
+} WallTile;
+
+//------------------------------------------------------------------------------------
+// Global Variables Declaration
+//------------------------------------------------------------------------------------
+static const char *spriteFiles[SPRITE_COUNT] = {
+    "resources/inv11.png", "resources/inv12.png", "resources/inv21.png", "resources/inv22.png",
+    "resources/inv31.png", "resources/inv32.png", "resources/play.png", "resources/player_shot.png",
+    "resources/rolling1.png", "resources/rolling2.png", "resources/rolling3.png", "resources/rolling4.png",
+    "resources/saucer.png", "resources/alien_exploding.png", "resources/player_shot_exploding.png",
+    "resources/saucer_exploding.png"
+};
+
+static WallTile *tiles = NULL;
+static int tileCount = 0;
+static GameInput (*readInput)(void) = NULL;
+static float tickAccumulator = 0.0f;    // Real time not yet simulated, in seconds
+static int frameTicks = 0;              // Ticks every tile runs this frame
+static bool showStats = false;          // F1 toggles the stats line
+static WallStats stats = { 0 };
+
+static Texture2D atlas = { 0 };
+static Rectangle spriteRects[SPRITE_COUNT] = { 0 };
+static Rectangle whiteRect = { 0 };     // Shapes texture source, rectangles stay in the atlas batch
+static int shieldSlotsY = 0;            // Atlas row where the shield slots start
+static Color shieldColor = GREEN;
+static Color shieldPixels[SHIELD_TEX_HEIGHT*SHIELD_TEX_WIDTH]; // Upload staging
+
+// Tile being drawn: world coordinates map to origin + position*scale
+static Vector2 tileOrigin = { 0 };
+static float tileScale = 1.0f;
+
+#if defined(WALL_THREADS_SUPPORTED)
+// Fork-join per frame: the render thread publishes frameTicks and bumps generation, every thread
+// (itself included) takes tiles from nextTile until none are left, the last worker out signals done
+static pthread_t workers[WALL_MAX_WORKERS];
+static int workerCount = 0;
+static pthread_mutex_t wallLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t workReady = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t workDone = PTHREAD_COND_INITIALIZER;
+static unsigned int generation = 0;     // Guarded by wallLock
+static int busyWorkers = 0;             // Guarded by wallLock
+static bool quitting = false;           // Guarded by wallLock
+static atomic_int nextTile = 0;
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition - Simulation
+//----------------------------------------------------------------------------------
+static void StartTile(WallTile *tile)
+{
+    InitGameState(&tile->game, tile->seed);
+    InvalidateShields(&tile->game); // Its atlas slots still hold the last game's shields
+    tile->replayTick = 0;
+    tile->localInput = (GameInput){ 0 };
+    tile->restartTicks = WALL_RESTART_TICKS;
+}
+
+// Runs on any thread, touches nothing but the tile
+static void TickTile(WallTile *tile, int ticks)
+{
+    for (int i = 0; i < ticks; i++) {
+        bool finished = tile->game.gameOver ||
+                        ((tile->source == WALL_INPUT_REPLAY) && (tile->replayTick >= tile->replay.tickCount));
+        if (finished) {
+            if (--tile->restartTicks > 0) continue;
+            tile->games++;
+            if (tile->source != WALL_INPUT_REPLAY) tile->seed += WALL_MAX_GAMES; // Replays loop, the others play a new game
+            StartTile(tile);
+        }
+
+        GameInput input = { 0 };
+        switch (tile->source) {
+            case WALL_INPUT_BOT: input = GetAutopilotInput(&tile->game); break;
+            case WALL_INPUT_REPLAY: input = UnpackGameInput(tile->replay.ticks[tile->replayTick++].input); break;
+            case WALL_INPUT_LOCAL:
+                input = tile->localInput;
+                tile->localInput.fire = false;
+                break;
+        }
+        UpdateGameState(&tile->game, input);
+    }
+}
+
+static void RunTiles(void)
+{
+#if defined(WALL_THREADS_SUPPORTED)
+    for (int i = atomic_fetch_add(&nextTile, 1); i < tileCount; i = atomic_fetch_add(&nextTile, 1)) TickTile(&tiles[i], frameTicks);
+#else
+    for (int i = 0; i < tileCount; i++) TickTile(&tiles[i], frameTicks);
+#endif
+}
+
+#if defined(WALL_THREADS_SUPPORTED)
+static void *WallWorker(void *arg)
+{
+    (void)arg;
+    unsigned int seen = 0;
+
+    pthread_mutex_lock(&wallLock);
+    for (;;) {
+        while ((generation == seen) && !quitting) pthread_cond_wait(&workReady, &wallLock);
+        if (quitting) break;
+        seen = generation;
+        pthread_mutex_unlock(&wallLock);
+
+        RunTiles();
+
+        pthread_mutex_lock(&wallLock);
+        if (--busyWorkers == 0) pthread_cond_signal(&workDone);
+    }
+    pthread_mutex_unlock(&wallLock);
+    return NULL;
+}
+#endif
+
+// Every tile runs frameTicks ticks; returns once all of them are done
+static void TickWall(void)
+{
+#if defined(WALL_THREADS_SUPPORTED)
+    if (workerCount > 0) {
+        pthread_mutex_lock(&wallLock);
+        atomic_store(&nextTile, 0);
+        busyWorkers = workerCount;
+        generation++;
+        pthread_cond_broadcast(&workReady);
+        pthread_mutex_unlock(&wallLock);
+
+        RunTiles();
+
+        pthread_mutex_lock(&wallLock);
+        while (busyWorkers > 0) pthread_cond_wait(&workDone, &wallLock);
+        pthread_mutex_unlock(&wallLock);
+        return;
+    }
+    atomic_store(&nextTile, 0);
+#endif
+    RunTiles();
+}
+
+static void StartWorkers(int requested)
+{
+#if defined(WALL_THREADS_SUPPORTED)
+    int count = (requested > 0) ? requested : (int)sysconf(_SC_NPROCESSORS_ONLN) - 1;
+    if (count > tileCount - 1) count = tileCount - 1; // The render thread takes tiles too
+    if (count > WALL_MAX_WORKERS) count = WALL_MAX_WORKERS;
+
+    quitting = false;
+    for (workerCount = 0; workerCount < count; workerCount++) {
+        if (pthread_create(&workers[workerCount], NULL, WallWorker, NULL) != 0) break;
+    }
+    stats.workers = workerCount;
+#else
+    (void)requested;
+#endif
+}
+
+static void StopWorkers(void)
+{
+#if defined(WALL_THREADS_SUPPORTED)
+    pthread_mutex_lock(&wallLock);
+    quitting = true;
+    pthread_cond_broadcast(&workReady);
+    pthread_mutex_unlock(&wallLock);
+    for (int i = 0; i < workerCount; i++) pthread_join(workers[i], NULL);
+    workerCount = 0;
+#endif
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition - Atlas
+//----------------------------------------------------------------------------------
+// Sprites side by side on the top row with a transparent column between them, then a white block
+// for the shapes texture, then ATLAS_SHIELD_COLUMNS shield slots per row below
+static bool LoadAtlas(void)
+{
+    Image sprites[SPRITE_COUNT] = { 0 };
+    int width = 0;
+    for (int i = 0; i < SPRITE_COUNT; i++) {
+        sprites[i] = LoadImage(spriteFiles[i]);
+        if (sprites[i].data == NULL) {
+            for (int j = 0; j < i; j++) UnloadImage(sprites[j]);
+            return false;
+        }
+        width += sprites[i].width + 1;
+    }
+    int whiteX = width;
+    width += 3 + 1;
+
+    int slotsWidth = ATLAS_SHIELD_COLUMNS*(SHIELD_TEX_WIDTH + 1);
+    if (width < slotsWidth) width = slotsWidth;
+    shieldSlotsY = ATLAS_SPRITE_HEIGHT + 1;
+    int height = shieldSlotsY + (ATLAS_SHIELD_SLOTS/ATLAS_SHIELD_COLUMNS)*(SHIELD_TEX_HEIGHT + 1);
+
+    Image image = GenImageColor(width, height, BLANK);
+    int x = 0;
+    for (int i = 0; i < SPRITE_COUNT; i++) {
+        spriteRects[i] = (Rectangle){ (float)x, 0, (float)sprites[i].width, (float)sprites[i].height };
+        ImageDraw(&image, sprites[i], (Rectangle){ 0, 0, (float)sprites[i].width, (float)sprites[i].height }, spriteRects[i], WHITE);
+        x += sprites[i].width + 1;
+        UnloadImage(sprites[i]);
+    }
+    ImageDrawRectangle(&image, whiteX, 0, 3, 3, WHITE);
+    whiteRect = (Rectangle){ (float)whiteX + 1, 1, 1, 1 }; // Center texel, filtering never reaches the border
+
+    Image shield = LoadImage("resources/shield.png"); // One color: the first solid pixel gives it
+    if (shield.data != NULL) {
+        ImageFormat(&shield, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+        for (int i = 0; i < shield.width*shield.height; i++) {
+            if (((Color *)shield.data)[i].a == 255) { shieldColor = ((Color *)shield.data)[i]; break; }
+        }
+        UnloadImage(shield);
+    }
+
+    atlas = LoadTextureFromImageTracked(image);
+    UnloadImage(image);
+    if (atlas.id == 0) return false;
+
+    SetShapesTexture(atlas, whiteRect);
+    TraceLog(LOG_INFO, "GAME: Wall atlas %dx%d, %d sprites and %d shield slots", atlas.width, atlas.height, SPRITE_COUNT, ATLAS_SHIELD_SLOTS);
+    return true;
+}
+
+static Rectangle GetShieldSlot(int tileIndex, int shieldIndex)
+{
+    int slot = tileIndex*NUM_SHIELDS + shieldIndex;
+    return (Rectangle){ (float)((slot%ATLAS_SHIELD_COLUMNS)*(SHIELD_TEX_WIDTH + 1)),
+                        (float)(shieldSlotsY + (slot/ATLAS_SHIELD_COLUMNS)*(SHIELD_TEX_HEIGHT + 1)),
+                        SHIELD_TEX_WIDTH, SHIELD_TEX_HEIGHT };
+}
+
+// Damaged texels only, as shield color with the coverage as alpha
+static void SyncShieldSlots(void)
+{
+    for (int t = 0; t < tileCount; t++) {
+        Game *board = &tiles[t].game;
+        for (int i = 0; i < NUM_SHIELDS; i++) {
+            ShieldDirty dirty = board->shieldDirty[i];
+            if (dirty.x0 > dirty.x1) continue;
+
+            int width = dirty.x1 - dirty.x0 + 1;
+            int height = dirty.y1 - dirty.y0 + 1;
+            for (int y = 0; y < height; y++) {
+                for (int x = 0; x < width; x++) {
+                    Color texel = shieldColor;
+                    texel.a = board->shields[i].alpha[dirty.y0 + y][dirty.x0 + x];
+                    shieldPixels[y*width + x] = texel;
+                }
+            }
+            Rectangle slot = GetShieldSlot(t, i);
+            UpdateTextureRec(atlas, (Rectangle){ slot.x + dirty.x0, slot.y + dirty.y0, (float)width, (float)height }, shieldPixels);
+            ClearShieldDirty(board, i);
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition - Drawing
+//----------------------------------------------------------------------------------
+static void DrawAtlasRect(Rectangle source, Rectangle world, Color tint)
+{
+    Rectangle dest = { tileOrigin.x + world.x*tileScale, tileOrigin.y + world.y*tileScale, world.width*tileScale, world.height*tileScale };
+    DrawTexturePro(atlas, source, dest, (Vector2){ 0, 0 }, 0.0f, tint);
+}
+
+static AtlasSprite GetAlienSprite(AlienType type, bool frame)
+{
+    switch (type) {
+        case ALIEN_TYPE_3: return frame ? SPRITE_INV32 : SPRITE_INV31;
+        case ALIEN_TYPE_2: return frame ? SPRITE_INV22 : SPRITE_INV21;
+        default: return frame ? SPRITE_INV12 : SPRITE_INV11;
+    }
+}
+
+// Same picture as DrawBoard() in invaders.c, every quad taken from the atlas
+static void DrawTile(int tileIndex)
+{
+    const Game *board = &tiles[tileIndex].game;
+
+    for (int i = 0; i < NUM_SHIELDS; i++) {
+        if (board->shields[i].active) DrawAtlasRect(GetShieldSlot(tileIndex, i), board->shields[i].bounds, WHITE);
+    }
+
+    for (int i = 0; i < NUM_ALIENS; i++) {
+        const Alien *alien = &board->aliens[i];
+        if (alien->active) DrawAtlasRect(spriteRects[GetAlienSprite(alien->type, alien->currentFrame)], (Rectangle){ alien->position.x, alien->position.y, alien->size.x, alien->size.y }, WHITE);
+    }
+
+    const Player *player = &board->player;
+    if (player->exploding) {
+        Rectangle source = spriteRects[SPRITE_ALIEN_EXPLOSION];
+        DrawAtlasRect(source, (Rectangle){ player->position.x + player->size.x/2 - source.width, player->position.y + player->size.y/2 - source.height,
+                                           source.width*2.0f, source.height*2.0f }, WHITE);
+    }
+    else if (player->lives > 0) DrawAtlasRect(spriteRects[SPRITE_PLAYER], (Rectangle){ player->position.x, player->position.y, player->size.x, player->size.y }, WHITE);
+
+    if (player->shotActive) DrawAtlasRect(spriteRects[SPRITE_PLAYER_SHOT], (Rectangle){ player->shotPosition.x, player->shotPosition.y, player->shotSize.x, player->shotSize.y }, WHITE);
+
+    // Shots roll with the tile's own clock, ten frames a second like the single board
+    Rectangle shotFrame = spriteRects[SPRITE_ROLLING1 + (board->tick/(GAME_TICK_RATE/10))%4];
+    for (int i = 0; i < MAX_ALIEN_BULLETS; i++) {
+        const Bullet *bullet = &board->alienBullets[i];
+        if (bullet->active) DrawAtlasRect(shotFrame, (Rectangle){ bullet->position.x, bullet->position.y, bullet->size.x, bullet->size.y }, WHITE);
+    }
+
+    const UFO *ufo = &board->ufo;
+    if (ufo->active) {
+        if (ufo->exploding) {
+            Rectangle source = spriteRects[SPRITE_UFO_EXPLOSION];
+            DrawAtlasRect(source, (Rectangle){ ufo->position.x + ufo->size.x/2 - source.width*1.5f/2, ufo->position.y + ufo->size.y/2 - source.height*1.5f/2,
+                                               source.width*1.5f, source.height*1.5f }, WHITE);
+        }
+        else DrawAtlasRect(spriteRects[SPRITE_UFO], (Rectangle){ ufo->position.x, ufo->position.y, ufo->size.x, ufo->size.y }, RED);
+    }
+
+    for (int i = 0; i < MAX_EXPLOSIONS; i++) {
+        const Explosion *explosion = &board->explosions[i];
+        if (explosion->active) {
+            AtlasSprite sprite = (explosion->type == EXPLOSION_ALIEN) ? SPRITE_ALIEN_EXPLOSION : SPRITE_SHOT_EXPLOSION;
+            DrawAtlasRect(spriteRects[sprite], (Rectangle){ explosion->position.x, explosion->position.y, explosion->size.x, explosion->size.y }, WHITE);
+        }
+    }
+}
+
+// Columns and rows close to square, each tile the board's aspect ratio scaled into its cell
+static void GetTileLayout(int index, Vector2 *origin, float *scale)
+{
+    int columns = (int)ceilf(sqrtf((float)tileCount));
+    int rows = (tileCount + columns - 1)/columns;
+    float cellWidth = (float)SCREEN_WIDTH/columns;
+    float cellHeight = (float)SCREEN_HEIGHT/rows;
+
+    *scale = fminf((cellWidth - WALL_TILE_MARGIN)/SCREEN_WIDTH, (cellHeight - WALL_TILE_MARGIN)/SCREEN_HEIGHT);
+    origin->x = (index%columns)*cellWidth + (cellWidth - SCREEN_WIDTH*(*scale))/2;
+    origin->y = (index/columns)*cellHeight + (cellHeight - SCREEN_HEIGHT*(*scale))/2;
+}
+
+static void DrawWall(void)
+{
+    BeginDrawing();
+        ClearBackground(BLACK);
+
+        // One texture for sprites, shields and backgrounds: the whole grid is a single batch
+        for (int t = 0; t < tileCount; t++) {
+            GetTileLayout(t, &tileOrigin, &tileScale);
+            Color background = (tiles[t].source == WALL_INPUT_LOCAL) ? (Color){ 0, 0, 48, 255 } : (Color){ 16, 16, 16, 255 };
+            DrawAtlasRect(whiteRect, (Rectangle){ 0, 0, SCREEN_WIDTH, SCREEN_HEIGHT }, background);
+            DrawTile(t);
+        }
+
+        // Labels after the grid, the font texture is the second batch
+        for (int t = 0; t < tileCount; t++) {
+            const WallTile *tile = &tiles[t];
+            GetTileLayout(t, &tileOrigin, &tileScale);
+            const char *source = (tile->source == WALL_INPUT_LOCAL) ? "YOU" : ((tile->source == WALL_INPUT_REPLAY) ? "REPLAY" : "BOT");
+            DrawText(TextFormat("%s %d", source, tile->game.score), (int)tileOrigin.x + 2, (int)tileOrigin.y + 2, WALL_LABEL_SIZE, RAYWHITE);
+            if (tile->game.gameOver) {
+                int width = MeasureText("GAME OVER", WALL_LABEL_SIZE);
+                DrawText("GAME OVER", (int)(tileOrigin.x + SCREEN_WIDTH*tileScale/2) - width/2, (int)(tileOrigin.y + SCREEN_HEIGHT*tileScale/2) - WALL_LABEL_SIZE/2, WALL_LABEL_SIZE, RED);
+            }
+        }
+
+        if (showStats) {
+            DrawRectangle(0, SCREEN_HEIGHT - 20, SCREEN_WIDTH, 20, Fade(BLACK, 0.8f));
+            DrawText(TextFormat("WALL: %d games, %d workers + render thread, %d ticks in %.2f ms, FPS %d",
+                                tileCount, stats.workers, stats.ticks, stats.tickMs, GetFPS()), 5, SCREEN_HEIGHT - 15, 10, LIME);
+        }
+    EndDrawing();
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+bool InitWall(const WallConfig *config)
+{
+    tileCount = config->games;
+    if (tileCount < WALL_MIN_GAMES) tileCount = WALL_MIN_GAMES;
+    if (tileCount > WALL_MAX_GAMES) tileCount = WALL_MAX_GAMES;
+
+    tiles = GameCalloc(tileCount, sizeof(WallTile));
+    if (tiles == NULL) return false;
+    if (!LoadAtlas()) {
+        TraceLog(LOG_WARNING, "GAME: Wall sprites could not be loaded");
+        GameFree(tiles);
+        tiles = NULL;
+        return false;
+    }
+
+    readInput = config->readInput;
+    int next = 0;
+    if (config->localPlayer && (readInput != NULL)) tiles[next++].source = WALL_INPUT_LOCAL;
+    for (int i = 0; (i < config->replayCount) && (next < tileCount); i++) {
+        WallTile *tile = &tiles[next];
+        if (!LoadReplay(&tile->replay, config->replays[i]) || (tile->replay.tickCount == 0)) {
+            TraceLog(LOG_WARNING, "GAME: Wall skips replay %s", config->replays[i]);
+            ReplayFree(&tile->replay);
+            continue;
+        }
+        tile->source = WALL_INPUT_REPLAY;
+        tile->seed = tile->replay.seed;
+        next++;
+    }
+    for (int i = 0; i < tileCount; i++) {
+        if (tiles[i].source != WALL_INPUT_REPLAY) tiles[i].seed = (uint64_t)GetRandomValue(1, 1 << 30)*WALL_MAX_GAMES + i;
+        StartTile(&tiles[i]);
+    }
+
+    tickAccumulator = 0.0f;
+    stats = (WallStats){ 0 };
+    StartWorkers(config->workers);
+    TraceLog(LOG_INFO, "GAME: Wall of %d games, %d on worker threads", tileCount, stats.workers);
+    return true;
+}
+
+void UpdateDrawWall(void)
+{
+    if (IsKeyPressed(KEY_F1)) showStats = !showStats;
+
+    // Local keys are read here, raylib's input state belongs to this thread; the worker only copies them
+    for (int i = 0; i < tileCount; i++) {
+        if (tiles[i].source != WALL_INPUT_LOCAL) continue;
+        GameInput input = readInput();
+        tiles[i].localInput.left = input.left;
+        tiles[i].localInput.right = input.right;
+        tiles[i].localInput.fire |= input.fire; // Pressed on a frame that ran no tick yet
+    }
+
+    tickAccumulator += GetFrameTime();
+    frameTicks = (int)(tickAccumulator/GAME_TICK_TIME);
+    if (frameTicks >= WALL_MAX_TICKS_PER_FRAME) {
+        frameTicks = WALL_MAX_TICKS_PER_FRAME;
+        tickAccumulator = 0.0f;
+    }
+    else tickAccumulator -= frameTicks*GAME_TICK_TIME;
+
+    if (frameTicks > 0) {
+        double start = GetTime();
+        TickWall();
+        stats.tickMs = (float)((GetTime() - start)*1000.0);
+    }
+    stats.ticks = frameTicks;
+
+    SyncShieldSlots();
+    DrawWall();
+}
+
+void UnloadWall(void)
+{
+    StopWorkers();
+    for (int i = 0; i < tileCount; i++) ReplayFree(&tiles[i].replay);
+    GameFree(tiles);
+    tiles = NULL;
+    tileCount = 0;
+
+    // Back to raylib's own white texel before the atlas goes away
+    SetShapesTexture((Texture2D){ rlGetTextureIdDefault(), 1, 1, 1, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8 }, (Rectangle){ 0, 0, 1, 1 });
+    if (atlas.id != 0) UnloadTextureTracked(atlas);
+    atlas = (Texture2D){ 0 };
+}
+
+WallStats GetWallStats(void)
+{
+    return stats;
+}
@@ -0,0 +1,52 @@
+#ifndef WALL_H
+#define WALL_H
+
+// Tournament wall: one window showing a grid of independent games, each with its own seed and
+// input source (the keyboard, the autopilot or a replay played back in a loop). Finished games
+// stay on their final board for a moment, then the tile starts over.
+//  - simulation: every frame the tiles' ticks are handed out to a pool of worker threads (the
+//    render thread takes tiles too) and drawing starts once all of them are done
+//  - drawing: all sprites plus one slot per shield of every tile live in a single atlas, and the
+//    shapes texture points into it as well, so the whole wall is one texture and one batch;
+//    the tile labels follow in a second batch with the font
+// Without threads (Windows, web) the render thread ticks every tile itself.
+
+#include "raylib.h"
+#include "game.h"
+
+//----------------------------------------------------------------------------------
+// Defines
+//----------------------------------------------------------------------------------
+#define WALL_MIN_GAMES          4
+#define WALL_MAX_GAMES          64
+#define WALL_MAX_REPLAYS        16
+#define WALL_MAX_WORKERS        16
+#define WALL_RESTART_TICKS      180     // Final board stays up 3 s
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef struct WallConfig {
+    int games;                          // Tiles, clamped to WALL_MIN_GAMES..WALL_MAX_GAMES
+    bool localPlayer;                   // The first tile plays from readInput
+    GameInput (*readInput)(void);       // Keyboard/touch state, read once per frame
+    const char *replays[WALL_MAX_REPLAYS]; // The next tiles play these back; the rest are bots
+    int replayCount;
+    int workers;                        // 0: one per core besides the render thread
+} WallConfig;
+
+typedef struct WallStats {
+    int workers;                        // Threads besides the render thread
+    int ticks;                          // Ticks every tile ran last frame
+    float tickMs;                       // Wall time of last frame's parallel ticking
+} WallStats;
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+bool InitWall(const WallConfig *config);    // After InitWindow()
+void UpdateDrawWall(void);                  // One frame: tick all tiles, draw the grid
+void UnloadWall(void);
+WallStats GetWallStats(void);
+
+#endif // WALL_H
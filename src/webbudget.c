@@ -0,0 +1,293 @@
+// Web build budget check: what the browser downloads (.wasm, .data, .js and the page) against size
+// limits, then the time to the first frame against a startup limit. The startup is measured in
+// headless Chrome/Chromium ($CHROME, else the first of chromium, chromium-browser, google-chrome on
+// the PATH) with a fresh profile per run, loading the build from a server on 127.0.0.1 that this
+// program runs; opened with ?budget, the page sends its times back (ReportStartup() in invaders.c).
+// Times count from navigation start, so they hold fetching (local, no network), compiling and the
+// preload. Without a browser only the sizes are checked. Exits 1 when a budget is exceeded.
+// POSIX, built with the host compiler (make web-budget).
+//
+//   invaders_webbudget invaders.html [wasm KB] [data KB] [js KB] [startup ms] [runs]
+
+#include <stdio.h>  // For printf(), snprintf(), sscanf()
+#include <stdlib.h> // For strtol(), strtod(), getenv(), qsort()
+#include <string.h> // For strrchr(), strstr(), strncmp()
+#include <stdbool.h>
+#include <signal.h> // For kill(), signal()
+#include <time.h>   // For clock_gettime()
+#include <fcntl.h>  // For open()
+#include <poll.h>
+#include <unistd.h> // For fork(), execl(), access()
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+//----------------------------------------------------------------------------------
+// Defines
+//----------------------------------------------------------------------------------
+#define BUDGET_MAX_RUNS         16
+#define BUDGET_RUN_TIMEOUT      30.0    // Seconds a run may take before it counts as failed
+#define BUDGET_MAX_CLIENTS      16      // Connections the browser keeps open at once
+#define BUDGET_REQUEST_SIZE     4096
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef struct StartupTimes {
+    double mainMs;                      // main() entered: downloaded, compiled, preloaded
+    double frameMs;                     // First frame handed to the browser
+} StartupTimes;
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition - Sizes
+//----------------------------------------------------------------------------------
+static double GetSeconds(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec/1e9;
+}
+
+// One line of the size table; a budget of 0 only reports, a missing optional file is skipped
+static bool CheckSize(const char *base, const char *extension, int budgetKB, bool required)
+{
+    char path[1024];
+    snprintf(path, sizeof(path), "%s%s", base, extension);
+
+    struct stat info;
+    if (stat(path, &info) != 0) {
+        if (required) printf("%-28s missing\n", path);
+        return !required;
+    }
+
+    double sizeKB = info.st_size/1024.0;
+    bool ok = (budgetKB <= 0) || (sizeKB <= budgetKB);
+    if (budgetKB > 0) printf("%-28s %9.1f KB  budget %6d KB  %s\n", path, sizeKB, budgetKB, ok ? "OK" : "OVER");
+    else printf("%-28s %9.1f KB\n", path, sizeKB);
+    return ok;
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition - Startup
+//----------------------------------------------------------------------------------
+static const char *FindBrowser(void)
+{
+    static char found[1024];
+    const char *chrome = getenv("CHROME");
+    if ((chrome != NULL) && (chrome[0] != '\0')) return chrome;
+
+    static const char *names[] = { "chromium", "chromium-browser", "google-chrome", "google-chrome-stable" };
+    const char *path = getenv("PATH");
+    for (int n = 0; (path != NULL) && (n < (int)(sizeof(names)/sizeof(names[0]))); n++) {
+        for (const char *dir = path; *dir != '\0'; ) {
+            const char *end = strchr(dir, ':');
+            int length = (end != NULL) ? (int)(end - dir) : (int)strlen(dir);
+            snprintf(found, sizeof(found), "%.*s/%s", length, dir, names[n]);
+            if ((length > 0) && (access(found, X_OK) == 0)) return found;
+            dir += length + ((end != NULL) ? 1 : 0);
+        }
+    }
+    return NULL;
+}
+
+static const char *GetContentType(const char *path)
+{
+    const char *dot = strrchr(path, '.');
+    if (dot == NULL) return "application/octet-stream";
+    if (strcmp(dot, ".html") == 0) return "text/html";
+    if (strcmp(dot, ".js") == 0) return "text/javascript";
+    if (strcmp(dot, ".wasm") == 0) return "application/wasm"; // Streaming compilation needs it
+    return "application/octet-stream";
+}
+
+static void SendAll(int socket, const void *data, size_t size)
+{
+    const char *bytes = (const char *)data;
+    while (size > 0) {
+        ssize_t sent = send(socket, bytes, size, 0);
+        if (sent <= 0) return;
+        bytes += sent;
+        size -= sent;
+    }
+}
+
+// Answers one request: a file of the build directory, or the page's report; true on the report
+static bool ServeRequest(int client, const char *dir, StartupTimes *times)
+{
+    char request[BUDGET_REQUEST_SIZE];
+    ssize_t received = recv(client, request, sizeof(request) - 1, 0);
+    if (received <= 0) return false;
+    request[received] = '\0';
+
+    char target[512] = { 0 };
+    if (sscanf(request, "GET %511s", target) != 1) return false;
+
+    if (strncmp(target, "/startup?", 9) == 0) {
+        const char *mainValue = strstr(target, "main=");
+        const char *frameValue = strstr(target, "frame=");
+        times->mainMs = (mainValue != NULL) ? strtod(mainValue + 5, NULL) : 0.0;
+        times->frameMs = (frameValue != NULL) ? strtod(frameValue + 6, NULL) : 0.0;
+        const char *answer = "HTTP/1.1 204 No Content\r\nConnection: close\r\n\r\n";
+        SendAll(client, answer, strlen(answer));
+        return (frameValue != NULL);
+    }
+
+    char *query = strchr(target, '?');
+    if (query != NULL) *query = '\0';
+    char path[1024];
+    snprintf(path, sizeof(path), "%s%s", dir, target);
+    int file = (strstr(target, "..") == NULL) ? open(path, O_RDONLY) : -1;
+    struct stat info;
+    if ((file < 0) || (fstat(file, &info) != 0) || !S_ISREG(info.st_mode)) {
+        const char *answer = "HTTP/1.1 404 Not Found\r\nContent-Length: 0\r\nConnection: close\r\n\r\n";
+        SendAll(client, answer, strlen(answer));
+        if (file >= 0) close(file);
+        return false;
+    }
+
+    char header[256];
+    int headerSize = snprintf(header, sizeof(header), "HTTP/1.1 200 OK\r\nContent-Type: %s\r\nContent-Length: %lld\r\n"
+                              "Cache-Control: no-store\r\nConnection: close\r\n\r\n", GetContentType(path), (long long)info.st_size);
+    SendAll(client, header, headerSize);
+    char chunk[65536];
+    ssize_t count;
+    while ((count = read(file, chunk, sizeof(chunk))) > 0) SendAll(client, chunk, count);
+    close(file);
+    return false;
+}
+
+// One cold start: a new browser with an empty profile, served until the page reports
+static bool MeasureStartup(const char *browser, const char *dir, const char *page, StartupTimes *times)
+{
+    int server = socket(AF_INET, SOCK_STREAM, 0);
+    if (server < 0) return false;
+    int reuse = 1;
+    setsockopt(server, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+    struct sockaddr_in address = { 0 };
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t addressSize = sizeof(address);
+    if ((bind(server, (struct sockaddr *)&address, sizeof(address)) != 0) || (listen(server, BUDGET_MAX_CLIENTS) != 0) ||
+        (getsockname(server, (struct sockaddr *)&address, &addressSize) != 0)) {
+        close(server);
+        return false;
+    }
+
+    char profile[] = "/tmp/invaders_budget_XXXXXX";
+    if (mkdtemp(profile) == NULL) { close(server); return false; }
+    char profileArg[64], url[1024];
+    snprintf(profileArg, sizeof(profileArg), "--user-data-dir=%s", profile);
+    snprintf(url, sizeof(url), "http://127.0.0.1:%d/%s?budget", ntohs(address.sin_port), page);
+
+    pid_t browserPid = fork();
+    if (browserPid == 0) {
+        int null = open("/dev/null", O_WRONLY);
+        dup2(null, STDOUT_FILENO);
+        dup2(null, STDERR_FILENO);
+        // Software WebGL: runs on machines without a GPU, and the same on every one of them
+        execl(browser, browser, "--headless=new", "--no-sandbox", "--no-first-run", "--use-angle=swiftshader",
+              "--enable-unsafe-swiftshader", "--autoplay-policy=no-user-gesture-required", profileArg, url, (char *)NULL);
+        _exit(127);
+    }
+
+    struct pollfd fds[1 + BUDGET_MAX_CLIENTS];
+    int clients = 0;
+    bool reported = false;
+    double deadline = GetSeconds() + BUDGET_RUN_TIMEOUT;
+
+    while ((browserPid > 0) && !reported && (GetSeconds() < deadline)) {
+        if (waitpid(browserPid, NULL, WNOHANG) == browserPid) { browserPid = 0; break; }
+
+        fds[0] = (struct pollfd){ server, POLLIN, 0 };
+        if (poll(fds, 1 + clients, 100) <= 0) continue;
+
+        for (int i = clients; i >= 1; i--) {
+            if (fds[i].revents == 0) continue;
+            if (ServeRequest(fds[i].fd, dir, times)) reported = true;
+            close(fds[i].fd);
+            fds[i] = fds[clients--];
+        }
+        if ((fds[0].revents & POLLIN) && (clients < BUDGET_MAX_CLIENTS)) {
+            int client = accept(server, NULL, NULL);
+            if (client >= 0) fds[++clients] = (struct pollfd){ client, POLLIN, 0 };
+        }
+    }
+
+    for (int i = 1; i <= clients; i++) close(fds[i].fd);
+    close(server);
+    if (browserPid > 0) {
+        kill(browserPid, SIGTERM);
+        waitpid(browserPid, NULL, 0);
+    }
+    char command[128];
+    snprintf(command, sizeof(command), "rm -rf '%s'", profile);
+    if (system(command) != 0) fprintf(stderr, "%s: could not remove\n", profile);
+    return reported;
+}
+
+static int CompareDoubles(const void *a, const void *b)
+{
+    return (*(const double *)a > *(const double *)b) - (*(const double *)a < *(const double *)b);
+}
+
+//----------------------------------------------------------------------------------
+// Main entry point
+//----------------------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+    if (argc < 2) {
+        fprintf(stderr, "Usage: %s invaders.html [wasm KB] [data KB] [js KB] [startup ms] [runs]\n", argv[0]);
+        return 2;
+    }
+    int wasmKB = (argc > 2) ? (int)strtol(argv[2], NULL, 10) : 1024;
+    int dataKB = (argc > 3) ? (int)strtol(argv[3], NULL, 10) : 32;
+    int jsKB = (argc > 4) ? (int)strtol(argv[4], NULL, 10) : 256;
+    int startupMs = (argc > 5) ? (int)strtol(argv[5], NULL, 10) : 3000;
+    int runs = (argc > 6) ? (int)strtol(argv[6], NULL, 10) : 3;
+    if (runs < 1) runs = 1;
+    if (runs > BUDGET_MAX_RUNS) runs = BUDGET_MAX_RUNS;
+    signal(SIGPIPE, SIG_IGN); // The browser may drop a connection mid answer
+
+    // invaders.html -> invaders, served from its directory
+    char base[1024], dir[1024];
+    snprintf(base, sizeof(base), "%s", argv[1]);
+    char *extension = strrchr(base, '.');
+    if ((extension != NULL) && (strcmp(extension, ".html") == 0)) *extension = '\0';
+    snprintf(dir, sizeof(dir), "%s", argv[1]);
+    char *slash = strrchr(dir, '/');
+    const char *page = (slash != NULL) ? slash + 1 : argv[1];
+    if (slash != NULL) *slash = '\0';
+    else snprintf(dir, sizeof(dir), ".");
+
+    bool ok = CheckSize(base, ".wasm", wasmKB, true);
+    ok &= CheckSize(base, ".data", dataKB, false);
+    ok &= CheckSize(base, ".js", jsKB, true);
+    ok &= CheckSize(base, ".html", 0, true);
+
+    const char *browser = FindBrowser();
+    if (browser == NULL) {
+        printf("startup: no browser found (set CHROME), not measured\n");
+        return ok ? 0 : 1;
+    }
+
+    double frames[BUDGET_MAX_RUNS];
+    int measured = 0;
+    for (int r = 0; r < runs; r++) {
+        StartupTimes times = { 0 };
+        if (MeasureStartup(browser, dir, page, &times)) {
+            printf("startup run %d: main() at %.0f ms, first frame at %.0f ms\n", r + 1, times.mainMs, times.frameMs);
+            frames[measured++] = times.frameMs;
+        }
+        else printf("startup run %d: no report within %.0f s\n", r + 1, BUDGET_RUN_TIMEOUT);
+    }
+
+    if (measured == 0) return 1;
+    qsort(frames, measured, sizeof(double), CompareDoubles);
+    double median = frames[(measured - 1)/2];
+    bool fast = (median <= startupMs);
+    printf("startup (median of %d): first frame at %.0f ms  budget %d ms  %s\n", measured, median, startupMs, fast ? "OK" : "OVER");
+
+    return (ok && fast && (measured == runs)) ? 0 : 1;
+}